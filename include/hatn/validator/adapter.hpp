@@ -52,6 +52,21 @@ struct adapter_traits
      */
     using filter_if_not_exists=std::integral_constant<bool,true>;
 
+    /**
+     *  @brief Logical integral constant saying whether element aggregations ALL/ANY of simple value checks
+     *  can be evaluated with vectorized kernels over contiguous containers.
+     *
+     *  Default is NO. Adapters that perform plain validation of values without side effects can enable it.
+     */
+    using vectorize_element_aggregations=std::integral_constant<bool,false>;
+
+    /**
+     *  @brief Logical integral constant saying whether operands of adaptive aggregations can be evaluated in adaptive order.
+     *
+     *  Default is NO. Adapters whose results do not depend on the order of evaluation of operands can enable it.
+     */
+    using reorder_aggregations=std::integral_constant<bool,false>;
+
     /**
      * @brief Default implementation of validation of member aggregation.
      * @param pred Logical predicate of the aggregation.
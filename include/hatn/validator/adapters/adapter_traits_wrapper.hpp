@@ -41,6 +41,8 @@ struct adapter_traits_wrapper : public adapter_traits_wrapper_tag,
 {
     using expand_aggregation_members=typename TraitsT::expand_aggregation_members;
     using filter_if_not_exists=typename TraitsT::filter_if_not_exists;
+    using vectorize_element_aggregations=typename TraitsT::vectorize_element_aggregations;
+    using reorder_aggregations=typename TraitsT::reorder_aggregations;
     using base_tag=typename TraitsT::base_tag;
 
     /**
@@ -41,6 +41,8 @@ class default_adapter_traits :  public adapter_traits,
     public:
 
         using base_tag=adapter_traits;
+        using vectorize_element_aggregations=std::integral_constant<bool,true>;
+        using reorder_aggregations=std::integral_constant<bool,true>;
 
         /**
          * @brief Constructor.
@@ -0,0 +1,90 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/adapters/profiling_adapter.hpp
+*
+*  Defines profiling adapter.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_PROFILING_ADAPTER_HPP
+#define HATN_VALIDATOR_PROFILING_ADAPTER_HPP
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/object_wrapper.hpp>
+#include <hatn/validator/adapter.hpp>
+#include <hatn/validator/with_check_member_exists.hpp>
+#include <hatn/validator/adapters/impl/default_adapter_impl.hpp>
+#include <hatn/validator/profiling/profiler.hpp>
+#include <hatn/validator/profiling/profiling_adapter_impl.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Traits of profiling adapter.
+ */
+template <typename T>
+struct profiling_adapter_traits : public adapter_traits,
+                                  public object_wrapper<T>,
+                                  public with_check_member_exists<profiling_adapter_traits<T>>,
+                                  public profiling_adapter_impl<default_adapter_impl>
+{
+    public:
+
+        // elements must be validated one by one to be counted
+        using vectorize_element_aggregations=std::integral_constant<bool,false>;
+
+        /**
+         * @brief Constructor.
+         * @param obj Object under validation.
+         * @param prof Profiler to collect counters to.
+         */
+        profiling_adapter_traits(
+                    T&& obj,
+                    profiler& prof
+                )
+            : object_wrapper<T>(std::forward<T>(obj)),
+              with_check_member_exists<profiling_adapter_traits<T>>(*this),
+              profiling_adapter_impl<default_adapter_impl>(prof)
+        {}
+};
+
+/**
+ * @brief Profiling adapter that counts evaluations, failures, ignores and time of each node of validator.
+ */
+template <typename T>
+class profiling_adapter : public adapter<profiling_adapter_traits<T>>
+{
+    public:
+
+        using adapter<profiling_adapter_traits<T>>::adapter;
+};
+
+/**
+ * @brief Create profiling adapter.
+ * @param obj Object to validate.
+ * @param prof Profiler to collect counters to.
+ * @return Profiling adapter.
+ */
+template <typename ObjT>
+auto make_profiling_adapter(ObjT&& obj, profiler& prof)
+{
+    return profiling_adapter<ObjT>(std::forward<ObjT>(obj),prof);
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_PROFILING_ADAPTER_HPP
@@ -40,6 +40,8 @@ struct reporting_adapter_traits : public adapter_traits,
 {
     public:
 
+        using vectorize_element_aggregations=std::integral_constant<bool,true>;
+
         /**
          * @brief Constructor.
          * @param adpt Adapter.
@@ -0,0 +1,116 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/adapters/trace_adapter.hpp
+*
+*  Defines trace adapter.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_TRACE_ADAPTER_HPP
+#define HATN_VALIDATOR_TRACE_ADAPTER_HPP
+
+#include <tuple>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/utils/object_wrapper.hpp>
+#include <hatn/validator/adapter.hpp>
+#include <hatn/validator/with_check_member_exists.hpp>
+#include <hatn/validator/adapters/impl/default_adapter_impl.hpp>
+#include <hatn/validator/tracing/trace_recorder.hpp>
+#include <hatn/validator/tracing/trace_adapter_impl.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Traits of trace adapter.
+ */
+template <typename T>
+struct trace_adapter_traits : public adapter_traits,
+                                  public object_wrapper<T>,
+                                  public with_check_member_exists<trace_adapter_traits<T>>,
+                                  public trace_adapter_impl<default_adapter_impl>
+{
+    public:
+
+        // elements must be validated one by one to be traced
+        using vectorize_element_aggregations=std::integral_constant<bool,false>;
+
+        /**
+         * @brief Constructor.
+         * @param obj Object under validation.
+         * @param recorder Recorder to append trace to.
+         */
+        trace_adapter_traits(
+                    T&& obj,
+                    trace_recorder& recorder
+                )
+            : object_wrapper<T>(std::forward<T>(obj)),
+              with_check_member_exists<trace_adapter_traits<T>>(*this),
+              trace_adapter_impl<default_adapter_impl>(recorder)
+        {}
+};
+
+/**
+ * @brief Trace adapter that records each check and aggregation evaluated by validator.
+ */
+template <typename T>
+class trace_adapter : public adapter<trace_adapter_traits<T>>
+{
+    public:
+
+        using adapter<trace_adapter_traits<T>>::adapter;
+};
+
+/**
+ * @brief Create trace adapter.
+ * @param obj Object to validate.
+ * @param recorder Recorder to append trace to.
+ * @return Trace adapter.
+ */
+template <typename ObjT>
+auto make_trace_adapter(ObjT&& obj, trace_recorder& recorder)
+{
+    return trace_adapter<ObjT>(std::forward<ObjT>(obj),recorder);
+}
+
+/**
+ * @brief Apply validator to object recording trace of sampled validations.
+ * @param v Validator.
+ * @param obj Object to validate.
+ * @param recorder Recorder to append trace to, it also decides which validations are sampled.
+ * @return Validation status.
+ *
+ * Tracing is compiled in only if HATN_VALIDATOR_TRACE is defined, otherwise validator is applied to the object as is.
+ */
+template <typename ValidatorT, typename ObjT>
+status apply_sampled(const ValidatorT& v, ObjT&& obj, trace_recorder& recorder)
+{
+#ifdef HATN_VALIDATOR_TRACE
+    if (recorder.sample())
+    {
+        return v.apply(make_trace_adapter(std::forward<ObjT>(obj),recorder));
+    }
+#else
+    std::ignore=recorder;
+#endif
+    return v.apply(std::forward<ObjT>(obj));
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_TRACE_ADAPTER_HPP
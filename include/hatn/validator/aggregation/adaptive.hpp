@@ -0,0 +1,72 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/aggregation/adaptive.hpp
+*
+*  Defines logical pseudo operators ADAPTIVE_AND and ADAPTIVE_OR.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_ADAPTIVE_HPP
+#define HATN_VALIDATOR_ADAPTIVE_HPP
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/make_validator.hpp>
+#include <hatn/validator/aggregation/aggregation.hpp>
+#include <hatn/validator/detail/aggregate_adaptive.hpp>
+#include <hatn/validator/base_validator.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Logical pseudo operator AND with adaptive order of evaluation.
+ * @param xs Intermediate validators whose result must be forwarded to logical AND.
+ * @return Logical "and" of intermediate validator results.
+ *
+ * Operands are reordered at the end of each epoch so that cheap operands that most often fail are evaluated first.
+ * Operands must not depend on each other. Can be used both as function call notation ADAPTIVE_AND(...) and as infix notation (... ^ADAPTIVE_AND^ ...).
+ */
+HATN_VALIDATOR_INLINE_LAMBDA auto ADAPTIVE_AND=hana::infix([](auto&& ...xs) -> decltype(auto)
+{
+    return make_validator(
+                make_aggregation_validator(
+                    detail::aggregate_adaptive_t<detail::aggregate_and_t,sizeof...(xs)>{},
+                    hana::make_tuple(std::forward<decltype(xs)>(xs)...)
+                )
+           );
+});
+
+/**
+ * @brief Logical pseudo operator OR with adaptive order of evaluation.
+ * @param xs Intermediate validators whose result must be forwarded to logical OR.
+ * @return Logical "or" of intermediate validator results.
+ *
+ * Operands are reordered at the end of each epoch so that cheap operands that most often succeed are evaluated first.
+ * Operands must not depend on each other. Can be used both as function call notation ADAPTIVE_OR(...) and as infix notation (... ^ADAPTIVE_OR^ ...).
+ */
+HATN_VALIDATOR_INLINE_LAMBDA auto ADAPTIVE_OR=hana::infix([](auto&& ...xs) -> decltype(auto)
+{
+    return make_validator(
+                make_aggregation_validator(
+                    detail::aggregate_adaptive_t<detail::aggregate_or_t,sizeof...(xs)>{},
+                    hana::make_tuple(std::forward<decltype(xs)>(xs)...)
+                )
+           );
+});
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_ADAPTIVE_HPP
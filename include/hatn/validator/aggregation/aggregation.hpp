@@ -113,6 +113,33 @@ struct aggregate_op
     using hana_tag=aggregation_op_tag;
 };
 
+/**
+ * @brief Handler of aggregation validator that invokes logical aggregation with intermediate validators.
+ *
+ * Handler keeps aggregation and intermediate validators accessible so that they can be inspected by
+ * optimized validation paths, e.g. by batch validation.
+ */
+template <typename HandlerT, typename OpsT>
+struct aggregation_validator_handler
+{
+    using handler_type=HandlerT;
+    using ops_type=OpsT;
+
+    /**
+     * @brief Invoke aggregation appending intermediate validators to the arguments.
+     * @param args Validation arguments, i.e. adapter and optionally member.
+     * @return Validation status.
+     */
+    template <typename ... Args>
+    auto operator () (Args&&... args) const -> decltype(auto)
+    {
+        return handler(std::forward<Args>(args)...,ops);
+    }
+
+    HandlerT handler;
+    OpsT ops;
+};
+
 /**
  * @brief Implementer of make_aggregation_validator.
  */
@@ -121,7 +148,7 @@ struct make_aggregation_validator_impl
     template <typename HandlerT, typename Ts>
     auto operator() (HandlerT&& handler, Ts&& xs) const
     {
-        auto fn=hana::reverse_partial(std::forward<HandlerT>(handler),xs);
+        auto fn=aggregation_validator_handler<std::decay_t<HandlerT>,std::decay_t<Ts>>{std::forward<HandlerT>(handler),xs};
         auto params=content_of_check_exists(xs);
         return base_validator<
                 decltype(fn),
@@ -38,7 +38,11 @@ template <typename AdapterT, typename=hana::when<true>>
 struct aggregate_report
 {
     template <typename AdapterT1, typename AggregationT, typename MemberT>
-    static void open(AdapterT1&&, AggregationT&&, MemberT&&)
+    static void open(AdapterT1&&, const void*, AggregationT&&, MemberT&&)
+    {}
+
+    template <typename AdapterT1>
+    static void element(AdapterT1&&, size_t)
     {}
 
     template <typename AdapterT1>
@@ -53,7 +57,7 @@ struct aggregate_report<AdapterT,
         >>
 {
     template <typename AdapterT1, typename AggregationT, typename PathT>
-    static void open(AdapterT1&& adapter, AggregationT&& str, PathT&& path)
+    static void open(AdapterT1&& adapter, const void*, AggregationT&& str, PathT&& path)
     {
         auto& reporter=traits_of(adapter).reporter();
         hana::eval_if(
@@ -69,6 +73,10 @@ struct aggregate_report<AdapterT,
         );
     }
 
+    template <typename AdapterT1>
+    static void element(AdapterT1&&, size_t)
+    {}
+
     template <typename AdapterT1>
     static void close(AdapterT1&& adapter, status ret)
     {
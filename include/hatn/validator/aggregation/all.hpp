@@ -164,6 +164,14 @@ struct all_t : public element_aggregation_with_modifier<ModifierT>,
         return string_all;
     }
 
+    /**
+     * @brief Get description of aggregation taking into account aggregation modifier.
+     */
+    operator std::string () const
+    {
+        return string_all(ModifierT::instance());
+    }
+
     static auto predicate()
     {
         return [](auto&& adapter, status& ret)
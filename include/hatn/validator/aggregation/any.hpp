@@ -174,6 +174,14 @@ struct any_t : public element_aggregation_with_modifier<ModifierT>,
         return string_any;
     }
 
+    /**
+     * @brief Get description of aggregation taking into account aggregation modifier.
+     */
+    operator std::string () const
+    {
+        return string_any(ModifierT::instance());
+    }
+
     static auto predicate()
     {
         return [](auto&& adapter, status& ret)
@@ -0,0 +1,97 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/aggregation/by_cost.hpp
+*
+*  Defines logical pseudo operators AND and OR with operands sorted by estimated cost.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_BY_COST_HPP
+#define HATN_VALIDATOR_BY_COST_HPP
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/make_validator.hpp>
+#include <hatn/validator/aggregation/aggregation.hpp>
+#include <hatn/validator/detail/aggregate_and.hpp>
+#include <hatn/validator/detail/aggregate_or.hpp>
+#include <hatn/validator/detail/validator_cost.hpp>
+#include <hatn/validator/base_validator.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Estimated cost of validator.
+ */
+template <typename T>
+constexpr int validator_cost=detail::validator_cost<std::decay_t<T>>::value;
+
+/**
+ * @brief Sort intermediate validators by estimated cost.
+ * @param xs Tuple of intermediate validators.
+ * @return Tuple of intermediate validators where cheaper validators go first, validators with equal cost keep their order.
+ */
+template <typename Ts>
+auto sort_by_cost(Ts&& xs)
+{
+    return hana::sort(
+                std::forward<Ts>(xs),
+                [](auto&& a, auto&& b)
+                {
+                    return hana::bool_c<(validator_cost<decltype(a)> < validator_cost<decltype(b)>)>;
+                }
+            );
+}
+
+/**
+ * @brief Logical pseudo operator AND with operands evaluated in order of their estimated cost.
+ * @param xs Intermediate validators whose result must be forwarded to logical AND.
+ * @return Logical "and" of intermediate validator results.
+ *
+ * Can be used both as function call notation AND_by_cost(...) and as infix notation (... ^AND_by_cost^ ...).
+ * Operands are sorted at compile time, so they must not depend on each other.
+ */
+HATN_VALIDATOR_INLINE_LAMBDA auto AND_by_cost=hana::infix([](auto&& ...xs) -> decltype(auto)
+{
+    return make_validator(
+                make_aggregation_validator(
+                    detail::aggregate_and,
+                    sort_by_cost(hana::make_tuple(std::forward<decltype(xs)>(xs)...))
+                )
+           );
+});
+
+/**
+ * @brief Logical pseudo operator OR with operands evaluated in order of their estimated cost.
+ * @param xs Intermediate validators whose result must be forwarded to logical OR.
+ * @return Logical "or" of intermediate validator results.
+ *
+ * Can be used both as function call notation OR_by_cost(...) and as infix notation (... ^OR_by_cost^ ...).
+ * Operands are sorted at compile time, so they must not depend on each other.
+ */
+HATN_VALIDATOR_INLINE_LAMBDA auto OR_by_cost=hana::infix([](auto&& ...xs) -> decltype(auto)
+{
+    return make_validator(
+                make_aggregation_validator(
+                    detail::aggregate_or,
+                    sort_by_cost(hana::make_tuple(std::forward<decltype(xs)>(xs)...))
+                )
+           );
+});
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_BY_COST_HPP
@@ -70,6 +70,7 @@ struct element_aggregation : public adjust_storable_ignore
      * @param pred Logical predicate to use for aggregation (and/or for ALL/ANY).
      * @param empt Handler of empty list of elements.
      * @param aggr Aggregation.
+     * @param id Address identifying the aggregation within validator.
      * @param used_path_size Length of member's path prefix already used for extracting intermediate member values.
      * @param path Member's path prefix before this aggregation in the path including the aggregation itself.
      * @param adapter Validation adapter.
@@ -77,7 +78,7 @@ struct element_aggregation : public adjust_storable_ignore
      */
     template <typename PredicateT, typename EmptyFnT, typename AggregationT,
               typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    static status invoke(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr,
+    static status invoke(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr, const void* id,
                          UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler);
 
     /**
@@ -85,6 +86,7 @@ struct element_aggregation : public adjust_storable_ignore
      * @param pred Logical predicate to use for aggregation (and/or for ALL/ANY).
      * @param empt Handler of empty list of elements.
      * @param aggr Aggregation.
+     * @param id Address identifying the aggregation within validator.
      * @param used_path_size Length of member's path prefix already used for extracting intermediate member values.
      * @param path Member's path prefix before this aggregation in the path including the aggregation itself.
      * @param adapter Validation adapter.
@@ -92,7 +94,7 @@ struct element_aggregation : public adjust_storable_ignore
      */
     template <typename PredicateT, typename EmptyFnT, typename AggregationT,
               typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    static status invoke_variadic(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr,
+    static status invoke_variadic(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr, const void* id,
                          UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler);
 };
 
@@ -200,13 +202,14 @@ template <typename KeyT>
 struct generate_paths_t<KeyT,hana::when<std::is_base_of<element_aggregation,std::decay_t<KeyT>>::value>>
 {
     template <typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler) const
+    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler, const void* key=nullptr) const
     {
         const auto& aggregation=hana::back(path);
         return element_aggregation::invoke(
             hana::partial(aggregation.predicate(),std::forward<AdapterT>(adapter)),
             aggregation.post_empty_handler(),
             aggregation.string(),
+            key,
             std::forward<UsedPathSizeT>(used_path_size),
             path,
             std::forward<AdapterT>(adapter),
@@ -224,13 +227,14 @@ template <typename KeyT>
 struct generate_paths_t<KeyT,hana::when<std::is_base_of<variadic_arg_aggregation_tag,KeyT>::value>>
 {
     template <typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler) const
+    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler, const void* key=nullptr) const
     {
         const auto& aggregation=hana::back(path).get().aggregation;
         return element_aggregation::invoke_variadic(
             hana::partial(aggregation.predicate(),std::forward<AdapterT>(adapter)),
             aggregation.post_empty_handler(),
             aggregation.string(),
+            key,
             std::forward<UsedPathSizeT>(used_path_size),
             path,
             std::forward<AdapterT>(adapter),
@@ -42,7 +42,7 @@ HATN_VALIDATOR_NAMESPACE_BEGIN
 
 template <typename PredicateT, typename EmptyFnT, typename AggregationT,
           typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-status element_aggregation::invoke(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr,
+status element_aggregation::invoke(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr, const void* id,
                      UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler)
 {
     // invoke only if parent path is ok
@@ -67,10 +67,12 @@ status element_aggregation::invoke(PredicateT&& pred, EmptyFnT&& empt, Aggregati
 
                     auto tmp_adapter=make_intermediate_adapter(_(adapter),_(parent_path));
 
-                    aggregate_report<AdapterT>::open(_(adapter),_(aggr),_(parent_path));
+                    aggregate_report<AdapterT>::open(_(adapter),id,_(aggr),_(parent_path));
                     bool empty=true;
+                    size_t index=0;
                     for (auto it=_(parent_element).begin();it!=_(parent_element).end();++it)
                     {
+                        aggregate_report<AdapterT>::element(_(adapter),index++);
                         status ret=_(handler)(tmp_adapter,hana::append(_(parent_path),wrap_it(it,_(aggr),el_aggregation.modifier)),_(used_path_size));
                         if (!pred(ret))
                         {
@@ -91,12 +93,13 @@ status element_aggregation::invoke(PredicateT&& pred, EmptyFnT&& empt, Aggregati
                         {
                             // agrregation can be invoked on heterogeneous container types
                             auto tmp_adapter=make_intermediate_adapter(_(adapter),_(parent_path));
-                            aggregate_report<AdapterT>::open(_(adapter),_(aggr),_(parent_path));
+                            aggregate_report<AdapterT>::open(_(adapter),id,_(aggr),_(parent_path));
                             auto ret=foreach_if(
                                             parent_element,
                                             pred,
                                             [&](auto&&, auto&& index)
                                             {
+                                                aggregate_report<AdapterT>::element(_(adapter),hana::value(index));
                                                 return _(handler)(tmp_adapter,hana::append(_(parent_path),wrap_heterogeneous_index(index,_(aggr))),_(used_path_size));
                                             }
                                         );
@@ -123,7 +126,7 @@ status element_aggregation::invoke(PredicateT&& pred, EmptyFnT&& empt, Aggregati
 
 template <typename PredicateT, typename EmptyFnT, typename AggregationT,
           typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-status element_aggregation::invoke_variadic(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr,
+status element_aggregation::invoke_variadic(PredicateT&& pred, EmptyFnT&& empt, AggregationT&& aggr, const void* id,
                      UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler)
 {
     auto compacted_path=compact_variadic_property(path);
@@ -143,13 +146,15 @@ status element_aggregation::invoke_variadic(PredicateT&& pred, EmptyFnT&& empt,
 
             auto tmp_adapter=make_intermediate_adapter(_(adapter),_(parent_compacted_path));
 
-            aggregate_report<AdapterT>::open(_(adapter),_(aggr),_(parent_compacted_path));
+            aggregate_report<AdapterT>::open(_(adapter),id,_(aggr),_(parent_compacted_path));
             bool empty=true;
+            size_t index=0;
             for (auto it=aggregation_varg.begin(parent);
                  aggregation_varg.while_cond(parent,it);
                  aggregation_varg.next(parent,it)
                 )
             {
+                aggregate_report<AdapterT>::element(_(adapter),index++);
                 status ret=_(handler)(tmp_adapter,hana::append(upper_path,varg(wrap_index(it,_(aggr)))),_(used_path_size));
                 if (!pred(ret))
                 {
@@ -195,7 +195,7 @@ template <typename KeyT>
 struct generate_paths_t<KeyT,hana::when<hana::is_a<tree_tag,KeyT>>>
 {
     template <typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler) const
+    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler, const void* key=nullptr) const
     {
         auto upper_path=hana::drop_back(path);
         auto&& tree_key=hana::back(path);
@@ -205,7 +205,7 @@ struct generate_paths_t<KeyT,hana::when<hana::is_a<tree_tag,KeyT>>>
         return hana::if_(
             is_embedded_object_path_valid(adapter,possible_path),
             [](auto&& used_path_size, auto&& path, auto&& adapter, auto&& handler,
-               auto&& upper_path, auto&& tree_key)
+               auto&& upper_path, auto&& tree_key, const void* key)
             {
                 auto pred=hana::partial(tree_key.aggregation().predicate(),adapter);
 
@@ -220,7 +220,7 @@ struct generate_paths_t<KeyT,hana::when<hana::is_a<tree_tag,KeyT>>>
                 }
 
                 // iterate over children nodes
-                aggregate_report<AdapterT>::open(next_adapter,tree_key.aggregation().string(),upper_path);
+                aggregate_report<AdapterT>::open(next_adapter,key,tree_key.aggregation().string(),upper_path);
                 auto aggregation_varg=varg(tree_key.aggregation(),tree_key.max_arg);
                 auto result=each_tree_node(
                                 tree_key,
@@ -249,7 +249,8 @@ struct generate_paths_t<KeyT,hana::when<hana::is_a<tree_tag,KeyT>>>
             std::forward<AdapterT>(adapter),
             std::forward<HandlerT>(handler),
             upper_path,
-            tree_key
+            tree_key,
+            key
          );
     }
 };
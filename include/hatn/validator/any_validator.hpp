@@ -0,0 +1,445 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/any_validator.hpp
+*
+*  Defines type-erased validator of objects of given type.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_ANY_VALIDATOR_HPP
+#define HATN_VALIDATOR_ANY_VALIDATOR_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/base_validator.hpp>
+#include <hatn/validator/adapters/default_adapter.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/reporting/reporter.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+template <typename ObjectT>
+class any_validator;
+
+namespace detail
+{
+
+/**
+ * @brief Type of reporter used by type-erased validators.
+ */
+using any_validator_reporter=decltype(make_reporter(std::declval<std::string&>()));
+
+/**
+ * @brief Type of reporting adapter used by type-erased validators.
+ *
+ * Adapter refers to the reporter of the original reporting adapter so that reports go to the same destination.
+ */
+template <typename ObjectT>
+using any_validator_reporting_adapter=reporting_adapter<const ObjectT&,any_validator_reporter&>;
+
+/**
+ * @brief Check if adapter is a reporting adapter with default reporter that can be passed to type-erased validator.
+ */
+template <typename ObjectT, typename AdapterT>
+struct is_any_validator_reporting_adapter : public std::false_type
+{
+};
+template <typename ObjectT, typename T>
+struct is_any_validator_reporting_adapter<ObjectT,reporting_adapter<T,any_validator_reporter>>
+            : public std::is_same<std::decay_t<T>,ObjectT>
+{
+};
+
+/**
+ * @brief Get validator from validator or from shared pointer to validator.
+ */
+template <typename T>
+const T& any_validator_deref(const T& v) noexcept
+{
+    return v;
+}
+template <typename T>
+const T& any_validator_deref(const std::shared_ptr<T>& v) noexcept
+{
+    return *v;
+}
+
+/**
+ * @brief Check if type is a validator or a shared pointer to validator.
+ */
+template <typename T>
+struct is_any_validator_content : public std::integral_constant<bool,hana::is_a<validator_tag,T>>
+{
+};
+template <typename T>
+struct is_any_validator_content<std::shared_ptr<T>> : public std::integral_constant<bool,hana::is_a<validator_tag,T>>
+{
+};
+
+/**
+ * @brief Table of operations of type-erased validator.
+ */
+template <typename ObjectT>
+struct any_validator_vtable
+{
+    status (*apply)(const void* storage, const ObjectT& obj);
+    status (*apply_reporting)(const void* storage, any_validator_reporting_adapter<ObjectT>& adapter);
+    void (*move)(void* src, void* dst) noexcept;
+    void (*destroy)(void* storage) noexcept;
+};
+
+/**
+ * @brief Operations of validator embedded into small buffer of type-erased validator.
+ */
+template <typename ObjectT, typename ValidatorT>
+struct any_validator_inline
+{
+    static const ValidatorT& get(const void* storage) noexcept
+    {
+        return *static_cast<const ValidatorT*>(storage);
+    }
+
+    static status apply(const void* storage, const ObjectT& obj)
+    {
+        return any_validator_deref(get(storage)).apply(obj);
+    }
+
+    static status apply_reporting(const void* storage, any_validator_reporting_adapter<ObjectT>& adapter)
+    {
+        return any_validator_deref(get(storage)).apply(adapter);
+    }
+
+    static void move(void* src, void* dst) noexcept
+    {
+        auto v=static_cast<ValidatorT*>(src);
+        new (dst) ValidatorT(std::move(*v));
+        v->~ValidatorT();
+    }
+
+    static void destroy(void* storage) noexcept
+    {
+        static_cast<ValidatorT*>(storage)->~ValidatorT();
+    }
+
+    constexpr static const any_validator_vtable<ObjectT> vtable{&apply,&apply_reporting,&move,&destroy};
+};
+template <typename ObjectT, typename ValidatorT>
+constexpr const any_validator_vtable<ObjectT> any_validator_inline<ObjectT,ValidatorT>::vtable;
+
+/**
+ * @brief Operations of validator allocated with allocator, small buffer of type-erased validator keeps pointer to validator.
+ */
+template <typename ObjectT, typename ValidatorT, typename AllocatorT>
+struct any_validator_allocated
+{
+    struct holder
+    {
+        template <typename T>
+        holder(const AllocatorT& alloc, T&& v)
+            : alloc(alloc),
+              validator(std::forward<T>(v))
+        {}
+
+        AllocatorT alloc;
+        ValidatorT validator;
+    };
+
+    using allocator_type=typename std::allocator_traits<AllocatorT>::template rebind_alloc<holder>;
+    using allocator_traits=std::allocator_traits<allocator_type>;
+
+    static holder* get(const void* storage) noexcept
+    {
+        return *static_cast<holder* const*>(storage);
+    }
+
+    template <typename T>
+    static void create(void* storage, const AllocatorT& alloc, T&& v)
+    {
+        allocator_type holder_alloc(alloc);
+        auto ptr=allocator_traits::allocate(holder_alloc,1);
+        try
+        {
+            allocator_traits::construct(holder_alloc,std::addressof(*ptr),alloc,std::forward<T>(v));
+        }
+        catch (...)
+        {
+            allocator_traits::deallocate(holder_alloc,ptr,1);
+            throw;
+        }
+        *static_cast<holder**>(storage)=std::addressof(*ptr);
+    }
+
+    static status apply(const void* storage, const ObjectT& obj)
+    {
+        return any_validator_deref(get(storage)->validator).apply(obj);
+    }
+
+    static status apply_reporting(const void* storage, any_validator_reporting_adapter<ObjectT>& adapter)
+    {
+        return any_validator_deref(get(storage)->validator).apply(adapter);
+    }
+
+    static void move(void* src, void* dst) noexcept
+    {
+        *static_cast<holder**>(dst)=get(src);
+    }
+
+    static void destroy(void* storage) noexcept
+    {
+        auto ptr=get(storage);
+        allocator_type holder_alloc(ptr->alloc);
+        allocator_traits::destroy(holder_alloc,ptr);
+        allocator_traits::deallocate(holder_alloc,ptr,1);
+    }
+
+    constexpr static const any_validator_vtable<ObjectT> vtable{&apply,&apply_reporting,&move,&destroy};
+};
+template <typename ObjectT, typename ValidatorT, typename AllocatorT>
+constexpr const any_validator_vtable<ObjectT> any_validator_allocated<ObjectT,ValidatorT,AllocatorT>::vtable;
+
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Type-erased validator of objects of given type.
+ *
+ * Any validator or shared pointer to validator can be put into any_validator. Validator that fits small buffer
+ * and is nothrow move constructible is embedded into any_validator, otherwise it is allocated with
+ * allocator given in constructor, e.g. std::pmr::polymorphic_allocator.
+ * Validation costs a single indirect call.
+ *
+ * any_validator is move-only, use shared pointer to validator to share the same validator between several instances.
+ *
+ * @tparam ObjectT Type of objects to validate.
+ */
+template <typename ObjectT>
+class any_validator
+{
+    public:
+
+        /**
+         * @brief Size of small buffer.
+         */
+        constexpr static const size_t buffer_size=4*sizeof(void*);
+
+        /**
+         * @brief Check if validator fits small buffer.
+         */
+        template <typename ValidatorT>
+        using fits_buffer=std::integral_constant<bool,
+            sizeof(ValidatorT)<=buffer_size
+            &&
+            alignof(std::max_align_t)%alignof(ValidatorT)==0
+            &&
+            std::is_nothrow_move_constructible<ValidatorT>::value
+        >;
+
+        /**
+         * @brief Default constructor of empty validator.
+         */
+        any_validator() noexcept : _vtable(nullptr)
+        {}
+
+        /**
+         * @brief Constructor.
+         * @param v Validator or shared pointer to validator.
+         */
+        template <typename ValidatorT,
+                  typename=std::enable_if_t<detail::is_any_validator_content<std::decay_t<ValidatorT>>::value>>
+        any_validator(ValidatorT&& v) : any_validator(std::allocator<char>(),std::forward<ValidatorT>(v))
+        {}
+
+        /**
+         * @brief Constructor with allocator.
+         * @param alloc Allocator to use if validator does not fit small buffer.
+         * @param v Validator or shared pointer to validator.
+         */
+        template <typename AllocatorT, typename ValidatorT,
+                  typename=std::enable_if_t<detail::is_any_validator_content<std::decay_t<ValidatorT>>::value>>
+        any_validator(const AllocatorT& alloc, ValidatorT&& v) : _vtable(nullptr)
+        {
+            using validator_type=std::decay_t<ValidatorT>;
+            construct(alloc,std::forward<ValidatorT>(v),fits_buffer<validator_type>{});
+        }
+
+        /**
+         * @brief Move constructor.
+         */
+        any_validator(any_validator&& other) noexcept : _vtable(other._vtable)
+        {
+            if (_vtable!=nullptr)
+            {
+                _vtable->move(other.storage(),storage());
+                other._vtable=nullptr;
+            }
+        }
+
+        /**
+         * @brief Move assignment operator.
+         */
+        any_validator& operator= (any_validator&& other) noexcept
+        {
+            if (this!=&other)
+            {
+                reset();
+                if (other._vtable!=nullptr)
+                {
+                    other._vtable->move(other.storage(),storage());
+                    _vtable=other._vtable;
+                    other._vtable=nullptr;
+                }
+            }
+            return *this;
+        }
+
+        any_validator(const any_validator&)=delete;
+        any_validator& operator= (const any_validator&)=delete;
+
+        /**
+         * @brief Destructor.
+         */
+        ~any_validator()
+        {
+            reset();
+        }
+
+        /**
+         * @brief Destroy embedded validator.
+         */
+        void reset() noexcept
+        {
+            if (_vtable!=nullptr)
+            {
+                _vtable->destroy(storage());
+                _vtable=nullptr;
+            }
+        }
+
+        /**
+         * @brief Check if any_validator is not empty.
+         */
+        explicit operator bool() const noexcept
+        {
+            return _vtable!=nullptr;
+        }
+
+        /**
+         * @brief Apply validator to object.
+         * @param obj Object to validate.
+         * @return Validation status.
+         */
+        status apply(const ObjectT& obj) const
+        {
+            return _vtable->apply(storage(),obj);
+        }
+
+        /**
+         * @brief Apply validator to reporting adapter.
+         * @param adapter Reporting adapter wrapping object of ObjectT with default reporter.
+         * @return Validation status.
+         *
+         * This is used by validate() with error_report.
+         */
+        template <typename AdapterT>
+        status apply(AdapterT&& adapter,
+                     std::enable_if_t<detail::is_any_validator_reporting_adapter<ObjectT,std::decay_t<AdapterT>>::value,void*> =nullptr
+                ) const
+        {
+            auto& traits=adapter.traits();
+            detail::any_validator_reporting_adapter<ObjectT> erased_adapter(traits.get(),traits.reporter());
+            return _vtable->apply_reporting(storage(),erased_adapter);
+        }
+
+    private:
+
+        template <typename AllocatorT, typename ValidatorT>
+        void construct(const AllocatorT&, ValidatorT&& v, std::true_type)
+        {
+            using validator_type=std::decay_t<ValidatorT>;
+            new (storage()) validator_type(std::forward<ValidatorT>(v));
+            _vtable=&detail::any_validator_inline<ObjectT,validator_type>::vtable;
+        }
+
+        template <typename AllocatorT, typename ValidatorT>
+        void construct(const AllocatorT& alloc, ValidatorT&& v, std::false_type)
+        {
+            using validator_type=std::decay_t<ValidatorT>;
+            using impl=detail::any_validator_allocated<ObjectT,validator_type,AllocatorT>;
+            impl::create(storage(),alloc,std::forward<ValidatorT>(v));
+            _vtable=&impl::vtable;
+        }
+
+        void* storage() noexcept
+        {
+            return &_buffer;
+        }
+
+        const void* storage() const noexcept
+        {
+            return &_buffer;
+        }
+
+        const detail::any_validator_vtable<ObjectT>* _vtable;
+        typename std::aligned_storage<buffer_size,alignof(std::max_align_t)>::type _buffer;
+};
+
+/**
+ * @brief Implementer of make_any_validator().
+ */
+template <typename ObjectT>
+struct make_any_validator_t
+{
+    /**
+     * @brief Create type-erased validator.
+     * @param v Validator or shared pointer to validator.
+     * @return Type-erased validator.
+     */
+    template <typename ValidatorT>
+    any_validator<ObjectT> operator () (ValidatorT&& v) const
+    {
+        return any_validator<ObjectT>(std::forward<ValidatorT>(v));
+    }
+
+    /**
+     * @brief Create type-erased validator using allocator.
+     * @param alloc Allocator to use if validator does not fit small buffer.
+     * @param v Validator or shared pointer to validator.
+     * @return Type-erased validator.
+     */
+    template <typename AllocatorT, typename ValidatorT>
+    any_validator<ObjectT> operator () (const AllocatorT& alloc, ValidatorT&& v) const
+    {
+        return any_validator<ObjectT>(alloc,std::forward<ValidatorT>(v));
+    }
+};
+/**
+  @brief Callable object for creating type-erased validators.
+*/
+template <typename ObjectT>
+constexpr make_any_validator_t<ObjectT> make_any_validator{};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_ANY_VALIDATOR_HPP
@@ -19,6 +19,8 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef HATN_VALIDATOR_FILTER_MEMBER_IPP
 #define HATN_VALIDATOR_FILTER_MEMBER_IPP
 
+#include <memory>
+
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/utils/hana_to_std_tuple.hpp>
 #include <hatn/validator/filter_member.hpp>
@@ -39,12 +41,14 @@ status apply_generated_paths_impl::operator () (UsedPathSizeT&& used_path_size,
         },
         [&](auto&& _)
         {
-            auto&& key=wrap_object_ref(hana::at(_(member).path(),_(used_path_size)));
+            const auto& member_key=hana::at(_(member).path(),_(used_path_size));
+            auto&& key=wrap_object_ref(member_key);
             return generate_paths<std::decay_t<decltype(key)>>(
                         hana::plus(_(used_path_size),hana::size_c<1>),
                         hana::append(_(current_path),std::move(key)),
                         _(adapter),
-                        _(handler)
+                        _(handler),
+                        std::addressof(member_key)
                       );
         }
     );
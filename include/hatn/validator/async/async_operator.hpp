@@ -0,0 +1,241 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/async/async_operator.hpp
+*
+*  Defines base class of operators that need lookups in external store and batch of such lookups.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_ASYNC_OPERATOR_HPP
+#define HATN_VALIDATOR_ASYNC_OPERATOR_HPP
+
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/cost_class.hpp>
+#include <hatn/validator/operators/operator.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Batch of lookups requested by async operators.
+ *
+ * Lookups requested by async operators are collected as pending requests.
+ * Then pending requests are executed all at once by a backend and the results are put back to the batch with resolve().
+ * Requests must be comparable with operator <, each distinct request is executed only once.
+ *
+ * Async operators use the batch that is active in current thread, see async_lookup_batch::scope.
+ */
+template <typename RequestT, typename ResultT>
+class async_lookup_batch
+{
+    public:
+
+        using request_type=RequestT;
+        using result_type=ResultT;
+
+        /**
+         * @brief Scope that makes the batch active in current thread.
+         */
+        class scope
+        {
+            public:
+
+                /**
+                 * @brief Constructor.
+                 * @param batch Batch to activate.
+                 */
+                explicit scope(async_lookup_batch& batch) : _prev(current_ref())
+                {
+                    current_ref()=&batch;
+                }
+
+                /**
+                 * @brief Destructor, restores previous batch of current thread.
+                 */
+                ~scope()
+                {
+                    current_ref()=_prev;
+                }
+
+                scope(const scope&)=delete;
+                scope(scope&&)=delete;
+                scope& operator=(const scope&)=delete;
+                scope& operator=(scope&&)=delete;
+
+            private:
+
+                async_lookup_batch* _prev;
+        };
+
+        /**
+         * @brief Get batch active in current thread.
+         * @return Active batch or nullptr if there is no active batch.
+         */
+        static async_lookup_batch* current() noexcept
+        {
+            return current_ref();
+        }
+
+        /**
+         * @brief Find result of request.
+         * @param request Request.
+         * @return Result or nullptr if the request is not resolved yet.
+         */
+        const ResultT* find(const RequestT& request) const
+        {
+            auto it=_results.find(request);
+            if (it==_results.end())
+            {
+                return nullptr;
+            }
+            return &it->second;
+        }
+
+        /**
+         * @brief Add request to pending requests if it is neither resolved nor pending yet.
+         * @param request Request.
+         */
+        void request(const RequestT& request)
+        {
+            if (_results.find(request)==_results.end() && _pending_set.insert(request).second)
+            {
+                _pending.push_back(request);
+            }
+        }
+
+        /**
+         * @brief Get pending requests.
+         * @return Requests in the order they were added.
+         */
+        const std::vector<RequestT>& pending() const noexcept
+        {
+            return _pending;
+        }
+
+        /**
+         * @brief Check if there are pending requests.
+         * @return Operation result.
+         */
+        bool has_pending() const noexcept
+        {
+            return !_pending.empty();
+        }
+
+        /**
+         * @brief Put results of pending requests to the batch.
+         * @param results Results in the same order as pending requests.
+         *
+         * @throws std::invalid_argument if number of results does not match number of pending requests.
+         */
+        void resolve(std::vector<ResultT> results)
+        {
+            if (results.size()!=_pending.size())
+            {
+                throw std::invalid_argument("number of lookup results does not match number of requests");
+            }
+            for (size_t i=0;i<results.size();i++)
+            {
+                _results.emplace(std::move(_pending[i]),std::move(results[i]));
+            }
+            _pending.clear();
+            _pending_set.clear();
+        }
+
+        /**
+         * @brief Get number of resolved requests.
+         * @return Number of results.
+         */
+        size_t resolved_count() const noexcept
+        {
+            return _results.size();
+        }
+
+    private:
+
+        static async_lookup_batch*& current_ref() noexcept
+        {
+            static thread_local async_lookup_batch* batch=nullptr;
+            return batch;
+        }
+
+        std::vector<RequestT> _pending;
+        std::set<RequestT> _pending_set;
+        std::map<RequestT,ResultT> _results;
+};
+
+/**
+ * @brief Base class of async operators.
+ *
+ * Async operator checks a value using result of a lookup in external store, e.g. to check uniqueness of a value
+ * or existence of a foreign key. Derived class must implement the following methods:
+ * - RequestT make_request(const T1& a, const T2& b) const to construct a lookup request for a value and an operand;
+ * - bool check(const ResultT& result, const T1& a, const T2& b) const to check the value with the result of the lookup.
+ *
+ * Operator uses async_lookup_batch active in current thread. If the result of the lookup is not known yet then
+ * the request is added to pending requests of the batch and the operator is optimistically considered as passed,
+ * so that lookups of the rest of the validator could be collected in the same batch.
+ * Such results are discarded by async_validate() that runs the validator again after the batch is resolved.
+ *
+ * If there is no active batch of the same request and result types then the lookup can not be done,
+ * in that case the operator throws std::logic_error.
+ */
+template <typename DerivedT, typename RequestT, typename ResultT>
+struct async_op : public op<DerivedT>
+{
+    using request_type=RequestT;
+    using result_type=ResultT;
+    using batch_type=async_lookup_batch<RequestT,ResultT>;
+
+    constexpr static const cost_class cost=cost_class::expensive;
+
+    /**
+     * @brief Check value using result of the lookup.
+     * @param a Value.
+     * @param b Operand.
+     * @return Result of the check or true if the result of the lookup is not known yet.
+     *
+     * @throws std::logic_error if there is no active batch of lookups with matching types.
+     */
+    template <typename T1, typename T2>
+    bool operator() (const T1& a, const T2& b) const
+    {
+        const auto& self=static_cast<const DerivedT&>(*this);
+
+        auto batch=batch_type::current();
+        if (batch==nullptr)
+        {
+            throw std::logic_error("async operator requires active batch of lookups with matching request and result types");
+        }
+
+        auto request=self.make_request(a,b);
+        auto result=batch->find(request);
+        if (result==nullptr)
+        {
+            batch->request(request);
+            return true;
+        }
+        return self.check(*result,a,b);
+    }
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_ASYNC_OPERATOR_HPP
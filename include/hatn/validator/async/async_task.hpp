@@ -0,0 +1,237 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/async/async_task.hpp
+*
+*  Defines coroutine task used by asynchronous validation.
+*
+*  Coroutine task is defined only if C++20 coroutines are supported by compiler and standard library,
+*  in that case HATN_VALIDATOR_WITH_COROUTINES is defined.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_ASYNC_TASK_HPP
+#define HATN_VALIDATOR_ASYNC_TASK_HPP
+
+#include <hatn/validator/config.hpp>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+    #if __has_include(<coroutine>)
+        #include <coroutine>
+        #if defined(__cpp_lib_coroutine)
+            #define HATN_VALIDATOR_WITH_COROUTINES
+        #endif
+    #endif
+#endif
+
+#ifdef HATN_VALIDATOR_WITH_COROUTINES
+
+#include <exception>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Lazy coroutine task.
+ *
+ * Task is started either when it is awaited with co_await in other coroutine
+ * or when start() is called by the code that is not a coroutine.
+ * When the task completes, the awaiting coroutine is resumed.
+ */
+template <typename T>
+class async_task
+{
+    public:
+
+        struct promise_type
+        {
+            std::optional<T> value;
+            std::exception_ptr exception;
+            std::coroutine_handle<> continuation;
+
+            async_task get_return_object() noexcept
+            {
+                return async_task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept
+            {
+                return {};
+            }
+
+            struct final_awaiter
+            {
+                bool await_ready() noexcept
+                {
+                    return false;
+                }
+
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) noexcept
+                {
+                    auto continuation=handle.promise().continuation;
+                    if (continuation)
+                    {
+                        return continuation;
+                    }
+                    return std::noop_coroutine();
+                }
+
+                void await_resume() noexcept
+                {
+                }
+            };
+
+            final_awaiter final_suspend() noexcept
+            {
+                return {};
+            }
+
+            template <typename ValueT>
+            void return_value(ValueT&& val)
+            {
+                value.emplace(std::forward<ValueT>(val));
+            }
+
+            void unhandled_exception() noexcept
+            {
+                exception=std::current_exception();
+            }
+        };
+
+        async_task(async_task&& other) noexcept
+            : _handle(std::exchange(other._handle,nullptr)),
+              _started(other._started)
+        {}
+
+        async_task& operator=(async_task&& other) noexcept
+        {
+            if (this!=&other)
+            {
+                destroy();
+                _handle=std::exchange(other._handle,nullptr);
+                _started=other._started;
+            }
+            return *this;
+        }
+
+        async_task(const async_task&)=delete;
+        async_task& operator=(const async_task&)=delete;
+
+        ~async_task()
+        {
+            destroy();
+        }
+
+        /**
+         * @brief Start the task if it is not started yet.
+         *
+         * The task runs until it completes or until it is suspended waiting for some awaitable.
+         */
+        void start()
+        {
+            if (!_started)
+            {
+                _started=true;
+                _handle.resume();
+            }
+        }
+
+        /**
+         * @brief Check if the task is completed.
+         * @return Operation result.
+         */
+        bool done() const noexcept
+        {
+            return _handle.done();
+        }
+
+        /**
+         * @brief Get result of completed task.
+         * @return Result.
+         *
+         * @throws Exception thrown by the task or std::logic_error if the task is not completed yet.
+         */
+        T& get()
+        {
+            if (!done())
+            {
+                throw std::logic_error("task is not completed");
+            }
+            auto& promise=_handle.promise();
+            if (promise.exception)
+            {
+                std::rethrow_exception(promise.exception);
+            }
+            return *promise.value;
+        }
+
+        struct awaiter
+        {
+            std::coroutine_handle<promise_type> handle;
+
+            bool await_ready() noexcept
+            {
+                return false;
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> continuation) noexcept
+            {
+                handle.promise().continuation=continuation;
+                return handle;
+            }
+
+            T await_resume()
+            {
+                auto& promise=handle.promise();
+                if (promise.exception)
+                {
+                    std::rethrow_exception(promise.exception);
+                }
+                return std::move(*promise.value);
+            }
+        };
+
+        awaiter operator co_await() && noexcept
+        {
+            _started=true;
+            return awaiter{_handle};
+        }
+
+    private:
+
+        explicit async_task(std::coroutine_handle<promise_type> handle) noexcept : _handle(handle)
+        {}
+
+        void destroy() noexcept
+        {
+            if (_handle)
+            {
+                _handle.destroy();
+                _handle=nullptr;
+            }
+        }
+
+        std::coroutine_handle<promise_type> _handle;
+        bool _started=false;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_WITH_COROUTINES
+
+#endif // HATN_VALIDATOR_ASYNC_TASK_HPP
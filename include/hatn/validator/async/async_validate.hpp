@@ -0,0 +1,136 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/async/async_validate.hpp
+*
+*  Defines asynchronous validation with batched lookups in external store.
+*
+*  Asynchronous validation is defined only if HATN_VALIDATOR_WITH_COROUTINES is defined, see async_task.hpp.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_ASYNC_VALIDATE_HPP
+#define HATN_VALIDATOR_ASYNC_VALIDATE_HPP
+
+#include <hatn/validator/async/async_task.hpp>
+
+#ifdef HATN_VALIDATOR_WITH_COROUTINES
+
+#include <vector>
+
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/async/async_operator.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+/**
+ * @brief Run validation passes until async operators stop requesting new lookups.
+ * @param backend Backend executing lookups.
+ * @param pass Handler of a single validation pass.
+ * @return Task that completes when the last pass is done.
+ */
+template <typename BackendT, typename PassT>
+async_task<bool> run_async_validation(BackendT& backend, PassT pass)
+{
+    using batch_type=async_lookup_batch<typename BackendT::request_type,typename BackendT::result_type>;
+
+    batch_type batch;
+    for (;;)
+    {
+        {
+            typename batch_type::scope scope(batch);
+            pass();
+        }
+        if (!batch.has_pending())
+        {
+            break;
+        }
+        batch.resolve(co_await backend.lookup(batch.pending()));
+    }
+    co_return true;
+}
+
+}
+
+/**
+ * @brief Validate objects asynchronously with lookups of async operators batched.
+ * @param objects Range of objects to validate.
+ * @param validator Validator.
+ * @param backend Backend executing lookups.
+ * @return Task that results in validation reports of the objects in the same order as objects.
+ *
+ * Backend must define request_type and result_type and must have method lookup(const std::vector<request_type>&)
+ * returning awaitable that results in std::vector<result_type> with results in the same order as requests.
+ *
+ * Validator is applied to all objects collecting the lookups that async operators need in a single batch.
+ * Then validation suspends awaiting the backend to execute all collected lookups at once.
+ * When the lookups are resolved, validator is applied again using the results.
+ * Repeats while applying the validator produces new lookups, e.g. in branches that were not reached before.
+ * Thus, the number of backend calls depends only on the depth of dependencies between lookups
+ * but not on the number of members and objects.
+ *
+ * Objects and backend must stay valid until the task completes, validator is copied to the task.
+ */
+template <typename ObjectsT, typename ValidatorT, typename BackendT>
+async_task<std::vector<error_report>> async_validate_each(const ObjectsT& objects, ValidatorT validator, BackendT& backend)
+{
+    std::vector<error_report> reports;
+    co_await detail::run_async_validation(
+        backend,
+        [&]()
+        {
+            reports.clear();
+            for (const auto& obj:objects)
+            {
+                reports.emplace_back();
+                validate(obj,validator,reports.back());
+            }
+        }
+    );
+    co_return reports;
+}
+
+/**
+ * @brief Validate object asynchronously with lookups of async operators batched.
+ * @param obj Object to validate.
+ * @param validator Validator.
+ * @param backend Backend executing lookups.
+ * @return Task that results in validation report.
+ *
+ * @see async_validate_each()
+ */
+template <typename ObjectT, typename ValidatorT, typename BackendT>
+async_task<error_report> async_validate(const ObjectT& obj, ValidatorT validator, BackendT& backend)
+{
+    error_report err;
+    co_await detail::run_async_validation(
+        backend,
+        [&]()
+        {
+            validate(obj,validator,err);
+        }
+    );
+    co_return err;
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_WITH_COROUTINES
+
+#endif // HATN_VALIDATOR_ASYNC_VALIDATE_HPP
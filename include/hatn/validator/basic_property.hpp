@@ -21,6 +21,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/utils/adjust_storable_ignore.hpp>
+#include <hatn/validator/cost_class.hpp>
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
@@ -34,6 +35,11 @@ struct property_tag;
 struct basic_property : public adjust_storable_ignore
 {
     using hana_tag=property_tag;
+
+    /**
+     * @brief Class of estimated cost of getting the property.
+     */
+    constexpr static const cost_class cost=cost_class::trivial;
 };
 
 
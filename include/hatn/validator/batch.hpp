@@ -0,0 +1,161 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/batch.hpp
+*
+*  Defines validation of batches of homogeneous objects.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_BATCH_HPP
+#define HATN_VALIDATOR_BATCH_HPP
+
+#include <iterator>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/error.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/detail/batch_engine.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Result of validation of a batch of objects.
+ */
+class batch_result
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param bits Bitmap where bits are set for objects that passed validation.
+         */
+        explicit batch_result(detail::batch_bitmap bits)
+            : _bits(std::move(bits))
+        {}
+
+        /**
+         * @brief Get number of objects in the batch.
+         * @return Number of objects.
+         */
+        size_t size() const noexcept
+        {
+            return _bits.size();
+        }
+
+        /**
+         * @brief Check if object passed validation.
+         * @param i Index of object in the batch.
+         * @return Validation result of the object.
+         */
+        bool ok(size_t i) const noexcept
+        {
+            return _bits.test(i);
+        }
+
+        /**
+         * @brief Get number of objects that failed validation.
+         * @return Number of failed objects.
+         */
+        size_t failed_count() const noexcept
+        {
+            return _bits.count_unset();
+        }
+
+        /**
+         * @brief Check if all objects passed validation.
+         */
+        explicit operator bool() const noexcept
+        {
+            return failed_count()==0;
+        }
+
+    private:
+
+        detail::batch_bitmap _bits;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Implementation of a helper to validate batches of objects.
+ *
+ * Validator is evaluated rule by rule over the whole batch rather than object by object.
+ * Values of members checked with plain comparison or interval operators are gathered into columns
+ * and validated with vectorized kernels, other rules are applied to each object of the batch.
+ * Per-object results of the rules are combined with bitmaps following AND/OR/NOT structure of the validator.
+ */
+struct validate_batch_t
+{
+    /**
+     * @brief Validate batch of objects.
+     * @param records Container of objects to validate.
+     * @param validator Validator.
+     * @return Result of validation of the batch.
+     */
+    template <typename RecordsT, typename ValidatorT>
+    batch_result operator() (
+            const RecordsT& records,
+            const ValidatorT& validator
+        ) const
+    {
+        auto count=static_cast<size_t>(std::distance(std::begin(records),std::end(records)));
+        return batch_result(detail::evaluate_batch(validator,records,count));
+    }
+
+    /**
+     * @brief Validate batch of objects and construct reports for objects that failed validation.
+     * @param records Container of objects to validate.
+     * @param validator Validator.
+     * @param handler Handler to invoke for each failed object with signature "void (size_t index, const error_report& err)".
+     * @return Result of validation of the batch.
+     *
+     * Failed objects are validated once more one by one with reporting adapter, so the reports are the same
+     * as if the objects were validated separately.
+     */
+    template <typename RecordsT, typename ValidatorT, typename HandlerT>
+    batch_result operator() (
+            const RecordsT& records,
+            const ValidatorT& validator,
+            HandlerT&& handler
+        ) const
+    {
+        auto result=(*this)(records,validator);
+        if (!result)
+        {
+            size_t i=0;
+            error_report err;
+            for (auto&& record:records)
+            {
+                if (!result.ok(i))
+                {
+                    validate(record,validator,err);
+                    handler(i,static_cast<const error_report&>(err));
+                }
+                i++;
+            }
+        }
+        return result;
+    }
+};
+/**
+  @brief Callable for validation of batches of objects.
+  */
+constexpr validate_batch_t validate_batch{};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_BATCH_HPP
@@ -0,0 +1,55 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/cost_class.hpp
+*
+*  Defines classes of estimated cost of operators and properties.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_COST_CLASS_HPP
+#define HATN_VALIDATOR_COST_CLASS_HPP
+
+#include <hatn/validator/config.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Class of estimated cost of an operator or a property.
+ *
+ * Value of each class is a relative weight of the class used to estimate cost of compound validators.
+ */
+enum class cost_class : int
+{
+    trivial=1, //!< Checks of existence and flags, access to properties.
+    cheap=2, //!< Comparison of scalars.
+    moderate=8, //!< Comparison of strings, lookups in containers, parsing.
+    expensive=32 //!< Regular expressions, searching in ranges.
+};
+
+/**
+ * @brief Get relative weight of cost class.
+ * @param cost Cost class.
+ * @return Weight.
+ */
+constexpr int cost_weight(cost_class cost) noexcept
+{
+    return static_cast<int>(cost);
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_COST_CLASS_HPP
@@ -0,0 +1,52 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/declare_validator.hpp
+*
+*  Defines macro for declaration of separately compiled validators.
+*
+*  The header does not include validators, so it is cheap to include into headers and translation units
+*  that only call the declared functions. Use define_validator.hpp to define the functions.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_DECLARE_VALIDATOR_HPP
+#define HATN_VALIDATOR_DECLARE_VALIDATOR_HPP
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/error.hpp>
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Declare functions validating objects with validator defined in other translation unit.
+ * @param Name Name of validation functions.
+ * @param ObjectT Type of objects to validate, use type alias if the type contains commas.
+ *
+ * Declared functions:
+ * @code
+ *  status Name(const ObjectT& obj);
+ *  void Name(const ObjectT& obj, error& err);
+ *  void Name(const ObjectT& obj, error_report& err);
+ * @endcode
+ * Translation units that only call the declared functions do not instantiate the validator.
+ * The functions are defined with HATN_VALIDATOR_DEFINE() from define_validator.hpp.
+ */
+#define HATN_VALIDATOR_DECLARE(Name,ObjectT) \
+    HATN_VALIDATOR_NAMESPACE::status Name(const ObjectT& obj); \
+    void Name(const ObjectT& obj, HATN_VALIDATOR_NAMESPACE::error& err); \
+    void Name(const ObjectT& obj, HATN_VALIDATOR_NAMESPACE::error_report& err)
+
+//-------------------------------------------------------------
+
+#endif // HATN_VALIDATOR_DECLARE_VALIDATOR_HPP
@@ -0,0 +1,57 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/define_validator.hpp
+*
+*  Defines macro for definition of separately compiled validators.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_DEFINE_VALIDATOR_HPP
+#define HATN_VALIDATOR_DEFINE_VALIDATOR_HPP
+
+#include <hatn/validator/declare_validator.hpp>
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Define functions declared with HATN_VALIDATOR_DECLARE().
+ * @param Name Name of validation functions.
+ * @param ObjectT Type of objects to validate.
+ * @param ... Arguments of validator(), the validator is constructed once on the first call.
+ *
+ * Must be used in exactly one translation unit in the same namespace as HATN_VALIDATOR_DECLARE().
+ */
+#define HATN_VALIDATOR_DEFINE(Name,ObjectT,...) \
+    static const auto& hatn_validator_instance_##Name() \
+    { \
+        static const auto v=HATN_VALIDATOR_NAMESPACE::validator(__VA_ARGS__); \
+        return v; \
+    } \
+    HATN_VALIDATOR_NAMESPACE::status Name(const ObjectT& obj) \
+    { \
+        return hatn_validator_instance_##Name().apply(obj); \
+    } \
+    void Name(const ObjectT& obj, HATN_VALIDATOR_NAMESPACE::error& err) \
+    { \
+        HATN_VALIDATOR_NAMESPACE::validate(obj,hatn_validator_instance_##Name(),err); \
+    } \
+    void Name(const ObjectT& obj, HATN_VALIDATOR_NAMESPACE::error_report& err) \
+    { \
+        HATN_VALIDATOR_NAMESPACE::validate(obj,hatn_validator_instance_##Name(),err); \
+    }
+
+//-------------------------------------------------------------
+
+#endif // HATN_VALIDATOR_DEFINE_VALIDATOR_HPP
@@ -0,0 +1,221 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/dependency_index.hpp
+*
+*  Defines index of dependencies of validator nodes on member paths.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_DEPENDENCY_INDEX_HPP
+#define HATN_VALIDATOR_DEPENDENCY_INDEX_HPP
+
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/member_path.hpp>
+#include <hatn/validator/utils/safe_compare.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+#include <hatn/validator/aggregation/element_aggregation.hpp>
+#include <hatn/validator/variadic_arg_tag.hpp>
+#include <hatn/validator/detail/incremental_node.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+/**
+ * @brief Implementer of keys_overlap().
+ */
+struct keys_overlap_impl
+{
+    template <typename T1, typename T2>
+    bool operator () (const T1& key1, const T2& key2) const
+    {
+        using type1=unwrap_object_t<T1>;
+        using type2=unwrap_object_t<T2>;
+        return hana::eval_if(
+            hana::or_(
+                hana::is_a<element_aggregation_tag,type1>,
+                hana::is_a<element_aggregation_tag,type2>,
+                hana::is_a<variadic_arg_tag,type1>,
+                hana::is_a<variadic_arg_tag,type2>
+            ),
+            [](auto&&)
+            {
+                // aggregations and variadic arguments can match any key
+                return true;
+            },
+            [&](auto&& _)
+            {
+                return safe_compare_equal(unwrap_object(_(key1)),unwrap_object(_(key2)));
+            }
+        );
+    }
+};
+/**
+ * @brief Check if keys of member paths can refer to the same member.
+ */
+constexpr keys_overlap_impl keys_overlap{};
+
+/**
+ * @brief Implementer of paths_overlap().
+ */
+struct paths_overlap_impl
+{
+    template <typename PathT1, typename PathT2>
+    bool operator () (const PathT1& path1, const PathT2& path2) const
+    {
+        constexpr auto size1=decltype(hana::size(path1))::value;
+        constexpr auto size2=decltype(hana::size(path2))::value;
+        constexpr auto common_size=size1<size2 ? size1 : size2;
+
+        bool overlap=true;
+        hana::for_each(
+            hana::make_range(hana::size_c<0>,hana::size_c<common_size>),
+            [&](auto index)
+            {
+                overlap=overlap && keys_overlap(path1[index],path2[index]);
+            }
+        );
+        return overlap;
+    }
+};
+/**
+ * @brief Check if member paths overlap, i.e. one path is a prefix of the other one.
+ */
+constexpr paths_overlap_impl paths_overlap{};
+
+/**
+ * @brief Implementer of dependency_affected().
+ */
+struct dependency_affected_impl
+{
+    template <typename ChangedPathsT>
+    bool operator () (const dependency_any&, const ChangedPathsT&) const noexcept
+    {
+        return true;
+    }
+
+    template <typename PathT, typename ChangedPathsT>
+    bool operator () (const dependency_path<PathT>& dependency, const ChangedPathsT& changed_paths) const
+    {
+        return hana::fold(
+            changed_paths,
+            false,
+            [&dependency](bool affected, const auto& changed)
+            {
+                return affected || paths_overlap(*dependency.path,path_of(changed));
+            }
+        );
+    }
+};
+/**
+ * @brief Check if dependency is affected by changed members.
+ */
+constexpr dependency_affected_impl dependency_affected{};
+
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Index of dependencies of validator nodes on member paths.
+ *
+ * Index is built from the paths of members a validator is applied to and of members used as operands.
+ * Validator nodes whose dependencies can not be figured out depend on any member.
+ * Index keeps references to the paths stored in the validator, so the validator must outlive the index.
+ */
+template <typename EntriesT>
+class dependency_index
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param entries Dependency entries of validator nodes.
+         * @param slots Total number of validator nodes.
+         */
+        dependency_index(EntriesT entries, size_t slots)
+            : _entries(std::move(entries)),
+              _slots(slots)
+        {}
+
+        /**
+         * @brief Get total number of validator nodes.
+         * @return Number of nodes.
+         */
+        size_t size() const noexcept
+        {
+            return _slots;
+        }
+
+        /**
+         * @brief Find validator nodes affected by changed members.
+         * @param changed_paths Foldable container of changed members or member paths.
+         * @return Vector of flags where flags corresponding to affected nodes are set.
+         */
+        template <typename ChangedPathsT>
+        std::vector<bool> affected(const ChangedPathsT& changed_paths) const
+        {
+            std::vector<bool> result(_slots,false);
+            hana::for_each(
+                _entries,
+                [&](const auto& entry)
+                {
+                    result[entry.slot]=hana::fold(
+                        entry.dependencies,
+                        false,
+                        [&changed_paths](bool affected, const auto& dependency)
+                        {
+                            return affected || detail::dependency_affected(dependency,changed_paths);
+                        }
+                    );
+                }
+            );
+            return result;
+        }
+
+    private:
+
+        EntriesT _entries;
+        size_t _slots;
+};
+
+/**
+ * @brief Implementer of make_dependency_index().
+ */
+struct make_dependency_index_impl
+{
+    template <typename ValidatorT>
+    auto operator () (const ValidatorT& validator) const
+    {
+        using node=detail::incremental_node<std::decay_t<ValidatorT>>;
+        auto entries=node::dependencies(validator,0);
+        return dependency_index<decltype(entries)>(std::move(entries),node::slots);
+    }
+};
+/**
+ * @brief Build index of dependencies of validator nodes on member paths.
+ * @param validator Validator.
+ * @return Dependency index.
+ */
+constexpr make_dependency_index_impl make_dependency_index{};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_DEPENDENCY_INDEX_HPP
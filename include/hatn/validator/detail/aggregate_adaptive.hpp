@@ -0,0 +1,339 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/detail/aggregate_adaptive.hpp
+*
+*  Defines aggregations AND/OR with adaptive order of evaluation.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_AGGREGATE_ADAPTIVE_HPP
+#define HATN_VALIDATOR_AGGREGATE_ADAPTIVE_HPP
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/utils/conditional_fold.hpp>
+#include <hatn/validator/adapter.hpp>
+#include <hatn/validator/apply.hpp>
+#include <hatn/validator/detail/aggregate_and.hpp>
+#include <hatn/validator/detail/aggregate_or.hpp>
+
+/**
+ * @brief Number of evaluations of adaptive aggregation after which the order of its operands is revised.
+ */
+#ifndef HATN_VALIDATOR_ADAPTIVE_EPOCH
+    #define HATN_VALIDATOR_ADAPTIVE_EPOCH 1024
+#endif
+
+/**
+ * @brief Duration of operands is measured once per this number of evaluations of adaptive aggregation.
+ */
+#ifndef HATN_VALIDATOR_ADAPTIVE_TIMING_PERIOD
+    #define HATN_VALIDATOR_ADAPTIVE_TIMING_PERIOD 16
+#endif
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+/**
+ * @brief Statistics of operands of adaptive aggregation.
+ *
+ * Order of operands is packed into a single atomic word with 4 bits per operand index,
+ * thus the order is read consistently by concurrent evaluations and stays the same during an epoch.
+ */
+template <size_t N>
+class adaptive_stats
+{
+    public:
+
+        adaptive_stats() : _order(declared_order()),_evaluations(0)
+        {
+            for (auto& operand:_operands)
+            {
+                operand.evaluations.store(0,std::memory_order_relaxed);
+                operand.decisions.store(0,std::memory_order_relaxed);
+                operand.timed.store(0,std::memory_order_relaxed);
+                operand.duration.store(0,std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Get order of operands for current epoch.
+         */
+        uint64_t order() const noexcept
+        {
+            return _order.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief Get index of operand at given position of packed order.
+         */
+        static size_t at(uint64_t order, size_t position) noexcept
+        {
+            return static_cast<size_t>((order>>(position*4))&0xF);
+        }
+
+        /**
+         * @brief Start evaluation of aggregation.
+         * @return True if durations of operands must be measured in this evaluation.
+         */
+        bool start() noexcept
+        {
+            return (_evaluations.load(std::memory_order_relaxed)%HATN_VALIDATOR_ADAPTIVE_TIMING_PERIOD)==0;
+        }
+
+        /**
+         * @brief Account evaluation of operand.
+         * @param index Index of operand in declared order.
+         * @param decided True if the operand decided result of aggregation.
+         * @param duration Duration of evaluation in nanoseconds if it was measured.
+         * @param timed True if duration was measured.
+         */
+        void account(size_t index, bool decided, uint64_t duration, bool timed) noexcept
+        {
+            auto& operand=_operands[index];
+            operand.evaluations.fetch_add(1,std::memory_order_relaxed);
+            if (decided)
+            {
+                operand.decisions.fetch_add(1,std::memory_order_relaxed);
+            }
+            if (timed)
+            {
+                operand.timed.fetch_add(1,std::memory_order_relaxed);
+                operand.duration.fetch_add(duration,std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief Finish evaluation of aggregation and revise order of operands at the end of epoch.
+         */
+        void finish()
+        {
+            auto count=_evaluations.fetch_add(1,std::memory_order_relaxed)+1;
+            if (count%HATN_VALIDATOR_ADAPTIVE_EPOCH==0)
+            {
+                revise();
+            }
+        }
+
+    private:
+
+        static uint64_t declared_order() noexcept
+        {
+            uint64_t order=0;
+            for (size_t i=0;i<N;i++)
+            {
+                order|=static_cast<uint64_t>(i)<<(i*4);
+            }
+            return order;
+        }
+
+        void revise()
+        {
+            // operands are sorted by expected cost of reaching the decision, i.e. by mean duration divided by probability to decide
+            std::array<double,N> scores;
+            std::array<size_t,N> indexes;
+            for (size_t i=0;i<N;i++)
+            {
+                const auto& operand=_operands[i];
+                auto evaluations=operand.evaluations.load(std::memory_order_relaxed);
+                auto decisions=operand.decisions.load(std::memory_order_relaxed);
+                auto timed=operand.timed.load(std::memory_order_relaxed);
+                auto duration=operand.duration.load(std::memory_order_relaxed);
+
+                double cost=timed==0 ? 1.0 : (1.0+static_cast<double>(duration)/static_cast<double>(timed));
+                double probability=(static_cast<double>(decisions)+1.0)/(static_cast<double>(evaluations)+2.0);
+                scores[i]=cost/probability;
+                indexes[i]=i;
+            }
+            std::stable_sort(indexes.begin(),indexes.end(),
+                [&scores](size_t l, size_t r)
+                {
+                    return scores[l]<scores[r];
+                }
+            );
+
+            uint64_t order=0;
+            for (size_t i=0;i<N;i++)
+            {
+                order|=static_cast<uint64_t>(indexes[i])<<(i*4);
+            }
+            _order.store(order,std::memory_order_release);
+        }
+
+        struct operand_stats
+        {
+            std::atomic<uint64_t> evaluations;
+            std::atomic<uint64_t> decisions;
+            std::atomic<uint64_t> timed;
+            std::atomic<uint64_t> duration;
+        };
+
+        std::atomic<uint64_t> _order;
+        std::atomic<uint64_t> _evaluations;
+        std::array<operand_stats,N> _operands;
+};
+
+template <size_t I, typename OpsT, typename HandlerT>
+status invoke_adaptive_operand(const OpsT& ops, const HandlerT& handler)
+{
+    return status(handler(hana::at_c<I>(ops)));
+}
+
+/**
+ * @brief Evaluate operand of hana tuple selected by runtime index.
+ */
+template <typename OpsT, typename HandlerT, size_t ... I>
+status invoke_adaptive_operand(size_t index, const OpsT& ops, const HandlerT& handler, std::index_sequence<I...>)
+{
+    using invoker=status (*)(const OpsT&, const HandlerT&);
+    static constexpr const invoker invokers[]={&invoke_adaptive_operand<I,OpsT,HandlerT>...};
+    return invokers[index](ops,handler);
+}
+
+/**
+ * @brief Check at compile time if operands of aggregation can be evaluated in adaptive order.
+ */
+template <typename AdapterT, typename=hana::when<true>>
+struct can_reorder_aggregation : public std::false_type
+{
+};
+
+/**
+ * @brief Operands of aggregation can be evaluated in adaptive order if adapter allows it.
+ */
+template <typename AdapterT>
+struct can_reorder_aggregation<AdapterT,
+            hana::when<
+                hana::is_a<adapter_tag,AdapterT>
+            >
+        > : public std::integral_constant<bool,
+                std::decay_t<AdapterT>::type::reorder_aggregations::value
+            >
+{
+};
+
+/**
+ * @brief Aggregation of intermediate validators with order of evaluation adapted to observed statistics.
+ *
+ * Operands are evaluated in adaptive order only by adapters that allow it with reorder_aggregations trait,
+ * other adapters evaluate operands in declared order with base aggregation.
+ */
+template <typename BaseAggregationT, size_t N>
+struct aggregate_adaptive_t
+{
+    static_assert(N<=16,"Adaptive aggregation supports at most 16 operands");
+
+    constexpr static bool is_and() noexcept
+    {
+        return std::is_same<BaseAggregationT,aggregate_and_t>::value;
+    }
+
+    template <typename T, typename OpsT>
+    status operator ()(T&& a,OpsT&& ops) const
+    {
+        return hana::eval_if(
+            hana::bool_c<can_reorder_aggregation<std::decay_t<T>>::value>,
+            [&](auto&& _)
+            {
+                return this->evaluate(_(ops),
+                    [&a](auto&& op)
+                    {
+                        return apply(a,op);
+                    }
+                );
+            },
+            [&](auto&& _)
+            {
+                return BaseAggregationT{}(std::forward<T>(_(a)),std::forward<OpsT>(_(ops)));
+            }
+        );
+    }
+
+    template <typename T, typename OpsT, typename MemberT>
+    status operator () (T&& a,MemberT&& member,OpsT&& ops) const
+    {
+        return hana::eval_if(
+            hana::bool_c<can_reorder_aggregation<std::decay_t<T>>::value>,
+            [&](auto&& _)
+            {
+                auto tmp_adapter=make_intermediate_adapter(_(a),_(member).path());
+                return this->evaluate(_(ops),
+                    [&tmp_adapter,&member](auto&& op)
+                    {
+                        return apply_member(tmp_adapter,op,member);
+                    }
+                );
+            },
+            [&](auto&& _)
+            {
+                return BaseAggregationT{}(std::forward<T>(_(a)),std::forward<MemberT>(_(member)),std::forward<OpsT>(_(ops)));
+            }
+        );
+    }
+
+    template <typename OpsT, typename HandlerT>
+    status evaluate(const OpsT& ops, const HandlerT& handler) const
+    {
+        auto order=stats->order();
+        auto timed=stats->start();
+        auto result=status(status::code::ignore);
+        for (size_t i=0;i<N;i++)
+        {
+            auto index=adaptive_stats<N>::at(order,i);
+            std::chrono::steady_clock::time_point start;
+            if (timed)
+            {
+                start=std::chrono::steady_clock::now();
+            }
+            result=invoke_adaptive_operand(index,ops,handler,std::make_index_sequence<N>{});
+            uint64_t duration=0;
+            if (timed)
+            {
+                duration=static_cast<uint64_t>(
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start).count()
+                        );
+            }
+            bool decided=is_and() ? !predicate_and(result) : !status_predicate_or(result);
+            stats->account(index,decided,duration,timed);
+            if (decided)
+            {
+                break;
+            }
+        }
+        stats->finish();
+        return result;
+    }
+
+    std::shared_ptr<adaptive_stats<N>> stats=std::make_shared<adaptive_stats<N>>();
+};
+
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_AGGREGATE_ADAPTIVE_HPP
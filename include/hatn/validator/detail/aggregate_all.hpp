@@ -22,6 +22,7 @@ Distributed under the Boost Software License, Version 1.0.
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/dispatcher.hpp>
 #include <hatn/validator/aggregation/all.hpp>
+#include <hatn/validator/detail/vectorized_aggregation.hpp>
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
@@ -44,7 +45,15 @@ struct aggregate_all_t
     template <typename T, typename OpT>
     constexpr bool operator ()(T&& a,OpT&& op) const
     {
-        return apply_member(std::forward<T>(a),std::forward<OpT>(op),make_plain_member(ALL));
+        return vectorized_aggregation(
+                    vectorized_all_kernel,
+                    a,
+                    op,
+                    [&a,&op]() -> bool
+                    {
+                        return apply_member(std::forward<T>(a),std::forward<OpT>(op),make_plain_member(ALL));
+                    }
+               );
     }
 
     /**
@@ -57,7 +66,16 @@ struct aggregate_all_t
     template <typename T, typename OpT, typename MemberT>
     constexpr bool operator () (T&& a,MemberT&& member,OpT&& op) const
     {
-        return apply_member(std::forward<T>(a),std::forward<OpT>(op),member[ALL]);
+        return vectorized_aggregation(
+                    vectorized_all_kernel,
+                    a,
+                    member,
+                    op,
+                    [&a,&op,&member]() -> bool
+                    {
+                        return apply_member(std::forward<T>(a),std::forward<OpT>(op),member[ALL]);
+                    }
+               );
     }
 };
 
@@ -0,0 +1,740 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/detail/batch_engine.hpp
+*
+*  Defines columnar rule-major engine for validation of batches of homogeneous objects.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_BATCH_ENGINE_HPP
+#define HATN_VALIDATOR_BATCH_ENGINE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <iterator>
+#include <type_traits>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/apply.hpp>
+#include <hatn/validator/extract.hpp>
+#include <hatn/validator/get_member.hpp>
+#include <hatn/validator/check_member_path.hpp>
+#include <hatn/validator/validators.hpp>
+#include <hatn/validator/aggregation/aggregation.hpp>
+#include <hatn/validator/detail/aggregate_and.hpp>
+#include <hatn/validator/detail/aggregate_or.hpp>
+#include <hatn/validator/detail/logical_not.hpp>
+#include <hatn/validator/detail/vectorized_aggregation.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+/**
+ * @brief Bitmap with one bit per object of a batch.
+ *
+ * Bits beyond the batch size are not maintained and must be ignored by readers.
+ */
+class batch_bitmap
+{
+    public:
+
+        constexpr static const size_t word_bits=64;
+
+        /**
+         * @brief Constructor.
+         * @param count Number of bits.
+         */
+        explicit batch_bitmap(size_t count=0)
+            : _count(count),
+              _words((count+word_bits-1)/word_bits,0)
+        {}
+
+        /**
+         * @brief Get number of bits.
+         * @return Number of bits.
+         */
+        size_t size() const noexcept
+        {
+            return _count;
+        }
+
+        /**
+         * @brief Get bit value.
+         * @param i Index of bit.
+         * @return Bit value.
+         */
+        bool test(size_t i) const noexcept
+        {
+            return ((_words[i/word_bits]>>(i%word_bits))&1)!=0;
+        }
+
+        /**
+         * @brief Set bit value.
+         * @param i Index of bit.
+         * @param val Bit value.
+         */
+        void set(size_t i, bool val) noexcept
+        {
+            auto& word=_words[i/word_bits];
+            auto mask=uint64_t(1)<<(i%word_bits);
+            word=val ? (word|mask) : (word&~mask);
+        }
+
+        /**
+         * @brief Count bits that are not set.
+         * @return Number of zero bits within the bitmap size.
+         */
+        size_t count_unset() const noexcept
+        {
+            size_t result=0;
+            for (size_t i=0;i<_count;i++)
+            {
+                result+=!test(i);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get words of the bitmap.
+         * @return Pointer to the first word.
+         */
+        uint64_t* data() noexcept
+        {
+            return _words.data();
+        }
+
+        batch_bitmap& operator &= (const batch_bitmap& other) noexcept
+        {
+            for (size_t i=0;i<_words.size();i++)
+            {
+                _words[i]&=other._words[i];
+            }
+            return *this;
+        }
+
+        batch_bitmap& operator |= (const batch_bitmap& other) noexcept
+        {
+            for (size_t i=0;i<_words.size();i++)
+            {
+                _words[i]|=other._words[i];
+            }
+            return *this;
+        }
+
+        /**
+         * @brief Invert all bits.
+         */
+        void flip() noexcept
+        {
+            for (auto& word:_words)
+            {
+                word=~word;
+            }
+        }
+
+    private:
+
+        size_t _count;
+        std::vector<uint64_t> _words;
+};
+
+/**
+ * @brief Statuses of validation of a batch.
+ *
+ * Validation status has three codes, so it is kept in two bitmaps:
+ * "ok" is set if status is not status::code::fail, "success" is set if status is status::code::success.
+ */
+struct batch_statuses
+{
+    /**
+     * @brief Constructor.
+     * @param count Number of objects in batch.
+     */
+    explicit batch_statuses(size_t count=0)
+        : ok(count),success(count)
+    {}
+
+    /**
+     * @brief Set status of object.
+     * @param i Index of object.
+     * @param val Status.
+     */
+    void set(size_t i, const status& val) noexcept
+    {
+        ok.set(i,val);
+        success.set(i,val.success());
+    }
+
+    batch_bitmap ok;
+    batch_bitmap success;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Kernel filling bitmap with results of predicate evaluated on each element of array.
+ *
+ * Bits are accumulated in a word without branches so that the compiler can vectorize the inner loop.
+ */
+struct vectorized_bitmap_kernel
+{
+    static_assert(vectorized_block_size==batch_bitmap::word_bits,"Block size of vectorized kernel must be equal to number of bits in bitmap word");
+
+    template <typename T, typename PredicateT>
+    bool operator () (const T* data, size_t count, const PredicateT& pred) const noexcept
+    {
+        size_t i=0;
+        size_t w=0;
+        for (;i+vectorized_block_size<=count;i+=vectorized_block_size,w++)
+        {
+            uint64_t word=0;
+            for (size_t j=0;j<vectorized_block_size;j++)
+            {
+                word|=uint64_t(pred(data[i+j]))<<j;
+            }
+            words[w]=word;
+        }
+        if (i<count)
+        {
+            uint64_t word=0;
+            for (size_t j=0;i+j<count;j++)
+            {
+                word|=uint64_t(pred(data[i+j]))<<j;
+            }
+            words[w]=word;
+        }
+        return true;
+    }
+
+    uint64_t* words;
+};
+
+/**
+ * @brief Get indexes of objects whose status of logical aggregation is not decided by preceding validators yet.
+ * @param statuses Statuses of preceding validators.
+ * @return Indexes of objects in ascending order.
+ *
+ * Status of AND is decided for objects that failed, status of OR is decided for objects that succeeded.
+ */
+template <typename AggregationT>
+std::vector<size_t> batch_undecided(const batch_statuses& statuses)
+{
+    std::vector<size_t> indexes;
+    for (size_t i=0;i<statuses.ok.size();i++)
+    {
+        bool undecided=std::is_same<AggregationT,aggregate_and_t>::value ? statuses.ok.test(i) : !statuses.success.test(i);
+        if (undecided)
+        {
+            indexes.push_back(i);
+        }
+    }
+    return indexes;
+}
+
+/**
+ * @brief Evaluate intermediate validator of logical aggregation AND/OR only for objects whose status is not decided yet.
+ * @param out Statuses of preceding validators updated with statuses of the next validator.
+ * @param evaluate Handler with signature "void (const std::vector<size_t>* indexes, batch_statuses& statuses)"
+ * evaluating the next validator for objects with given indexes or for all objects if indexes is nullptr.
+ *
+ * Mirrors validate_and() and validate_or() of adapters: the next validator is not applied to objects
+ * for which the result is already known, so rules guarded by preceding rules are never applied to objects
+ * that do not pass the guard, e.g. a member is not read if preceding rule checks that it does not exist.
+ */
+template <typename AggregationT, typename HandlerT>
+void batch_evaluate_undecided(batch_statuses& out, HandlerT&& evaluate)
+{
+    auto indexes=batch_undecided<AggregationT>(out);
+    if (indexes.empty())
+    {
+        return;
+    }
+
+    batch_statuses next(indexes.size());
+    if (indexes.size()==out.ok.size())
+    {
+        // status of aggregation is the status of the next validator for all objects
+        evaluate(static_cast<const std::vector<size_t>*>(nullptr),next);
+        out=std::move(next);
+        return;
+    }
+
+    evaluate(&indexes,next);
+    for (size_t i=0;i<indexes.size();i++)
+    {
+        out.ok.set(indexes[i],next.ok.test(i));
+        out.success.set(indexes[i],next.success.test(i));
+    }
+}
+
+/**
+ * @brief Negate statuses using logical NOT.
+ *
+ * Mirrors validate_not() of adapters: status is converted to boolean and negated.
+ */
+inline void batch_negate(batch_statuses& statuses)
+{
+    statuses.ok.flip();
+    statuses.success=statuses.ok;
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Validator node evaluated over a column of member values.
+ *
+ * Default node is not supported.
+ */
+template <typename T, typename ValueT, typename=hana::when<true>>
+struct batch_column_node
+{
+    using supported=std::false_type;
+};
+
+/**
+ * @brief Property validator of "value" property with operator and operand supported by vectorized kernels.
+ */
+template <typename T, typename ValueT>
+struct batch_column_node<T,ValueT,
+            hana::when<vectorized_element_validator<T>::supported::value>
+        >
+{
+    using supported=std::true_type;
+
+    static void evaluate(const T& v, const ValueT* column, size_t count, batch_statuses& out)
+    {
+        using descriptor=vectorized_element_validator<T>;
+        using predicate=typename descriptor::predicate;
+
+        predicate::invoke(vectorized_bitmap_kernel{out.ok.data()},column,count,descriptor::op(v),descriptor::operand(v));
+        out.success=out.ok;
+    }
+};
+
+/**
+ * @brief Validator wrapping a handler.
+ */
+template <typename HandlerT, typename ExistsOperatorT, typename ValueT>
+struct batch_column_node<validator_t<HandlerT,ExistsOperatorT>,ValueT,
+            hana::when<batch_column_node<HandlerT,ValueT>::supported::value>
+        >
+{
+    using supported=std::true_type;
+
+    static void evaluate(const validator_t<HandlerT,ExistsOperatorT>& v, const ValueT* column, size_t count, batch_statuses& out)
+    {
+        batch_column_node<HandlerT,ValueT>::evaluate(v.handler(),column,count,out);
+    }
+};
+
+/**
+ * @brief Helper to check if all intermediate validators of aggregation can be evaluated over a column.
+ */
+template <typename OpsT, typename ValueT>
+struct batch_column_nodes_supported : public std::false_type
+{
+};
+
+/**
+ * @brief Helper to check if all intermediate validators in tuple can be evaluated over a column.
+ */
+template <typename ... Ops, typename ValueT>
+struct batch_column_nodes_supported<hana::tuple<Ops...>,ValueT>
+            : public std::integral_constant<bool,
+                    hana::all(hana::make_tuple(hana::bool_c<batch_column_node<Ops,ValueT>::supported::value>...))
+                >
+{
+};
+
+/**
+ * @brief Logical aggregations AND/OR of validators that can be evaluated over a column.
+ */
+template <typename AggregationT, typename OpsT, typename WithCheckExistsT, typename ExistsOperatorT, typename ValueT>
+struct batch_column_node<base_validator<aggregation_validator_handler<AggregationT,OpsT>,WithCheckExistsT,ExistsOperatorT>,ValueT,
+            hana::when<
+                (std::is_same<AggregationT,aggregate_and_t>::value || std::is_same<AggregationT,aggregate_or_t>::value)
+                &&
+                !WithCheckExistsT::value
+                &&
+                batch_column_nodes_supported<OpsT,ValueT>::value
+            >
+        >
+{
+    using supported=std::true_type;
+
+    template <typename ValidatorT>
+    static void evaluate(const ValidatorT& v, const ValueT* column, size_t count, batch_statuses& out)
+    {
+        const auto& ops=v.fn.ops;
+        batch_column_node<std::decay_t<decltype(hana::front(ops))>,ValueT>::evaluate(hana::front(ops),column,count,out);
+        hana::for_each(
+            hana::drop_front(ops),
+            [&](const auto& op)
+            {
+                using node=batch_column_node<std::decay_t<decltype(op)>,ValueT>;
+                batch_evaluate_undecided<AggregationT>(out,
+                    [&](const std::vector<size_t>* indexes, batch_statuses& next)
+                    {
+                        if (indexes==nullptr)
+                        {
+                            node::evaluate(op,column,count,next);
+                            return;
+                        }
+                        std::vector<ValueT> selection;
+                        selection.reserve(indexes->size());
+                        for (auto i:*indexes)
+                        {
+                            selection.push_back(column[i]);
+                        }
+                        node::evaluate(op,selection.data(),selection.size(),next);
+                    }
+                );
+            }
+        );
+    }
+};
+
+/**
+ * @brief Logical NOT of validator that can be evaluated over a column.
+ */
+template <typename OpT, typename WithCheckExistsT, typename ExistsOperatorT, typename ValueT>
+struct batch_column_node<base_validator<aggregation_validator_handler<logical_not_t,OpT>,WithCheckExistsT,ExistsOperatorT>,ValueT,
+            hana::when<
+                !WithCheckExistsT::value
+                &&
+                batch_column_node<OpT,ValueT>::supported::value
+            >
+        >
+{
+    using supported=std::true_type;
+
+    template <typename ValidatorT>
+    static void evaluate(const ValidatorT& v, const ValueT* column, size_t count, batch_statuses& out)
+    {
+        batch_column_node<OpT,ValueT>::evaluate(v.fn.ops,column,count,out);
+        batch_negate(out);
+    }
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Type of member's values that can be gathered into a column, void if member can not be gathered.
+ */
+template <typename ObjectT, typename MemberT, typename=hana::when<true>>
+struct batch_member_value_type
+{
+    using type=void;
+};
+
+/**
+ * @brief Type of values of plain member whose path is valid for the object.
+ */
+template <typename ObjectT, typename MemberT>
+struct batch_member_value_type<ObjectT,MemberT,
+            hana::when<
+                !MemberT::is_aggregated::value
+                &&
+                !MemberT::is_with_varg::value
+                &&
+                decltype(is_member_path_valid(std::declval<const ObjectT&>(),std::declval<const typename MemberT::path_type&>()))::value
+            >
+        >
+{
+    using type=std::decay_t<decltype(get_member(std::declval<const ObjectT&>(),std::declval<const typename MemberT::path_type&>()))>;
+};
+
+/**
+ * @brief Type of objects of a batch.
+ */
+template <typename RecordsT>
+using batch_object_type=std::decay_t<decltype(extract(*std::begin(std::declval<const RecordsT&>())))>;
+
+/**
+ * @brief Selection of objects of a batch that can be iterated as a container of objects.
+ */
+template <typename RecordsT>
+class batch_selection
+{
+    public:
+
+        using value_type=std::remove_reference_t<decltype(*std::begin(std::declval<const RecordsT&>()))>;
+
+        /**
+         * @brief Iterator of selection.
+         */
+        class const_iterator
+        {
+            public:
+
+                using iterator_category=std::forward_iterator_tag;
+                using value_type=typename batch_selection::value_type;
+                using difference_type=std::ptrdiff_t;
+                using pointer=value_type*;
+                using reference=value_type&;
+
+                explicit const_iterator(typename std::vector<value_type*>::const_iterator it) : _it(it)
+                {}
+
+                reference operator* () const
+                {
+                    return **_it;
+                }
+
+                const_iterator& operator++ ()
+                {
+                    ++_it;
+                    return *this;
+                }
+
+                bool operator== (const const_iterator& other) const
+                {
+                    return _it==other._it;
+                }
+
+                bool operator!= (const const_iterator& other) const
+                {
+                    return _it!=other._it;
+                }
+
+            private:
+
+                typename std::vector<value_type*>::const_iterator _it;
+        };
+
+        /**
+         * @brief Constructor.
+         * @param records Container of objects.
+         * @param indexes Indexes of objects to select in ascending order.
+         */
+        batch_selection(const RecordsT& records, const std::vector<size_t>& indexes)
+        {
+            _objects.reserve(indexes.size());
+            size_t i=0;
+            auto next=indexes.begin();
+            for (auto&& record:records)
+            {
+                if (next==indexes.end())
+                {
+                    break;
+                }
+                if (*next==i)
+                {
+                    _objects.push_back(&record);
+                    ++next;
+                }
+                ++i;
+            }
+        }
+
+        const_iterator begin() const
+        {
+            return const_iterator(_objects.begin());
+        }
+
+        const_iterator end() const
+        {
+            return const_iterator(_objects.end());
+        }
+
+        size_t size() const noexcept
+        {
+            return _objects.size();
+        }
+
+    private:
+
+        std::vector<value_type*> _objects;
+};
+
+/**
+ * @brief Validator node evaluated over batch of objects.
+ *
+ * Default node is evaluated by applying the node to each object of the batch one by one.
+ */
+template <typename T, typename ObjectT, typename=hana::when<true>>
+struct batch_node
+{
+    template <typename RecordsT>
+    static void evaluate(const T& v, const RecordsT& records, batch_statuses& out)
+    {
+        size_t i=0;
+        for (auto&& record:records)
+        {
+            out.set(i++,status(apply(ensure_adapter(record),v)));
+        }
+    }
+};
+
+/**
+ * @brief Validator wrapping a handler.
+ */
+template <typename HandlerT, typename ExistsOperatorT, typename ObjectT>
+struct batch_node<validator_t<HandlerT,ExistsOperatorT>,ObjectT>
+{
+    template <typename RecordsT>
+    static void evaluate(const validator_t<HandlerT,ExistsOperatorT>& v, const RecordsT& records, batch_statuses& out)
+    {
+        batch_node<HandlerT,ObjectT>::evaluate(v.handler(),records,out);
+    }
+};
+
+/**
+ * @brief Logical aggregations AND/OR of intermediate validators.
+ */
+template <typename AggregationT, typename OpsT, typename WithCheckExistsT, typename ExistsOperatorT, typename ObjectT>
+struct batch_node<base_validator<aggregation_validator_handler<AggregationT,OpsT>,WithCheckExistsT,ExistsOperatorT>,ObjectT,
+            hana::when<
+                std::is_same<AggregationT,aggregate_and_t>::value || std::is_same<AggregationT,aggregate_or_t>::value
+            >
+        >
+{
+    template <typename ValidatorT, typename RecordsT>
+    static void evaluate(const ValidatorT& v, const RecordsT& records, batch_statuses& out)
+    {
+        const auto& ops=v.fn.ops;
+        batch_node<std::decay_t<decltype(hana::front(ops))>,ObjectT>::evaluate(hana::front(ops),records,out);
+        hana::for_each(
+            hana::drop_front(ops),
+            [&](const auto& op)
+            {
+                using node=batch_node<std::decay_t<decltype(op)>,ObjectT>;
+                batch_evaluate_undecided<AggregationT>(out,
+                    [&](const std::vector<size_t>* indexes, batch_statuses& next)
+                    {
+                        if (indexes==nullptr)
+                        {
+                            node::evaluate(op,records,next);
+                            return;
+                        }
+                        node::evaluate(op,batch_selection<RecordsT>(records,*indexes),next);
+                    }
+                );
+            }
+        );
+    }
+};
+
+/**
+ * @brief Logical NOT of intermediate validator.
+ */
+template <typename OpT, typename WithCheckExistsT, typename ExistsOperatorT, typename ObjectT>
+struct batch_node<base_validator<aggregation_validator_handler<logical_not_t,OpT>,WithCheckExistsT,ExistsOperatorT>,ObjectT>
+{
+    template <typename ValidatorT, typename RecordsT>
+    static void evaluate(const ValidatorT& v, const RecordsT& records, batch_statuses& out)
+    {
+        batch_node<OpT,ObjectT>::evaluate(v.fn.ops,records,out);
+        batch_negate(out);
+    }
+};
+
+/**
+ * @brief Property validator applied to objects that are numbers, objects are used as a column.
+ */
+template <typename T, typename ObjectT>
+struct batch_node<T,ObjectT,
+            hana::when<
+                is_vectorizable_number<ObjectT>::value
+                &&
+                batch_column_node<T,ObjectT>::supported::value
+                &&
+                hana::is_a<property_validator_tag,T>
+            >
+        >
+{
+    template <typename RecordsT>
+    static void evaluate(const T& v, const RecordsT& records, batch_statuses& out,
+                         std::enable_if_t<std::is_same<typename contiguous_element_type<RecordsT>::type,ObjectT>::value,void*> =nullptr)
+    {
+        batch_column_node<T,ObjectT>::evaluate(v,records.data(),records.size(),out);
+    }
+
+    template <typename RecordsT>
+    static void evaluate(const T& v, const RecordsT& records, batch_statuses& out,
+                         std::enable_if_t<!std::is_same<typename contiguous_element_type<RecordsT>::type,ObjectT>::value,void*> =nullptr)
+    {
+        std::vector<ObjectT> column;
+        column.reserve(out.ok.size());
+        for (auto&& record:records)
+        {
+            column.push_back(extract(record));
+        }
+        batch_column_node<T,ObjectT>::evaluate(v,column.data(),column.size(),out);
+    }
+};
+
+/**
+ * @brief Validator of a member whose values can be gathered into a column and validated with vectorized kernels.
+ *
+ * Values of the member are gathered from all objects of the batch once and then each leaf validator of the member
+ * is evaluated over the whole column.
+ */
+template <typename MemberT, typename ValidatorT, typename ExistsOperatorT, typename ObjectT>
+struct batch_node<validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>,ObjectT,
+            hana::when<
+                !ValidatorT::with_check_exists::value
+                &&
+                is_vectorizable_number<typename batch_member_value_type<ObjectT,MemberT>::type>::value
+                &&
+                batch_column_node<ValidatorT,typename batch_member_value_type<ObjectT,MemberT>::type>::supported::value
+            >
+        >
+{
+    using value_type=typename batch_member_value_type<ObjectT,MemberT>::type;
+
+    template <typename RecordsT>
+    static void evaluate(const validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>& v, const RecordsT& records, batch_statuses& out)
+    {
+        const auto& path=v.member().path();
+        std::vector<value_type> column;
+        column.reserve(out.ok.size());
+        for (auto&& record:records)
+        {
+            column.push_back(get_member(extract(record),path));
+        }
+        batch_column_node<ValidatorT,value_type>::evaluate(v.prepared_validator(),column.data(),column.size(),out);
+    }
+};
+
+/**
+ * @brief Evaluate validator over batch of objects.
+ * @param v Validator.
+ * @param records Container of objects.
+ * @param count Number of objects in container.
+ * @return Bitmap of validation results where bits are set for objects that passed validation.
+ */
+template <typename ValidatorT, typename RecordsT>
+batch_bitmap evaluate_batch(const ValidatorT& v, const RecordsT& records, size_t count)
+{
+    batch_statuses statuses(count);
+    if (count!=0)
+    {
+        batch_node<std::decay_t<ValidatorT>,batch_object_type<RecordsT>>::evaluate(v,records,statuses);
+    }
+    return std::move(statuses.ok);
+}
+
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_BATCH_ENGINE_HPP
@@ -19,10 +19,15 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef HATN_VALIDATOR_FORMATTER_FMT_HPP
 #define HATN_VALIDATOR_FORMATTER_FMT_HPP
 
+#include <cstring>
+#include <type_traits>
+
 #include <fmt/ranges.h>
 #include <fmt/format.h>
+#include <fmt/compile.h>
 
 #include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/reference_wrapper.hpp>
 #include <hatn/validator/utils/hana_to_std_tuple.hpp>
 #include <hatn/validator/reporting/concrete_phrase.hpp>
 #include <hatn/validator/utils/object_wrapper.hpp>
@@ -63,6 +68,75 @@ HATN_VALIDATOR_NAMESPACE_BEGIN
 namespace detail
 {
 
+/**
+ * @brief Check if type is a fmt::basic_memory_buffer.
+ */
+template <typename T>
+struct is_fmt_memory_buffer : public std::false_type
+{};
+
+template <typename CharT, size_t Size, typename AllocatorT>
+struct is_fmt_memory_buffer<fmt::basic_memory_buffer<CharT,Size,AllocatorT>> : public std::true_type
+{};
+
+/**
+ * @brief Prepare value for formatting, fmt::memory_buffer is formatted as a string.
+ */
+template <typename T>
+auto fmt_arg(const T& val,
+             std::enable_if_t<!is_fmt_memory_buffer<T>::value,void*> =nullptr) -> const T&
+{
+    return val;
+}
+
+template <typename T>
+auto fmt_arg(const T& val,
+             std::enable_if_t<is_fmt_memory_buffer<T>::value,void*> =nullptr)
+{
+    return fmt::basic_string_view<typename T::value_type>(val.data(),val.size());
+}
+
+/**
+ * @brief Append single value to destination object.
+ * @param dst Destination object.
+ * @param val Value to append.
+ *
+ * Format string is compiled, so no format string is parsed at runtime.
+ */
+template <typename DstT, typename T>
+void fmt_append_value(DstT& dst, const T& val)
+{
+    fmt::format_to(std::back_inserter(dst),FMT_COMPILE("{}"),fmt_arg(val));
+}
+
+/**
+ * @brief Trim fmt::memory_buffer which can not be trimmed with boost::trim.
+ * @param dst Buffer to trim.
+ */
+template <typename DstT>
+void fmt_trim(DstT& dst)
+{
+    auto is_space=[](auto ch)
+    {
+        return ch==' ' || ch=='\t' || ch=='\n' || ch=='\r' || ch=='\v' || ch=='\f';
+    };
+    size_t end=dst.size();
+    while (end!=0 && is_space(dst[end-1]))
+    {
+        --end;
+    }
+    size_t begin=0;
+    while (begin!=end && is_space(dst[begin]))
+    {
+        ++begin;
+    }
+    if (begin!=0)
+    {
+        std::memmove(dst.data(),dst.data()+begin,(end-begin)*sizeof(typename DstT::value_type));
+    }
+    dst.resize(end-begin);
+}
+
 /**
  * @brief Join vector of parts and append to destination object.
  * @param dst Destination object.
@@ -73,7 +147,15 @@ template <typename DstT, typename SepT, typename PartsT>
 void fmt_append_join(DstT& dst, SepT&& sep, PartsT&& parts,
                      std::enable_if_t<!hana::is_a<hana::tuple_tag,PartsT>,void*> =nullptr)
 {
-    fmt::format_to(std::back_inserter(dst),"{}",fmt::join(std::forward<PartsT>(parts),std::forward<SepT>(sep)));
+    size_t i=0;
+    for (auto&& it:parts)
+    {
+        if (i++!=0)
+        {
+            fmt_append_value(dst,sep);
+        }
+        fmt_append_value(dst,it);
+    }
 }
 
 /**
@@ -86,7 +168,19 @@ template <typename DstT, typename SepT, typename PartsT>
 void fmt_append_join(DstT& dst, SepT&& sep, PartsT&& parts,
                      std::enable_if_t<hana::is_a<hana::tuple_tag,PartsT>,void*> =nullptr)
 {
-    fmt::format_to(std::back_inserter(dst),"{}",fmt::join(hana_to_std_tuple(std::forward<PartsT>(parts)),std::forward<SepT>(sep)));
+    hana::fold(
+        std::forward<PartsT>(parts),
+        0u,
+        [&dst,&sep](size_t i,auto&& v)
+        {
+            if (i!=0u)
+            {
+                fmt_append_value(dst,sep);
+            }
+            fmt_append_value(dst,extract_ref(std::forward<decltype(v)>(v)));
+            return i+1;
+        }
+    );
 }
 
 /**
@@ -95,7 +189,7 @@ void fmt_append_join(DstT& dst, SepT&& sep, PartsT&& parts,
 template <typename DstT, typename SepT, typename ...Args>
 void fmt_append_join_args(DstT& dst, SepT&& sep, Args&&... args)
 {
-    fmt::format_to(std::back_inserter(dst),"{}",fmt::join(std::make_tuple(std::forward<Args>(args)...),std::forward<SepT>(sep)));
+    fmt_append_join(dst,std::forward<SepT>(sep),make_cref_tuple(std::forward<Args>(args)...));
 }
 
 /**
@@ -104,7 +198,13 @@ void fmt_append_join_args(DstT& dst, SepT&& sep, Args&&... args)
 template <typename DstT, typename ...Args>
 void fmt_append_args(DstT& dst, Args&&... args)
 {
-    fmt_append_join_args(dst,"",std::forward<Args>(args)...);
+    hana::for_each(
+        make_cref_tuple(std::forward<Args>(args)...),
+        [&dst](auto&& v)
+        {
+            fmt_append_value(dst,extract_ref(std::forward<decltype(v)>(v)));
+        }
+    );
 }
 
 struct backend_formatter_tag;
@@ -112,7 +212,7 @@ struct backend_formatter_tag;
 /**
  * @brief Backend formatter that uses libfmt fot formatting.
  *
- * Destination object is normally a std::string.
+ * Destination object is normally a std::string or fmt::memory_buffer.
  * Also it can be a container of chars that can deal with inserter iterators,
  * i.e. it must be suitable for using std::back_inserter(dst), dst.insert(), dst.begin(), dst.end().
  */
@@ -10,7 +10,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 /** @file validator/detail/formatter_std.hpp
 *
-*  Defines formatter that uses std::stringstream for strings formatting.
+*  Defines formatter that uses standard library for strings formatting.
 *
 */
 
@@ -19,11 +19,27 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef HATN_VALIDATOR_FORMATTER_STD_HPP
 #define HATN_VALIDATOR_FORMATTER_STD_HPP
 
+#include <algorithm>
 #include <string>
 #include <sstream>
+#include <cstdio>
+#include <type_traits>
+
+#if __cplusplus >= 201703L
+#include <charconv>
+#endif
 
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/utils/reference_wrapper.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/reporting/concrete_phrase.hpp>
+
+/**
+ * @brief Capacity to reserve in empty destination string before formatting a report.
+ */
+#ifndef HATN_VALIDATOR_REPORT_RESERVE
+    #define HATN_VALIDATOR_REPORT_RESERVE 128
+#endif
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
@@ -33,65 +49,252 @@ namespace detail
 {
 
 /**
- * @brief Append arguments to destination string.
- * @param dst Destination string.
+ * @brief Default helper to append value to destination using std::ostringstream.
+ *
+ * It is used only for types that are neither strings nor numbers.
+ */
+template <typename T, typename =hana::when<true>>
+struct std_append_value_t
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        std::ostringstream ss;
+        ss<<val;
+        auto str=ss.str();
+        dst.append(str.data(),str.size());
+    }
+};
+
+/**
+ * @brief Helper to append strings.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<std::is_constructible<string_view,T>::value>
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        string_view str(val);
+        dst.append(str.data(),str.size());
+    }
+};
+
+/**
+ * @brief Helper to append concrete phrases.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<std::is_same<concrete_phrase,T>::value>
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        const auto& str=val.text();
+        dst.append(str.data(),str.size());
+    }
+};
+
+/**
+ * @brief Helper to append chars.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<
+                std::is_same<char,T>::value || std::is_same<signed char,T>::value || std::is_same<unsigned char,T>::value
+            >
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        auto ch=static_cast<char>(val);
+        dst.append(&ch,1);
+    }
+};
+
+/**
+ * @brief Helper to append booleans the same way as std::ostream does.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<std::is_same<bool,T>::value>
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        dst.append(val ? "1" : "0",1);
+    }
+};
+
+/**
+ * @brief Helper to append integers.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<
+                std::is_integral<T>::value
+                && !std::is_same<bool,T>::value
+                && !std::is_same<char,T>::value && !std::is_same<signed char,T>::value && !std::is_same<unsigned char,T>::value
+            >
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        char buf[24];
+#if __cplusplus >= 201703L
+        auto end=std::to_chars(buf,buf+sizeof(buf),val).ptr;
+        dst.append(buf,static_cast<size_t>(end-buf));
+#else
+        using unsigned_type=std::make_unsigned_t<T>;
+        auto negative=is_negative(val,std::is_signed<T>{});
+        auto v=static_cast<unsigned_type>(val);
+        if (negative)
+        {
+            v=static_cast<unsigned_type>(0u-v);
+        }
+        auto begin=buf+sizeof(buf);
+        do
+        {
+            *--begin=static_cast<char>('0'+v%10);
+            v/=10;
+        }
+        while (v!=0);
+        if (negative)
+        {
+            *--begin='-';
+        }
+        dst.append(begin,static_cast<size_t>(buf+sizeof(buf)-begin));
+#endif
+    }
+
+    static bool is_negative(const T& val, std::true_type) noexcept
+    {
+        return val<0;
+    }
+
+    static bool is_negative(const T&, std::false_type) noexcept
+    {
+        return false;
+    }
+};
+
+/**
+ * @brief Helper to append floating point numbers with the same precision as std::ostream does by default.
+ */
+template <typename T>
+struct std_append_value_t<T,
+            hana::when<std::is_floating_point<T>::value>
+        >
+{
+    template <typename DstT>
+    void operator() (DstT& dst, const T& val) const
+    {
+        char buf[64];
+#if defined(__cpp_lib_to_chars) && __cpp_lib_to_chars >= 201611L
+        auto end=std::to_chars(buf,buf+sizeof(buf),val,std::chars_format::general,6).ptr;
+        dst.append(buf,static_cast<size_t>(end-buf));
+#else
+        auto count=std::snprintf(buf,sizeof(buf),"%Lg",static_cast<long double>(val));
+        if (count>0)
+        {
+            dst.append(buf,std::min(static_cast<size_t>(count),sizeof(buf)-1));
+        }
+#endif
+    }
+};
+
+/**
+ * @brief Append value to destination.
+ * @param dst Destination object that has method append(const char* data, size_t size).
+ * @param val Value.
+ */
+template <typename DstT, typename T>
+void std_append_value(DstT& dst, const T& val)
+{
+    std_append_value_t<T>{}(dst,val);
+}
+
+/**
+ * @brief Reserve capacity in empty destination string.
+ */
+inline void std_reserve(std::string& dst)
+{
+    if (dst.capacity()<HATN_VALIDATOR_REPORT_RESERVE)
+    {
+        dst.reserve(HATN_VALIDATOR_REPORT_RESERVE);
+    }
+}
+
+/**
+ * @brief Destinations other than strings manage their capacity by themselves.
+ */
+template <typename DstT>
+void std_reserve(DstT&)
+{
+}
+
+/**
+ * @brief Append arguments to destination object.
+ * @param dst Destination object.
  * @param sep Separator for joining arguments.
- * @param parts Vector to join and append to string.
+ * @param parts Vector to join and append to destination object.
  */
-template <typename PartsT, typename SepT>
-void std_append_join(std::string& dst, SepT&& sep, PartsT&& parts,
+template <typename DstT, typename PartsT, typename SepT>
+void std_append_join(DstT& dst, SepT&& sep, PartsT&& parts,
                      std::enable_if_t<!hana::is_a<hana::tuple_tag,PartsT>,void*> =nullptr)
 {
+    std_reserve(dst);
     size_t i=0;
-    std::stringstream ss;
-    ss<<dst;
     for (auto&& it:parts)
     {
         if (i++!=0)
         {
-            ss<<sep;
+            std_append_value(dst,sep);
         }
-        ss<<it;
+        std_append_value(dst,it);
     }
-    dst=ss.str();
 }
 
 /**
- * @brief Append arguments to destination string.
- * @param dst Destination string.
+ * @brief Append arguments to destination object.
+ * @param dst Destination object.
  * @param sep Separator for joining arguments.
- * @param parts Hana tuple to join and append to string.
+ * @param parts Hana tuple to join and append to destination object.
  */
-template <typename PartsT, typename SepT>
-void std_append_join(std::string& dst, SepT&& sep, PartsT&& parts,
+template <typename DstT, typename PartsT, typename SepT>
+void std_append_join(DstT& dst, SepT&& sep, PartsT&& parts,
                      std::enable_if_t<hana::is_a<hana::tuple_tag,PartsT>,void*> =nullptr)
 {
-    std::stringstream ss;
-    ss<<dst;
+    std_reserve(dst);
     hana::fold(
         std::forward<PartsT>(parts),
         0u,
-        [&ss,&sep](size_t i,auto&& v)
+        [&dst,&sep](size_t i,auto&& v)
         {
             if (i!=0u)
             {
-                ss<<sep;
+                std_append_value(dst,sep);
             }
-            ss<<extract_ref(std::forward<decltype(v)>(v));
+            std_append_value(dst,extract_ref(std::forward<decltype(v)>(v)));
             return i+1;
         }
     );
-    dst=ss.str();
 }
 
 /**
- * @brief Append arguments to destination string.
- * @param dst Destination string.
+ * @brief Append arguments to destination object.
+ * @param dst Destination object.
  * @param sep Separator for joining arguments.
- * @param args Arguments to join and append to string.
+ * @param args Arguments to join and append to destination object.
  */
-template <typename SepT, typename ...Args>
-void std_append(std::string& dst, SepT&& sep, Args&&... args)
+template <typename DstT, typename SepT, typename ...Args>
+void std_append(DstT& dst, SepT&& sep, Args&&... args)
 {
     std_append_join(dst,std::forward<SepT>(sep),make_cref_tuple(std::forward<Args>(args)...));
 }
@@ -99,7 +302,10 @@ void std_append(std::string& dst, SepT&& sep, Args&&... args)
 struct backend_formatter_tag;
 
 /**
- * @brief Backend formatter that uses std::stringstream fot formatting.
+ * @brief Backend formatter that uses standard library for formatting.
+ *
+ * Arguments are appended to destination string in place, numbers are formatted with std::to_chars if it is available,
+ * std::ostringstream is used only for types that are neither strings nor numbers.
  */
 struct std_backend_formatter
 {
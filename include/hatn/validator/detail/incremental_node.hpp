@@ -0,0 +1,442 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/detail/incremental_node.hpp
+*
+*  Defines nodes of validator used for incremental validation.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_INCREMENTAL_NODE_HPP
+#define HATN_VALIDATOR_INCREMENTAL_NODE_HPP
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+#include <utility>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/apply.hpp>
+#include <hatn/validator/lazy.hpp>
+#include <hatn/validator/member_path.hpp>
+#include <hatn/validator/validators.hpp>
+#include <hatn/validator/property_validator.hpp>
+#include <hatn/validator/aggregation/aggregation.hpp>
+#include <hatn/validator/detail/aggregate_and.hpp>
+#include <hatn/validator/detail/aggregate_or.hpp>
+#include <hatn/validator/detail/logical_not.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+struct member_tag;
+
+namespace detail
+{
+
+/**
+ * @brief Dependency of validator node on any member of the object.
+ */
+struct dependency_any
+{
+};
+
+/**
+ * @brief Dependency of validator node on a member path.
+ */
+template <typename PathT>
+struct dependency_path
+{
+    const PathT* path;
+};
+
+/**
+ * @brief Make dependency on a member path.
+ * @param path Member path.
+ * @return Dependency.
+ */
+template <typename PathT>
+auto make_dependency_path(const PathT& path)
+{
+    return dependency_path<PathT>{&path};
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Dependencies of a validator on members used as operands.
+ *
+ * Validators whose content can not be inspected depend on any member.
+ */
+template <typename T, typename=hana::when<true>>
+struct operand_dependencies
+{
+    static auto collect(const T&)
+    {
+        return hana::make_tuple(dependency_any{});
+    }
+};
+
+/**
+ * @brief Dependencies of property validator.
+ *
+ * Operand referencing other member adds dependency on the path of that member,
+ * lazy operand can be evaluated from anything and adds dependency on any member.
+ */
+template <typename PropT, typename OpT, typename OperandT, typename PropertyT, typename CheckExistsT, typename ExistsOperatorT>
+struct operand_dependencies<property_validator<property_validator_handler<PropT,OpT,OperandT>,PropertyT,CheckExistsT,ExistsOperatorT>>
+{
+    template <typename T>
+    static auto collect(const T& v)
+    {
+        using operand_type=unwrap_object_t<OperandT>;
+        return hana::eval_if(
+            hana::is_a<member_tag,operand_type>,
+            [&](auto&& _)
+            {
+                return hana::make_tuple(make_dependency_path(path_of(unwrap_object(_(v).fn.operand))));
+            },
+            [](auto&&)
+            {
+                return hana::eval_if(
+                    hana::is_a<lazy_tag,operand_type>,
+                    [](auto&&)
+                    {
+                        return hana::make_tuple(dependency_any{});
+                    },
+                    [](auto&&)
+                    {
+                        return hana::make_tuple();
+                    }
+                );
+            }
+        );
+    }
+};
+
+/**
+ * @brief Dependencies of validator wrapping a handler.
+ */
+template <typename HandlerT, typename ExistsOperatorT>
+struct operand_dependencies<validator_t<HandlerT,ExistsOperatorT>>
+{
+    template <typename T>
+    static auto collect(const T& v)
+    {
+        return operand_dependencies<HandlerT>::collect(v.handler());
+    }
+};
+
+/**
+ * @brief Dependencies of aggregation of intermediate validators.
+ */
+template <typename AggregationT, typename OpsT, typename WithCheckExistsT, typename ExistsOperatorT>
+struct operand_dependencies<base_validator<aggregation_validator_handler<AggregationT,OpsT>,WithCheckExistsT,ExistsOperatorT>>
+{
+    template <typename T>
+    static auto collect(const T& v)
+    {
+        return hana::eval_if(
+            hana::is_a<hana::tuple_tag,OpsT>,
+            [&](auto&& _)
+            {
+                return hana::flatten(hana::transform(_(v).fn.ops,
+                    [](const auto& op)
+                    {
+                        return operand_dependencies<std::decay_t<decltype(op)>>::collect(op);
+                    }
+                ));
+            },
+            [&](auto&& _)
+            {
+                return operand_dependencies<OpsT>::collect(_(v).fn.ops);
+            }
+        );
+    }
+};
+
+/**
+ * @brief Dependencies of validator of nested member.
+ *
+ * Path of nested member is covered by path of the outer member.
+ */
+template <typename MemberT, typename ValidatorT, typename ExistsOperatorT>
+struct operand_dependencies<validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>>
+{
+    template <typename T>
+    static auto collect(const T& v)
+    {
+        return operand_dependencies<ValidatorT>::collect(v.prepared_validator());
+    }
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Dependency entry of validator node.
+ */
+template <typename DependenciesT>
+struct dependency_entry
+{
+    size_t slot;
+    DependenciesT dependencies;
+};
+
+/**
+ * @brief Make dependency entry of validator node.
+ * @param slot Slot of the node.
+ * @param dependencies Dependencies of the node.
+ * @return Dependency entry.
+ */
+template <typename DependenciesT>
+auto make_dependency_entry(size_t slot, DependenciesT&& dependencies)
+{
+    return dependency_entry<std::decay_t<DependenciesT>>{slot,std::forward<DependenciesT>(dependencies)};
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief State of incremental validation run.
+ *
+ * Slots of nodes that were skipped by short-circuiting of aggregations are marked as not evaluated,
+ * so that they are evaluated on the next run even if they are not affected by changes.
+ */
+struct incremental_state
+{
+    const std::vector<bool>& affected;
+    const std::vector<status>* previous;
+    const std::vector<bool>* previous_evaluated;
+    std::vector<status>& statuses;
+    std::vector<bool>& evaluated;
+
+    /**
+     * @brief Check if previous status of a slot can be used.
+     * @param slot Slot.
+     * @return True if the slot was evaluated in previous run and is not affected by changes.
+     */
+    bool use_previous(size_t slot) const
+    {
+        return previous!=nullptr && !affected[slot] && (*previous_evaluated)[slot];
+    }
+
+    /**
+     * @brief Set status of evaluated slot.
+     * @param slot Slot.
+     * @param val Status.
+     * @return Status.
+     */
+    status set(size_t slot, status val)
+    {
+        statuses[slot]=val;
+        evaluated[slot]=true;
+        return val;
+    }
+
+    /**
+     * @brief Mark slots of a node as not evaluated.
+     * @param slot First slot of the node.
+     * @param count Number of slots of the node.
+     */
+    void skip(size_t slot, size_t count)
+    {
+        for (size_t i=slot;i<slot+count;i++)
+        {
+            statuses[i]=status(status::code::ignore);
+            evaluated[i]=false;
+        }
+    }
+};
+
+/**
+ * @brief Leaf node of validator that is validated as a whole.
+ *
+ * Leaf is validated only if it is affected by changes or if there is no previous status, otherwise previous status is used.
+ */
+template <typename T>
+struct incremental_leaf
+{
+    constexpr static const size_t slots=1;
+
+    template <typename ObjectT>
+    static status evaluate(const T& v, const ObjectT& obj, size_t slot, incremental_state& state)
+    {
+        if (state.use_previous(slot))
+        {
+            return state.set(slot,(*state.previous)[slot]);
+        }
+        return state.set(slot,status(apply(ensure_adapter(obj),v)));
+    }
+};
+
+/**
+ * @brief Node of validator used for incremental validation.
+ *
+ * Each node occupies one or more slots in the list of cached statuses. The first slot keeps status of the node itself,
+ * the rest slots keep statuses of the child nodes.
+ *
+ * Default node is a leaf that depends on any member of the object.
+ */
+template <typename T, typename=hana::when<true>>
+struct incremental_node : public incremental_leaf<T>
+{
+    static auto dependencies(const T&, size_t slot)
+    {
+        return hana::make_tuple(make_dependency_entry(slot,hana::make_tuple(dependency_any{})));
+    }
+};
+
+/**
+ * @brief Validator of a member is a leaf that depends on the member and on members used as operands.
+ */
+template <typename MemberT, typename ValidatorT, typename ExistsOperatorT>
+struct incremental_node<validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>>
+            : public incremental_leaf<validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>>
+{
+    template <typename T>
+    static auto dependencies(const T& v, size_t slot)
+    {
+        return hana::make_tuple(make_dependency_entry(slot,
+                    hana::prepend(
+                        operand_dependencies<ValidatorT>::collect(v.prepared_validator()),
+                        make_dependency_path(v.member().path())
+                    )
+               ));
+    }
+};
+
+/**
+ * @brief Validator wrapping a handler does not occupy own slots.
+ */
+template <typename HandlerT, typename ExistsOperatorT>
+struct incremental_node<validator_t<HandlerT,ExistsOperatorT>>
+{
+    constexpr static const size_t slots=incremental_node<HandlerT>::slots;
+
+    template <typename T>
+    static auto dependencies(const T& v, size_t slot)
+    {
+        return incremental_node<HandlerT>::dependencies(v.handler(),slot);
+    }
+
+    template <typename T, typename ObjectT>
+    static status evaluate(const T& v, const ObjectT& obj, size_t slot, incremental_state& state)
+    {
+        return incremental_node<HandlerT>::evaluate(v.handler(),obj,slot,state);
+    }
+};
+
+/**
+ * @brief Helper to get number of slots of intermediate validators preceding intermediate validator with given index.
+ */
+template <typename ... Ops>
+constexpr size_t incremental_prefix_slots(size_t index)
+{
+    const size_t sizes[]={incremental_node<Ops>::slots...};
+    size_t result=0;
+    for (size_t i=0;i<index;i++)
+    {
+        result+=sizes[i];
+    }
+    return result;
+}
+
+/**
+ * @brief Logical aggregations AND/OR of intermediate validators.
+ *
+ * Status of aggregation is recombined from cached statuses of intermediate validators.
+ * Intermediate validators are short-circuited the same way as in aggregate_and/aggregate_or,
+ * so that members checked by the preceding validators can be used as guards, e.g. with "exists" operator.
+ * Skipped intermediate validators are marked as not evaluated.
+ */
+template <typename AggregationT, typename ... Ops, typename WithCheckExistsT, typename ExistsOperatorT>
+struct incremental_node<base_validator<aggregation_validator_handler<AggregationT,hana::tuple<Ops...>>,WithCheckExistsT,ExistsOperatorT>,
+            hana::when<
+                std::is_same<AggregationT,aggregate_and_t>::value || std::is_same<AggregationT,aggregate_or_t>::value
+            >
+        >
+{
+    constexpr static const size_t slots=1+incremental_prefix_slots<Ops...>(sizeof...(Ops));
+
+    template <typename T>
+    static auto dependencies(const T& v, size_t slot)
+    {
+        return hana::unpack(
+            hana::make_range(hana::size_c<0>,hana::size_c<sizeof...(Ops)>),
+            [&](auto... indexes)
+            {
+                return hana::flatten(hana::make_tuple(
+                    incremental_node<Ops>::dependencies(v.fn.ops[indexes],slot+1+incremental_prefix_slots<Ops...>(indexes))...
+                ));
+            }
+        );
+    }
+
+    template <typename T, typename ObjectT>
+    static status evaluate(const T& v, const ObjectT& obj, size_t slot, incremental_state& state)
+    {
+        status result(status::code::ignore);
+        bool done=false;
+        hana::for_each(
+            hana::make_range(hana::size_c<0>,hana::size_c<sizeof...(Ops)>),
+            [&](auto index)
+            {
+                using op_type=std::decay_t<decltype(v.fn.ops[index])>;
+                auto child_slot=slot+1+incremental_prefix_slots<Ops...>(index);
+                if (done)
+                {
+                    state.skip(child_slot,incremental_node<op_type>::slots);
+                    return;
+                }
+
+                result=incremental_node<op_type>::evaluate(v.fn.ops[index],obj,child_slot,state);
+                done=std::is_same<AggregationT,aggregate_and_t>::value
+                        ? result.value()==status::code::fail
+                        : !status_predicate_or(result);
+            }
+        );
+        return state.set(slot,result);
+    }
+};
+
+/**
+ * @brief Logical NOT of intermediate validator.
+ */
+template <typename OpT, typename WithCheckExistsT, typename ExistsOperatorT>
+struct incremental_node<base_validator<aggregation_validator_handler<logical_not_t,OpT>,WithCheckExistsT,ExistsOperatorT>>
+{
+    constexpr static const size_t slots=1+incremental_node<OpT>::slots;
+
+    template <typename T>
+    static auto dependencies(const T& v, size_t slot)
+    {
+        return incremental_node<OpT>::dependencies(v.fn.ops,slot+1);
+    }
+
+    template <typename T, typename ObjectT>
+    static status evaluate(const T& v, const ObjectT& obj, size_t slot, incremental_state& state)
+    {
+        auto child=incremental_node<OpT>::evaluate(v.fn.ops,obj,slot+1,state);
+        return state.set(slot,status(!child));
+    }
+};
+
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_INCREMENTAL_NODE_HPP
@@ -0,0 +1,250 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/detail/validator_cost.hpp
+*
+*  Defines compile time estimation of cost of validators.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_VALIDATOR_COST_HPP
+#define HATN_VALIDATOR_VALIDATOR_COST_HPP
+
+#include <type_traits>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/cost_class.hpp>
+#include <hatn/validator/range.hpp>
+#include <hatn/validator/member.hpp>
+#include <hatn/validator/lazy.hpp>
+#include <hatn/validator/validators.hpp>
+#include <hatn/validator/property_validator.hpp>
+#include <hatn/validator/operators/wrap_op.hpp>
+#include <hatn/validator/aggregation/aggregation.hpp>
+#include <hatn/validator/detail/logical_not.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace detail
+{
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Estimated number of elements in containers validated with element aggregations.
+ */
+constexpr const int element_aggregation_cost_factor=16;
+
+/**
+ * @brief Estimated cost of a validator whose structure is unknown, e.g. a validator with custom handler.
+ */
+constexpr const int unknown_validator_cost=cost_weight(cost_class::moderate);
+
+/**
+ * @brief Cost class of operator, default is "cheap" for operators that do not define a cost class.
+ */
+template <typename OpT, typename=hana::when<true>>
+struct operator_cost_class : public std::integral_constant<cost_class,cost_class::cheap>
+{
+};
+
+/**
+ * @brief Cost class of operator that defines a cost class.
+ */
+template <typename OpT>
+struct operator_cost_class<OpT,
+            hana::when<
+                std::is_same<std::decay_t<decltype(OpT::cost)>,cost_class>::value
+            >
+        > : public std::integral_constant<cost_class,OpT::cost>
+{
+};
+
+/**
+ * @brief Cost class of wrapped operator.
+ */
+template <typename T>
+struct operator_cost_class<wrap_op<T>> : public operator_cost_class<std::decay_t<T>>
+{
+};
+
+/**
+ * @brief Estimated cost of operator with operand.
+ */
+template <typename OpT, typename OperandT, typename=hana::when<true>>
+struct operator_cost : public std::integral_constant<int,cost_weight(operator_cost_class<OpT>::value)>
+{
+};
+
+/**
+ * @brief Searching in range is expensive regardless of operator.
+ */
+template <typename OpT, typename OperandT>
+struct operator_cost<OpT,OperandT,
+            hana::when<
+                hana::is_a<range_tag,unwrap_object_t<OperandT>>
+            >
+        > : public std::integral_constant<int,cost_weight(cost_class::expensive)>
+{
+};
+
+/**
+ * @brief Operands that are other members or lazy values add cost of their evaluation.
+ */
+template <typename OpT, typename OperandT>
+struct operator_cost<OpT,OperandT,
+            hana::when<
+                hana::is_a<member_tag,unwrap_object_t<OperandT>>
+                ||
+                hana::is_a<lazy_tag,unwrap_object_t<OperandT>>
+            >
+        > : public std::integral_constant<int,cost_weight(operator_cost_class<OpT>::value)+cost_weight(cost_class::cheap)>
+{
+};
+
+/**
+ * @brief Estimated cost of property.
+ */
+template <typename PropT, typename=hana::when<true>>
+struct property_cost : public std::integral_constant<int,cost_weight(cost_class::trivial)>
+{
+};
+
+/**
+ * @brief Estimated cost of property that defines a cost class.
+ */
+template <typename PropT>
+struct property_cost<PropT,
+            hana::when<
+                std::is_same<std::decay_t<decltype(PropT::cost)>,cost_class>::value
+            >
+        > : public std::integral_constant<int,cost_weight(PropT::cost)>
+{
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Estimated cost of validator.
+ *
+ * Default cost is used for validators whose structure can not be inspected.
+ */
+template <typename T, typename=hana::when<true>>
+struct validator_cost : public std::integral_constant<int,unknown_validator_cost>
+{
+};
+
+/**
+ * @brief Estimated cost of a tuple of validators is a sum of their costs.
+ */
+template <typename ...Ops>
+struct validator_cost<hana::tuple<Ops...>> : public std::integral_constant<int,0>
+{
+};
+
+template <typename OpT, typename ...Ops>
+struct validator_cost<hana::tuple<OpT,Ops...>>
+        : public std::integral_constant<int,
+                validator_cost<std::decay_t<OpT>>::value
+                +
+                validator_cost<hana::tuple<Ops...>>::value
+            >
+{
+};
+
+/**
+ * @brief Estimated cost of validator wrapping a handler.
+ */
+template <typename HandlerT, typename ExistsOperatorT>
+struct validator_cost<validator_t<HandlerT,ExistsOperatorT>> : public validator_cost<HandlerT>
+{
+};
+
+/**
+ * @brief Estimated cost of validator with hint.
+ */
+template <typename ValidatorT, typename HintT>
+struct validator_cost<validator_with_hint_t<ValidatorT,HintT>> : public validator_cost<ValidatorT>
+{
+};
+
+/**
+ * @brief Estimated cost of property validator.
+ */
+template <typename PropT, typename OpT, typename OperandT, typename PropT1, typename CheckExistsT, typename ExistsOperatorT>
+struct validator_cost<property_validator<property_validator_handler<PropT,OpT,OperandT>,PropT1,CheckExistsT,ExistsOperatorT>>
+        : public std::integral_constant<int,
+                property_cost<PropT>::value
+                +
+                operator_cost<OpT,OperandT>::value
+            >
+{
+};
+
+/**
+ * @brief Estimated cost of logical aggregation is a sum of costs of its operands.
+ */
+template <typename AggregationT, typename ...Ops, typename WithCheckExistsT, typename ExistsOperatorT>
+struct validator_cost<base_validator<aggregation_validator_handler<AggregationT,hana::tuple<Ops...>>,WithCheckExistsT,ExistsOperatorT>>
+        : public validator_cost<hana::tuple<Ops...>>
+{
+};
+
+/**
+ * @brief Estimated cost of logical NOT is a cost of its operand.
+ */
+template <typename OpT, typename WithCheckExistsT, typename ExistsOperatorT>
+struct validator_cost<base_validator<aggregation_validator_handler<logical_not_t,OpT>,WithCheckExistsT,ExistsOperatorT>>
+        : public validator_cost<std::decay_t<OpT>>
+{
+};
+
+/**
+ * @brief Estimated cost of element aggregation ALL/ANY is a cost of its operand multiplied by estimated number of elements.
+ */
+template <typename AggregationT, typename OpT, typename WithCheckExistsT, typename ExistsOperatorT>
+struct validator_cost<base_validator<aggregation_validator_handler<AggregationT,OpT>,WithCheckExistsT,ExistsOperatorT>,
+            hana::when<
+                !std::is_same<AggregationT,logical_not_t>::value
+                &&
+                !hana::is_a<hana::tuple_tag,OpT>
+            >
+        >
+        : public std::integral_constant<int,
+                validator_cost<std::decay_t<OpT>>::value*element_aggregation_cost_factor
+            >
+{
+};
+
+/**
+ * @brief Estimated cost of member validator.
+ *
+ * Members with element aggregations in their paths are validated once per element.
+ */
+template <typename MemberT, typename ValidatorT, typename ExistsOperatorT>
+struct validator_cost<validator_with_member_t<MemberT,ValidatorT,ExistsOperatorT>>
+        : public std::integral_constant<int,
+                (cost_weight(cost_class::trivial)+validator_cost<ValidatorT>::value)
+                *
+                (MemberT::is_aggregated::value ? element_aggregation_cost_factor : 1)
+            >
+{
+};
+
+//-------------------------------------------------------------
+
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_VALIDATOR_COST_HPP
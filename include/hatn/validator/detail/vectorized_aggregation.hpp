@@ -0,0 +1,530 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/detail/vectorized_aggregation.hpp
+*
+*  Defines vectorized kernels for ALL/ANY element aggregations over contiguous containers of numbers.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_VECTORIZED_AGGREGATION_HPP
+#define HATN_VALIDATOR_VECTORIZED_AGGREGATION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/embedded_object.hpp>
+#include <hatn/validator/property_validator.hpp>
+#include <hatn/validator/properties/value.hpp>
+#include <hatn/validator/operators/comparison.hpp>
+#include <hatn/validator/operators/in.hpp>
+#include <hatn/validator/interval.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+struct adapter_tag;
+struct reporting_adapter_tag;
+
+namespace detail
+{
+
+/**
+ * @brief Number of elements processed in a single block of vectorized kernel before checking the intermediate result.
+ */
+constexpr const size_t vectorized_block_size=64;
+
+/**
+ * @brief Check if all elements of array satisfy predicate.
+ * @param data Pointer to the first element.
+ * @param count Number of elements.
+ * @param pred Predicate.
+ * @return True if all elements satisfy predicate.
+ *
+ * Elements are processed in blocks without branches inside a block so that the compiler can vectorize the inner loop.
+ */
+template <typename T, typename PredicateT>
+bool vectorized_all_of(const T* data, size_t count, const PredicateT& pred) noexcept
+{
+    size_t i=0;
+    for (;i+vectorized_block_size<=count;i+=vectorized_block_size)
+    {
+        bool ok=true;
+        for (size_t j=0;j<vectorized_block_size;j++)
+        {
+            ok&=pred(data[i+j]);
+        }
+        if (!ok)
+        {
+            return false;
+        }
+    }
+    bool ok=true;
+    for (;i<count;i++)
+    {
+        ok&=pred(data[i]);
+    }
+    return ok;
+}
+
+/**
+ * @brief Check if at least one element of array satisfies predicate.
+ * @param data Pointer to the first element.
+ * @param count Number of elements.
+ * @param pred Predicate.
+ * @return True if at least one element satisfies predicate.
+ */
+template <typename T, typename PredicateT>
+bool vectorized_any_of(const T* data, size_t count, const PredicateT& pred) noexcept
+{
+    size_t i=0;
+    for (;i+vectorized_block_size<=count;i+=vectorized_block_size)
+    {
+        bool found=false;
+        for (size_t j=0;j<vectorized_block_size;j++)
+        {
+            found|=pred(data[i+j]);
+        }
+        if (found)
+        {
+            return true;
+        }
+    }
+    bool found=false;
+    for (;i<count;i++)
+    {
+        found|=pred(data[i]);
+    }
+    return found;
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Check if type is a number suitable for vectorized kernels.
+ */
+template <typename T>
+using is_vectorizable_number=std::integral_constant<bool,
+                std::is_arithmetic<T>::value && !std::is_same<T,bool>::value
+            >;
+
+/**
+ * @brief Type of elements of contiguous container, void if container is not contiguous.
+ */
+template <typename T, typename=hana::when<true>>
+struct contiguous_element_type
+{
+    using type=void;
+};
+
+/**
+ * @brief Type of elements of container that has data() and size() methods.
+ */
+template <typename T>
+struct contiguous_element_type<T,
+            hana::when_valid<
+                decltype(std::declval<const T&>().data()),
+                decltype(std::declval<const T&>().size())
+            >
+        >
+{
+    using pointer_type=decltype(std::declval<const T&>().data());
+    using type=std::conditional_t<
+                    std::is_pointer<pointer_type>::value,
+                    std::remove_cv_t<std::remove_pointer_t<pointer_type>>,
+                    void
+                >;
+};
+
+/**
+ * @brief Check if container is a contiguous container of numbers.
+ */
+template <typename T>
+using is_contiguous_numbers=is_vectorizable_number<typename contiguous_element_type<std::decay_t<T>>::type>;
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Predicate of vectorized kernel built from validation operator and operand.
+ *
+ * Default predicate is not supported.
+ */
+template <typename OpT, typename OperandT, typename=hana::when<true>>
+struct vectorized_predicate
+{
+    using supported=std::false_type;
+};
+
+/**
+ * @brief Predicate of vectorized kernel for comparison operators with number operands.
+ */
+template <typename OpT, typename OperandT>
+struct vectorized_predicate<OpT,OperandT,
+            hana::when<
+                (std::is_same<OpT,eq_t>::value
+                 || std::is_same<OpT,ne_t>::value
+                 || std::is_same<OpT,lt_t>::value
+                 || std::is_same<OpT,lte_t>::value
+                 || std::is_same<OpT,gt_t>::value
+                 || std::is_same<OpT,gte_t>::value
+                )
+                &&
+                is_vectorizable_number<OperandT>::value
+            >
+        >
+{
+    using supported=std::true_type;
+
+    template <typename KernelT, typename T>
+    static bool invoke(const KernelT& kernel, const T* data, size_t count, const OpT& op, const OperandT& b)
+    {
+        return kernel(data,count,
+                      [&op,&b](const T& v)
+                      {
+                          return op(v,b);
+                      }
+                    );
+    }
+};
+
+/**
+ * @brief Predicate of vectorized kernel for operators in/nin with intervals of numbers.
+ *
+ * Endpoints are compared without short-circuiting so that the kernel stays branchless.
+ */
+template <typename OpT, typename OperandT>
+struct vectorized_predicate<OpT,OperandT,
+            hana::when<
+                (std::is_same<OpT,in_t>::value || std::is_same<OpT,nin_t>::value)
+                &&
+                hana::is_a<interval_tag,OperandT>
+                &&
+                is_vectorizable_number<unwrap_object_t<typename OperandT::type>>::value
+            >
+        >
+{
+    using supported=std::true_type;
+    constexpr static const bool negate=std::is_same<OpT,nin_t>::value;
+
+    template <typename KernelT, typename T>
+    static bool invoke(const KernelT& kernel, const T* data, size_t count, const OpT&, const OperandT& b)
+    {
+        const auto& from=unwrap_object(b.from);
+        const auto& to=unwrap_object(b.to);
+        switch (b.mode)
+        {
+            case interval_mode::closed:
+                return kernel(data,count,
+                              [&from,&to](const T& v)
+                              {
+                                  return (gte(v,from) & lte(v,to))!=negate;
+                              }
+                            );
+            case interval_mode::open:
+                return kernel(data,count,
+                              [&from,&to](const T& v)
+                              {
+                                  return (gt(v,from) & lt(v,to))!=negate;
+                              }
+                            );
+            case interval_mode::open_from:
+                return kernel(data,count,
+                              [&from,&to](const T& v)
+                              {
+                                  return (gt(v,from) & lte(v,to))!=negate;
+                              }
+                            );
+            case interval_mode::open_to:
+                break;
+        }
+        return kernel(data,count,
+                      [&from,&to](const T& v)
+                      {
+                          return (gte(v,from) & lt(v,to))!=negate;
+                      }
+                    );
+    }
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Descriptor of element validator that can be evaluated with vectorized kernels.
+ *
+ * Default descriptor is not supported.
+ */
+template <typename T>
+struct vectorized_element_validator
+{
+    using supported=std::false_type;
+};
+
+/**
+ * @brief Descriptor of element validator checking "value" property with operator and plain operand.
+ */
+template <typename OpT, typename OperandT, typename PropT, typename ExistsOperatorT>
+struct vectorized_element_validator<
+            property_validator<property_validator_handler<type_p_value,OpT,OperandT>,PropT,hana::false_,ExistsOperatorT>
+        >
+{
+    using operand_type=unwrap_object_t<OperandT>;
+    using predicate=vectorized_predicate<OpT,operand_type>;
+    using supported=typename predicate::supported;
+
+    template <typename ValidatorT>
+    static const OpT& op(const ValidatorT& v) noexcept
+    {
+        return v.fn.op;
+    }
+
+    template <typename ValidatorT>
+    static const operand_type& operand(const ValidatorT& v) noexcept
+    {
+        return unwrap_object(v.fn.operand);
+    }
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Helper to adjust vectorized aggregations to adapter.
+ *
+ * Adapters that do not construct reports need neither to repeat failed aggregation element by element nor to skip the kernel.
+ */
+template <typename AdapterT, typename=hana::when<true>>
+struct vectorized_aggregation_adapter
+{
+    template <typename AdapterT1>
+    static bool skip(const AdapterT1&) noexcept
+    {
+        return false;
+    }
+
+    using repeat_failed=std::false_type;
+};
+
+/**
+ * @brief Helper to adjust vectorized aggregations to reporting adapter.
+ *
+ * Reporting adapters must repeat failed aggregation element by element in order to find the first failed element for the report.
+ * Within NOT aggregation the reports are constructed for succeeded elements too, so kernels must be skipped.
+ */
+template <typename AdapterT>
+struct vectorized_aggregation_adapter<AdapterT,
+        hana::when<
+            std::is_base_of<reporting_adapter_tag,typename std::decay_t<AdapterT>::type>::value
+        >>
+{
+    template <typename AdapterT1>
+    static bool skip(const AdapterT1& adapter)
+    {
+        return traits_of(adapter).reporter().current_not();
+    }
+
+    using repeat_failed=std::true_type;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Check at compile time if element aggregation can be evaluated with vectorized kernels.
+ */
+template <typename AdapterT, typename OpT, typename=hana::when<true>>
+struct can_vectorize_aggregation : public std::false_type
+{
+};
+
+/**
+ * @brief Element aggregation can be evaluated with vectorized kernels if adapter allows it and element validator is supported.
+ */
+template <typename AdapterT, typename OpT>
+struct can_vectorize_aggregation<AdapterT,OpT,
+            hana::when<
+                hana::is_a<adapter_tag,AdapterT>
+            >
+        > : public std::integral_constant<bool,
+                std::decay_t<AdapterT>::type::vectorize_element_aggregations::value
+                &&
+                vectorized_element_validator<std::decay_t<OpT>>::supported::value
+            >
+{
+};
+
+/**
+ * @brief Implementer of vectorized element aggregations.
+ *
+ * If validator of elements checks "value" property with comparison operator or in/nin interval operator and the container
+ * is a contiguous container of numbers then the elements are checked with vectorized kernel.
+ * The normal element by element aggregation is invoked only if the kernel is not applicable or if the kernel fails and a report must be constructed.
+ */
+struct vectorized_aggregation_impl
+{
+    /**
+     * @brief Invoke aggregation on object's member.
+     * @param kernel Kernel, either vectorized_all_of or vectorized_any_of.
+     * @param adapter Validation adapter.
+     * @param member Member assumed to be a container.
+     * @param op Validator of elements.
+     * @param fallback Normal element by element aggregation.
+     * @return Result of aggregation.
+     */
+    template <typename KernelT, typename AdapterT, typename MemberT, typename OpT, typename FallbackT>
+    bool operator() (const KernelT& kernel, AdapterT&& adapter, MemberT&& member, OpT&& op, FallbackT&& fallback) const
+    {
+        return hana::eval_if(
+            hana::bool_c<
+                can_vectorize_aggregation<AdapterT,OpT>::value
+                &&
+                !std::decay_t<MemberT>::is_aggregated::value
+                &&
+                !std::decay_t<MemberT>::has_varg()
+            >,
+            [&](auto&& _)
+            {
+                if (vectorized_aggregation_adapter<AdapterT>::skip(_(adapter))
+                    ||
+                    !embedded_object_has_member(_(adapter),_(member))
+                    )
+                {
+                    return _(fallback)();
+                }
+                return hana::eval_if(
+                    is_embedded_object_path_valid(_(adapter),_(member).path()),
+                    [&](auto&& _)
+                    {
+                        return this->apply_kernel(kernel,_(adapter),embedded_object_member(_(adapter),_(member)),_(op),_(fallback));
+                    },
+                    [&](auto&& _)
+                    {
+                        return _(fallback)();
+                    }
+                );
+            },
+            [&](auto&& _)
+            {
+                return _(fallback)();
+            }
+        );
+    }
+
+    /**
+     * @brief Invoke aggregation on the object itself.
+     * @param kernel Kernel, either vectorized_all_of or vectorized_any_of.
+     * @param adapter Validation adapter.
+     * @param op Validator of elements.
+     * @param fallback Normal element by element aggregation.
+     * @return Result of aggregation.
+     */
+    template <typename KernelT, typename AdapterT, typename OpT, typename FallbackT>
+    bool operator() (const KernelT& kernel, AdapterT&& adapter, OpT&& op, FallbackT&& fallback) const
+    {
+        return hana::eval_if(
+            can_vectorize_aggregation<AdapterT,OpT>{},
+            [&](auto&& _)
+            {
+                if (vectorized_aggregation_adapter<AdapterT>::skip(_(adapter)))
+                {
+                    return _(fallback)();
+                }
+                return this->apply_kernel(kernel,_(adapter),embedded_object(_(adapter)),_(op),_(fallback));
+            },
+            [&](auto&& _)
+            {
+                return _(fallback)();
+            }
+        );
+    }
+
+    private:
+
+        template <typename KernelT, typename AdapterT, typename ContainerT, typename OpT, typename FallbackT>
+        static bool apply_kernel(const KernelT& kernel, AdapterT&& adapter, ContainerT&& container, OpT&& op, FallbackT&& fallback)
+        {
+            using descriptor=vectorized_element_validator<std::decay_t<OpT>>;
+
+            std::ignore=adapter;
+            return hana::eval_if(
+                is_contiguous_numbers<ContainerT>{},
+                [&](auto&& _)
+                {
+                    const auto& c=_(container);
+                    if (c.size()==0)
+                    {
+                        // status of empty aggregation depends on aggregation type
+                        return _(fallback)();
+                    }
+                    if (descriptor::predicate::invoke(kernel,c.data(),static_cast<size_t>(c.size()),descriptor::op(_(op)),descriptor::operand(_(op))))
+                    {
+                        return true;
+                    }
+                    return hana::eval_if(
+                        typename vectorized_aggregation_adapter<AdapterT>::repeat_failed{},
+                        [&](auto&& _)
+                        {
+                            // repeat aggregation element by element to find failed element for the report
+                            return _(fallback)();
+                        },
+                        [&](auto&&)
+                        {
+                            return false;
+                        }
+                    );
+                },
+                [&](auto&& _)
+                {
+                    return _(fallback)();
+                }
+            );
+        }
+};
+/**
+ * @brief Invoke element aggregation using vectorized kernels if possible.
+ */
+constexpr vectorized_aggregation_impl vectorized_aggregation{};
+
+/**
+ * @brief Kernel for ALL aggregation.
+ */
+struct vectorized_all_kernel_t
+{
+    template <typename T, typename PredicateT>
+    bool operator() (const T* data, size_t count, const PredicateT& pred) const noexcept
+    {
+        return vectorized_all_of(data,count,pred);
+    }
+};
+constexpr vectorized_all_kernel_t vectorized_all_kernel{};
+
+/**
+ * @brief Kernel for ANY aggregation.
+ */
+struct vectorized_any_kernel_t
+{
+    template <typename T, typename PredicateT>
+    bool operator() (const T* data, size_t count, const PredicateT& pred) const noexcept
+    {
+        return vectorized_any_of(data,count,pred);
+    }
+};
+constexpr vectorized_any_kernel_t vectorized_any_kernel{};
+
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_VECTORIZED_AGGREGATION_HPP
@@ -122,6 +122,9 @@ class filter_path_traits : public BaseTraitsT,
 {
     public:
 
+        // paths of elements can be filtered, so each element must be visited separately
+        using vectorize_element_aggregations=std::integral_constant<bool,false>;
+
         /**
          * @brief Constructor.
          * @param Original adapter traits.
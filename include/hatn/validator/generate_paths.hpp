@@ -33,9 +33,10 @@ template <typename KeyT, typename Enable=hana::when<true>>
 struct generate_paths_t
 {
     template <typename UsedPathSizeT, typename PathT, typename AdapterT, typename HandlerT>
-    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler) const
+    status operator () (UsedPathSizeT&& used_path_size, PathT&& path, AdapterT&& adapter, HandlerT&& handler, const void* key=nullptr) const
     {
         std::ignore=used_path_size;
+        std::ignore=key;
         return handler(std::forward<AdapterT>(adapter),std::forward<PathT>(path),hana::size(path));
     }
 };
@@ -45,6 +46,7 @@ struct generate_paths_t
  * @param path Previous/original path.
  * @param adapter Validation adapter.
  * @param handler Validation handler to apply to member with generated path.
+ * @param key Address of the last key of the path in the original member, it identifies aggregations within validator.
  * @return Validation status.
  *
  * Paths can be generated in case of element aggregations and trees.
@@ -0,0 +1,256 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/lazy_once.hpp
+*
+*  Defines wrapper for deferred invokation of a handler that is evaluated only once per validation run.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_LAZY_ONCE_HPP
+#define HATN_VALIDATOR_LAZY_ONCE_HPP
+
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <unordered_map>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/lazy.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Cache of values of lazy_once operands.
+ */
+class lazy_once_cache
+{
+    public:
+
+        /**
+         * @brief Get cached value, evaluate it if it is not cached yet.
+         * @param id ID of lazy_once operand.
+         * @param fn Handler to evaluate the value.
+         * @return Cached value.
+         */
+        template <typename T, typename FnT>
+        const T& get(size_t id, const FnT& fn)
+        {
+            auto it=_values.find(id);
+            if (it==_values.end())
+            {
+                it=_values.emplace(id,std::make_shared<T>(fn())).first;
+            }
+            return *static_cast<const T*>(it->second.get());
+        }
+
+        /**
+         * @brief Get number of cached values.
+         * @return Number of values.
+         */
+        size_t size() const noexcept
+        {
+            return _values.size();
+        }
+
+    private:
+
+        std::unordered_map<size_t,std::shared_ptr<void>> _values;
+};
+
+/**
+ * @brief Scope of validation run that keeps values of lazy_once operands.
+ *
+ * Scope is bound to the thread where it was created, so concurrent validation runs in different threads
+ * never share the values. The values are dropped when the scope is destroyed.
+ *
+ * Scope is created automatically on the top level of validator's apply() if there is no active scope in current thread.
+ * Scope can also be created explicitly in order to share values of lazy_once operands between a few validation runs.
+ */
+class lazy_once_scope
+{
+    public:
+
+        /**
+         * @brief Constructor, makes this scope active in current thread.
+         */
+        lazy_once_scope() : _prev(current_ref())
+        {
+            current_ref()=this;
+        }
+
+        /**
+         * @brief Destructor, restores previous scope of current thread.
+         */
+        ~lazy_once_scope()
+        {
+            current_ref()=_prev;
+        }
+
+        lazy_once_scope(const lazy_once_scope&)=delete;
+        lazy_once_scope(lazy_once_scope&&)=delete;
+        lazy_once_scope& operator=(const lazy_once_scope&)=delete;
+        lazy_once_scope& operator=(lazy_once_scope&&)=delete;
+
+        /**
+         * @brief Get active scope of current thread.
+         * @return Active scope or nullptr if there is no active scope.
+         */
+        static lazy_once_scope* current() noexcept
+        {
+            return current_ref();
+        }
+
+        /**
+         * @brief Get cache of values evaluated in this scope.
+         * @return Cache.
+         */
+        lazy_once_cache& cache() noexcept
+        {
+            return _cache;
+        }
+
+    private:
+
+        static lazy_once_scope*& current_ref() noexcept
+        {
+            static thread_local lazy_once_scope* scope=nullptr;
+            return scope;
+        }
+
+        lazy_once_scope* _prev;
+        lazy_once_cache _cache;
+};
+
+/**
+ * @brief Invoke handler within lazy_once scope.
+ * @param fn Handler.
+ * @return Result of the handler.
+ *
+ * If there is an active scope in current thread then the handler is invoked within that scope,
+ * otherwise a new scope is created for the handler.
+ */
+template <typename FnT>
+auto with_lazy_once_scope(FnT&& fn) -> decltype(auto)
+{
+    if (lazy_once_scope::current()!=nullptr)
+    {
+        return fn();
+    }
+    lazy_once_scope scope;
+    return fn();
+}
+
+namespace detail
+{
+
+inline size_t next_lazy_once_id() noexcept
+{
+    static std::atomic<size_t> id{0};
+    return ++id;
+}
+
+}
+
+/**
+ * @brief Lazy invokation handler whose result is evaluated only once per validation run.
+ *
+ * Copies of the handler share the same ID, so they share the same value within a run.
+ * The value is returned by value, i.e. it is copied from the cache of active scope.
+ */
+template <typename T>
+struct lazy_once_t
+{
+    using hana_tag=lazy_tag;
+    using value_type=std::decay_t<decltype(std::declval<const T&>()())>;
+
+    T fn;
+    size_t id;
+
+    value_type operator()() const
+    {
+        auto scope=lazy_once_scope::current();
+        if (scope!=nullptr)
+        {
+            return scope->cache().template get<value_type>(id,fn);
+        }
+
+        // out of validation run the handler is invoked every time and nothing is cached
+        return fn();
+    }
+};
+
+/**
+ * @brief Check if type is lazy_once_t or has lazy_once_t among its template arguments at any depth.
+ */
+template <typename T>
+struct has_lazy_once : public std::false_type
+{
+};
+
+template <typename T>
+struct has_lazy_once<lazy_once_t<T>> : public std::true_type
+{
+};
+
+template <template <typename...> class TemplateT, typename ...Args>
+struct has_lazy_once<TemplateT<Args...>>
+    : public std::integral_constant<bool,
+            decltype(hana::any(hana::make_tuple(hana::false_c,hana::bool_c<has_lazy_once<std::remove_cv_t<std::remove_reference_t<Args>>>::value>...)))::value
+        >
+{
+};
+
+/**
+ * @brief Invoke handler within lazy_once scope only if validator has lazy_once operands.
+ * @param fn Handler.
+ * @return Result of the handler.
+ *
+ * Validators without lazy_once operands neither look up nor create the scope.
+ */
+template <typename ValidatorT, typename FnT>
+auto with_lazy_once_scope_of(FnT&& fn) -> decltype(auto)
+{
+    return hana::eval_if(
+        has_lazy_once<ValidatorT>{},
+        [&](auto&& _)
+        {
+            return with_lazy_once_scope(_(fn));
+        },
+        [&](auto&& _)
+        {
+            return _(fn)();
+        }
+    );
+}
+
+/**
+  @brief Construct handler for deferred invokation that is evaluated only once per validation run.
+  @param fn Handler that will be invoked later on demand.
+
+  Result of the handler is kept in lazy_once_scope that is active in current thread.
+  Validators create the scope automatically, so the handler is invoked at most once per each validator's apply()
+  and the result is dropped when apply() completes.
+*/
+template <typename T>
+auto lazy_once(T&& fn)
+{
+    return lazy_once_t<std::decay_t<T>>{std::forward<T>(fn),detail::next_lazy_once_id()};
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_LAZY_ONCE_HPP
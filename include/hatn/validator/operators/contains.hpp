@@ -35,6 +35,7 @@ struct contains_t : public op<contains_t>
 {
     constexpr static const char* description="must contain";
     constexpr static const char* n_description="must not contain";
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -40,6 +40,7 @@ struct exists_t : public exists_tag,
 
     constexpr static const char* description="must exist";
     constexpr static const char* n_description="must not exist";
+    constexpr static const cost_class cost=cost_class::trivial;
 
     static const char* str(const bool& b)
     {
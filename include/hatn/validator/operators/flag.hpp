@@ -41,6 +41,8 @@ struct flag_t : public adjust_storable_ignore
 {
     using hana_tag=operator_tag;
 
+    constexpr static const cost_class cost=cost_class::trivial;
+
     /**
      * @brief Comparison operator.
      * @param a Left operand.
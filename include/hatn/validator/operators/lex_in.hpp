@@ -38,6 +38,7 @@ struct lex_in_t : public op<lex_in_t>
 {
     constexpr static const char* description=in_t::description;
     constexpr static const char* n_description=in_t::n_description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     /**
      * @brief Call when operand is an interval.
@@ -111,6 +112,7 @@ struct lex_nin_t : public op<lex_nin_t>
 {
     constexpr static const char* description=lex_in_t::n_description;
     constexpr static const char* n_description=lex_in_t::description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -131,6 +133,7 @@ struct ilex_in_t : public op<ilex_in_t>
 {
     constexpr static const char* description=in_t::description;
     constexpr static const char* n_description=in_t::n_description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     /**
      * @brief Call when operand is an interval
@@ -204,6 +207,7 @@ struct ilex_nin_t : public op<ilex_nin_t>
 {
     constexpr static const char* description=ilex_in_t::n_description;
     constexpr static const char* n_description=ilex_in_t::description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
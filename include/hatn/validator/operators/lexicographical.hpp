@@ -133,6 +133,7 @@ struct lex_eq_t : public op<lex_eq_t>
 {
     constexpr static const char* description=eq_t::description;
     constexpr static const char* n_description=eq_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -153,6 +154,7 @@ struct lex_ne_t : public op<lex_ne_t>
 {
     constexpr static const char* description=ne_t::description;
     constexpr static const char* n_description=ne_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -173,6 +175,7 @@ struct lex_lt_t : public op<lex_lt_t>
 {
     constexpr static const char* description=lt_t::description;
     constexpr static const char* n_description=lt_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -193,6 +196,7 @@ struct lex_lte_t : public op<lex_lte_t>
 {
     constexpr static const char* description=lte_t::description;
     constexpr static const char* n_description=lte_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -213,6 +217,7 @@ struct lex_gt_t : public op<lex_gt_t>
 {
     constexpr static const char* description=gt_t::description;
     constexpr static const char* n_description=gt_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -233,6 +238,7 @@ struct lex_gte_t : public op<lex_gte_t>
 {
     constexpr static const char* description=gte_t::description;
     constexpr static const char* n_description=gte_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -253,6 +259,7 @@ struct ilex_eq_t : public op<ilex_eq_t>
 {
     constexpr static const char* description=eq_t::description;
     constexpr static const char* n_description=eq_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -273,6 +280,7 @@ struct ilex_ne_t : public op<ilex_ne_t>
 {
     constexpr static const char* description=ne_t::description;
     constexpr static const char* n_description=ne_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -293,6 +301,7 @@ struct ilex_lt_t : public op<ilex_lt_t>
 {
     constexpr static const char* description=lt_t::description;
     constexpr static const char* n_description=lt_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -313,6 +322,7 @@ struct ilex_lte_t : public op<ilex_lte_t>
 {
     constexpr static const char* description=lte_t::description;
     constexpr static const char* n_description=lte_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -333,6 +343,7 @@ struct ilex_gt_t : public op<ilex_gt_t>
 {
     constexpr static const char* description=gt_t::description;
     constexpr static const char* n_description=gt_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -353,6 +364,7 @@ struct ilex_gte_t : public op<ilex_gte_t>
 {
     constexpr static const char* description=gte_t::description;
     constexpr static const char* n_description=gte_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -373,6 +385,7 @@ struct lex_contains_t : public op<lex_contains_t>
 {
     constexpr static const char* description="must contain";
     constexpr static const char* n_description="must not contain";
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -393,6 +406,7 @@ struct ilex_contains_t : public op<ilex_contains_t>
 {
     constexpr static const char* description=lex_contains_t::description;
     constexpr static const char* n_description=lex_contains_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -413,6 +427,7 @@ struct lex_starts_with_t : public op<lex_starts_with_t>
 {
     constexpr static const char* description="must start with";
     constexpr static const char* n_description="must not start with";
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -433,6 +448,7 @@ struct ilex_starts_with_t : public op<ilex_starts_with_t>
 {
     constexpr static const char* description=lex_starts_with_t::description;
     constexpr static const char* n_description=lex_starts_with_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -453,6 +469,7 @@ struct lex_ends_with_t : public op<lex_ends_with_t>
 {
     constexpr static const char* description="must end with";
     constexpr static const char* n_description="must not end with";
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -473,6 +490,7 @@ struct ilex_ends_with_t : public op<ilex_ends_with_t>
 {
     constexpr static const char* description=lex_ends_with_t::description;
     constexpr static const char* n_description=lex_ends_with_t::n_description;
+    constexpr static const cost_class cost=cost_class::moderate;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -33,6 +33,8 @@ HATN_VALIDATOR_NAMESPACE_BEGIN
 struct op_report_without_operand_t : public adjust_storable_ignore
 {
     using hana_tag=operator_tag;
+
+    constexpr static const cost_class cost=cost_class::moderate;
 };
 
 /**
@@ -21,6 +21,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include <string>
 #include <hatn/validator/config.hpp>
+#include <hatn/validator/cost_class.hpp>
 #include <hatn/validator/utils/enable_to_string.hpp>
 #include <hatn/validator/utils/adjust_storable_type.hpp>
 
@@ -52,6 +53,11 @@ struct op : public enable_to_string<DerivedT>,
 {
     using hana_tag=operator_tag;
 
+    /**
+     * @brief Class of estimated cost of the operator, derived operators can override it.
+     */
+    constexpr static const cost_class cost=cost_class::cheap;
+
     /**
      * @brief Get description of the operator to be used in reports.
      * @return String description of the operator.
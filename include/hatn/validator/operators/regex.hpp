@@ -36,6 +36,7 @@ struct regex_match_t : public op<regex_match_t>
 {
     constexpr static const char* description="must match expression";
     constexpr static const char* n_description="must not match expression";
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -68,6 +69,7 @@ struct regex_nmatch_t : public op<regex_nmatch_t>
 {
     constexpr static const char* description=regex_match_t::n_description;
     constexpr static const char* n_description=regex_match_t::description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -88,6 +90,7 @@ struct regex_contains_t : public op<regex_contains_t>
 {
     constexpr static const char* description="must contain expression";
     constexpr static const char* n_description="must not contain expression";
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -120,6 +123,7 @@ struct regex_ncontains_t : public op<regex_ncontains_t>
 {
     constexpr static const char* description=regex_contains_t::n_description;
     constexpr static const char* n_description=regex_contains_t::description;
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     constexpr bool operator() (const T1& a, const T2& b) const
@@ -37,6 +37,7 @@ struct str_alpha_t : public op_report_without_operand<str_alpha_t>
 {
     constexpr static const char* description="must contain only letters and digits";
     constexpr static const char* n_description="must contain not only letters and digits";
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     bool operator() (const T1& a, const T2& b) const
@@ -58,6 +59,7 @@ struct str_hex_t : public op_report_without_operand<str_hex_t>
 {
     constexpr static const char* description="must be a hexadecimal number";
     constexpr static const char* n_description="must be not a hexadecimal number";
+    constexpr static const cost_class cost=cost_class::expensive;
 
     template <typename T1, typename T2>
     bool operator() (const T1& a, const T2& b) const
@@ -0,0 +1,410 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/prevalidation/apply_validated.hpp
+*
+*  Defines helpers for transactional setting of multiple members with pre-validation.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_APPLY_VALIDATED_HPP
+#define HATN_VALIDATOR_APPLY_VALIDATED_HPP
+
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/make_member.hpp>
+#include <hatn/validator/check_exists.hpp>
+#include <hatn/validator/check_member_path.hpp>
+#include <hatn/validator/get_member.hpp>
+#include <hatn/validator/operators/exists.hpp>
+#include <hatn/validator/utils/optional.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+#include <hatn/validator/prevalidation/set_validated.hpp>
+#include <hatn/validator/prevalidation/unset_validated.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace detail
+{
+
+/**
+ * @brief Check if member setter can set element in already resolved parent.
+ */
+template <typename SetterT, typename ParentT, typename MemberT, typename ValueT, typename =void>
+struct can_set_element : public std::false_type
+{
+};
+
+template <typename SetterT, typename ParentT, typename MemberT, typename ValueT>
+struct can_set_element<SetterT,ParentT,MemberT,ValueT,
+            decltype((void)SetterT::set_element(std::declval<ParentT&>(),std::declval<const MemberT&>(),std::declval<const ValueT&>()))
+        > : public std::true_type
+{
+};
+
+/**
+ * @brief Check if container supports erasing by key.
+ */
+template <typename ParentT, typename KeyT, typename =void>
+struct can_erase_element : public std::false_type
+{
+};
+
+template <typename ParentT, typename KeyT>
+struct can_erase_element<ParentT,KeyT,
+            decltype((void)std::declval<ParentT&>().erase(std::declval<const KeyT&>()))
+        > : public std::true_type
+{
+};
+
+/**
+ * @brief Erase element from container if container supports erasing by key.
+ */
+template <typename ParentT, typename KeyT, typename =void>
+struct erase_element_t
+{
+    void operator() (ParentT&, const KeyT&) const
+    {
+    }
+};
+
+template <typename ParentT, typename KeyT>
+struct erase_element_t<ParentT,KeyT,
+            decltype((void)std::declval<ParentT&>().erase(std::declval<const KeyT&>()))
+        >
+{
+    void operator() (ParentT& parent, const KeyT& key) const
+    {
+        parent.erase(key);
+    }
+};
+
+/**
+ * @brief Entry of transaction when member is set in resolved parent element.
+ */
+template <typename ObjectT, typename MemberT, typename ParentT, typename ValueT>
+struct resolved_update
+{
+    using parent_type=ParentT;
+
+    const MemberT* member;
+    ParentT* parent;
+    optional<ValueT> old_value;
+
+    template <typename NewValueT>
+    void commit(const NewValueT& val)
+    {
+        set_member_t<ObjectT,MemberT>::set_element(*parent,*member,val);
+    }
+
+    void rollback()
+    {
+        if (old_value)
+        {
+            set_member_t<ObjectT,MemberT>::set_element(*parent,*member,std::move(*old_value));
+        }
+        else
+        {
+            const auto& key=member->key();
+            erase_element_t<ParentT,std::decay_t<decltype(key)>>{}(*parent,key);
+        }
+    }
+};
+
+/**
+ * @brief Entry of transaction when member is set with custom setter.
+ */
+template <typename ObjectT, typename MemberT, typename ValueT>
+struct custom_update
+{
+    using parent_type=void;
+
+    ObjectT* obj;
+    const MemberT* member;
+    optional<ValueT> old_value;
+
+    template <typename NewValueT>
+    void commit(const NewValueT& val)
+    {
+        set_member(*obj,*member,val);
+    }
+
+    void rollback()
+    {
+        if (old_value)
+        {
+            set_member(*obj,*member,std::move(*old_value));
+        }
+        else
+        {
+            // member did not exist before transaction
+            using parent_type=std::decay_t<decltype(get_member(*obj,member->parent_path()))>;
+            using key_type=std::decay_t<decltype(member->key())>;
+            hana::eval_if(
+                can_erase_element<parent_type,key_type>{},
+                [&](auto&& _)
+                {
+                    unset_member(*_(obj),*member);
+                },
+                [](auto&&){}
+            );
+        }
+    }
+};
+
+/**
+ * @brief Find parent element resolved for one of previous updates.
+ */
+template <typename ParentT, typename MemberT, typename EntriesT>
+ParentT* find_resolved_parent(const MemberT& member, const EntriesT& entries)
+{
+    ParentT* parent=nullptr;
+    hana::for_each(
+        entries,
+        [&](const auto& entry)
+        {
+            hana::eval_if(
+                std::is_same<ParentT,typename std::decay_t<decltype(entry)>::parent_type>{},
+                [&](auto&& _)
+                {
+                    if (parent==nullptr && paths_equal(_(entry).member->parent_path(),member.parent_path()))
+                    {
+                        parent=_(entry).parent;
+                    }
+                },
+                [](auto&&){}
+            );
+        }
+    );
+    return parent;
+}
+
+/**
+ * @brief Make entry of transaction.
+ * @param obj Object.
+ * @param member Member to set.
+ * @param val New value.
+ * @param entries Entries made for previous updates.
+ * @return Entry of transaction.
+ */
+template <typename ObjectT, typename MemberT, typename ValueT, typename EntriesT>
+auto make_update_entry(ObjectT& obj, const MemberT& member, const ValueT&, const EntriesT& entries)
+{
+    using parent_ref=decltype(get_member(obj,member.parent_path()));
+    using parent_type=std::remove_reference_t<parent_ref>;
+    return hana::eval_if(
+        hana::and_(
+            std::is_lvalue_reference<parent_ref>{},
+            hana::bool_<can_set_element<set_member_t<ObjectT,MemberT>,parent_type,MemberT,ValueT>::value>{}
+        ),
+        [&](auto&& _)
+        {
+            using element_type=std::decay_t<decltype(std::declval<parent_type&>()[_(member).key()])>;
+            using entry_type=resolved_update<ObjectT,MemberT,parent_type,element_type>;
+
+            auto parent=find_resolved_parent<parent_type>(_(member),_(entries));
+            if (parent==nullptr)
+            {
+                auto parent_path=_(member).parent_path();
+                if (check_exists(_(obj),parent_path))
+                {
+                    parent=&get_member(_(obj),parent_path);
+                }
+            }
+
+            entry_type entry{&_(member),parent,optional<element_type>{}};
+            if (parent!=nullptr && check_contains(*parent,_(member).key()))
+            {
+                entry.old_value=get(*parent,_(member).key());
+            }
+            return entry;
+        },
+        [&](auto&& _)
+        {
+            auto path=member_path(_(member));
+            using element_type=std::decay_t<decltype(get_member(_(obj),path))>;
+            using entry_type=custom_update<ObjectT,MemberT,element_type>;
+
+            entry_type entry{&_(obj),&_(member),optional<element_type>{}};
+            if (check_exists(_(obj),path))
+            {
+                entry.old_value=get_member(_(obj),path);
+            }
+            return entry;
+        }
+    );
+}
+
+template <typename EntryT>
+bool update_parent_missing(const EntryT& entry, std::enable_if_t<!std::is_void<typename EntryT::parent_type>::value,void*> =nullptr)
+{
+    return entry.parent==nullptr;
+}
+
+template <typename EntryT>
+bool update_parent_missing(const EntryT&, std::enable_if_t<std::is_void<typename EntryT::parent_type>::value,void*> =nullptr)
+{
+    return false;
+}
+
+/**
+ * @brief Report that parent element of a member does not exist.
+ */
+template <typename ObjectT, typename MemberT>
+void report_missing_parent(const ObjectT& obj, const MemberT& member, error_report& err)
+{
+    auto parent_path=member.parent_path();
+    hana::eval_if(
+        hana::is_empty(parent_path),
+        [](auto&&){},
+        [&](auto&& _)
+        {
+            validate(_(obj),HATN_VALIDATOR_NAMESPACE::validator(make_member(_(parent_path))(exists,true)),err);
+        }
+    );
+}
+
+}
+
+/**
+ * @brief Set multiple members of object with pre-validation as a single transaction with validation result put in the last argument.
+ * @param obj Object whose members to set.
+ * @param updates Hana sequence of pairs of members and values to set.
+ * @param validator Validator to use for validation.
+ * @param err Validation result.
+ *
+ * First, all new values are pre-validated. Each value is pre-validated separately, i.e. the validator is applied once per update,
+ * pre-validation of all updates in a single traversal of the validator is not implemented.
+ * Then parent elements of the members are resolved, each parent element is resolved only once
+ * even if it is shared by multiple members. If some parent element does not exist then err will contain corresponding report.
+ * Parent elements are resolved before any member is set, so a parent element can not be created by one of previous updates
+ * of the same transaction, e.g. _["a"]["x"] can not be set in the same transaction that sets _["a"].
+ * Object is not modified if either pre-validation or resolving fails.
+ * After that the members are set in the order of updates. If setting of some member throws an exception,
+ * then that member and all members that were already set are restored in reverse order and exception is rethrown.
+ *
+ * Members are set with set_member_t. If set_member_t is specialized for some member then the specialization is used
+ * both for setting and restoring the member. A member that did not exist before the transaction is restored with unset_member_t
+ * if its parent element supports erase(), otherwise the member keeps the new value.
+ */
+template <typename ObjectT, typename UpdatesT, typename ValidatorT>
+void apply_validated(
+        ObjectT& obj,
+        UpdatesT&& updates,
+        ValidatorT&& validator,
+        error_report& err
+    )
+{
+    // pre-validate all new values
+    err.reset();
+    hana::for_each(
+        updates,
+        [&](const auto& update)
+        {
+            if (!err)
+            {
+                const auto& val=hana::second(update);
+                validate_value(unwrap_object(hana::first(update)),wrap_strict_any(val,validator),extract_strict_any(validator),err);
+            }
+        }
+    );
+    if (err)
+    {
+        return;
+    }
+
+    // resolve parent elements and remember old values
+    auto entries=hana::fold(
+        updates,
+        hana::make_tuple(),
+        [&obj](auto&& entries, const auto& update)
+        {
+            auto entry=detail::make_update_entry(obj,unwrap_object(hana::first(update)),hana::second(update),entries);
+            return hana::append(std::forward<decltype(entries)>(entries),std::move(entry));
+        }
+    );
+
+    bool missing=false;
+    hana::for_each(
+        hana::zip(entries,hana::to_tuple(updates)),
+        [&](const auto& pair)
+        {
+            if (!missing && detail::update_parent_missing(hana::front(pair)))
+            {
+                missing=true;
+                detail::report_missing_parent(obj,unwrap_object(hana::first(hana::back(pair))),err);
+            }
+        }
+    );
+    if (missing)
+    {
+        return;
+    }
+
+    // commit
+    size_t committed=0;
+    try
+    {
+        hana::for_each(
+            hana::zip(hana::to_tuple(hana::make_range(hana::size_c<0>,hana::size(entries))),hana::to_tuple(updates)),
+            [&](const auto& pair)
+            {
+                auto idx=hana::front(pair);
+                hana::at(entries,idx).commit(hana::second(hana::back(pair)));
+                ++committed;
+            }
+        );
+    }
+    catch (...)
+    {
+        // rollback in reverse order including the member whose setting failed,
+        // because the failed setter could have already inserted an element
+        hana::for_each(
+            hana::reverse(hana::to_tuple(hana::make_range(hana::size_c<0>,hana::size(entries)))),
+            [&](auto idx)
+            {
+                if (static_cast<size_t>(idx)<=committed)
+                {
+                    hana::at(entries,idx).rollback();
+                }
+            }
+        );
+        throw;
+    }
+}
+
+/**
+ * @brief Set multiple members of object with pre-validation as a single transaction with exception if validation fails.
+ * @param obj Object whose members to set.
+ * @param updates Hana sequence of pairs of members and values to set.
+ * @param validator Validator to use for validation.
+ *
+ * @throws validation_error if validation fails.
+ */
+template <typename ObjectT, typename UpdatesT, typename ValidatorT>
+void apply_validated(
+        ObjectT& obj,
+        UpdatesT&& updates,
+        ValidatorT&& validator
+    )
+{
+    error_report err;
+    apply_validated(obj,std::forward<UpdatesT>(updates),std::forward<ValidatorT>(validator),err);
+    if (err)
+    {
+        throw validation_error(err);
+    }
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_APPLY_VALIDATED_HPP
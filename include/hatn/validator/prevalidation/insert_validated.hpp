@@ -0,0 +1,149 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/prevalidation/insert_validated.hpp
+*
+*  Defines "insert_validated" helpers.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_INSERT_VALIDATED_HPP
+#define HATN_VALIDATOR_INSERT_VALIDATED_HPP
+
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+#include <hatn/validator/prevalidation/validate_new_element.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+/**
+ * @brief Default implementation of insert_member_t that uses insert() method of member's value.
+ */
+template <typename ObjectT, typename MemberT, typename Enable=void>
+struct insert_member_t
+{
+    template <typename ObjectT1, typename MemberT1, typename KeyT, typename ValueT>
+    void operator() (
+            ObjectT1& obj,
+            MemberT1&& member,
+            KeyT&& key,
+            ValueT&& val
+        ) const
+    {
+        auto path=member_path(member);
+        if (check_exists(obj,path))
+        {
+            auto& element=get_member(obj,path);
+            using value_type=typename std::decay_t<decltype(element)>::value_type;
+            element.insert(value_type(std::forward<KeyT>(key),std::forward<ValueT>(val)));
+        }
+    }
+};
+
+/**
+ * @brief Instantiation of inserter template.
+ */
+template <typename ObjectT, typename MemberT>
+constexpr insert_member_t<ObjectT,MemberT> insert_member_inst{};
+
+/**
+ * @brief Add element with given key to object's member.
+ * @param obj Object whose member to add element to.
+ * @param member Member name.
+ * @param key Key of new element.
+ * @param val Value of new element.
+ */
+template <typename ObjectT, typename MemberT, typename KeyT, typename ValueT>
+void insert_member(
+        ObjectT& obj,
+        MemberT&& member,
+        KeyT&& key,
+        ValueT&& val
+    )
+{
+    insert_member_inst<std::decay_t<ObjectT>,unwrap_object_t<MemberT>>(
+                obj,
+                unwrap_object(std::forward<MemberT>(member)),
+                std::forward<KeyT>(key),
+                std::forward<ValueT>(val)
+            );
+}
+
+/**
+ * @brief Add element with given key to object's member with pre-validation with validation result put in the last argument.
+ * @param obj Object whose member to add element to.
+ * @param member Member name.
+ * @param key Key of new element.
+ * @param val Value of new element.
+ * @param validator Validator to use for validation. If wrapped into strict_any then strict ANY validation will be invoked.
+ * @param err Validation result.
+ *
+ * If the member already contains element with the same key then neither validation is performed nor the member is modified.
+ *
+ * Only the new element is validated against rules of container's elements, e.g. [ALL], [ANY] or [ALL(keys)] members,
+ * and only the new size is validated against rules of "size" and "empty" properties.
+ * Thus, validation does not depend on the number of elements already in the container.
+ * If the member does not exist then err will contain corresponding report.
+ */
+template <typename ObjectT, typename MemberT, typename KeyT, typename ValueT, typename ValidatorT>
+void insert_validated(
+        ObjectT& obj,
+        MemberT&& member,
+        KeyT&& key,
+        ValueT&& val,
+        ValidatorT&& validator,
+        error_report& err
+    )
+{
+    err.reset();
+    const auto& m=unwrap_object(member);
+    if (detail::report_missing_container(obj,m,err) || container_member_contains(obj,m,key))
+    {
+        return;
+    }
+    validate_new_element(m,key,val,container_member_size(obj,m)+1,std::forward<ValidatorT>(validator),err);
+    if (!err)
+    {
+        insert_member(obj,m,std::forward<KeyT>(key),std::forward<ValueT>(val));
+    }
+}
+
+/**
+ * @brief Add element with given key to object's member with pre-validation with exception if validation fails.
+ * @param obj Object whose member to add element to.
+ * @param member Member name.
+ * @param key Key of new element.
+ * @param val Value of new element.
+ * @param validator Validator to use for validation. If wrapped into strict_any then strict ANY validation will be invoked.
+ *
+ * @throws validation_error if validation fails.
+ */
+template <typename ObjectT, typename MemberT, typename KeyT, typename ValueT, typename ValidatorT>
+void insert_validated(
+        ObjectT& obj,
+        MemberT&& member,
+        KeyT&& key,
+        ValueT&& val,
+        ValidatorT&& validator
+    )
+{
+    error_report err;
+    insert_validated(obj,std::forward<MemberT>(member),std::forward<KeyT>(key),std::forward<ValueT>(val),std::forward<ValidatorT>(validator),err);
+    if (err)
+    {
+        throw validation_error(err);
+    }
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_INSERT_VALIDATED_HPP
@@ -102,6 +102,51 @@ class prevalidation_adapter_impl : public strict_any_tag
             );
         }
 
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate_element(AdapterT&& adpt, const MemberT& member, PropT&& prop, OpT&& op, T2&& b) const
+        {
+            using key_type=std::decay_t<decltype(member.key())>;
+            return hana::eval_if(
+                std::is_base_of<element_aggregation_with_modifier<keys_t>,key_type>{},
+                [&](auto&& _)
+                {
+                    // aggregation of keys is validated with the last key of checked member
+                    const auto& obj=extract(traits_of(_(adpt)).get());
+                    return hana::eval_if(
+                        hana::is_a<range_tag,decltype(obj)>,
+                        [](auto&&)
+                        {
+                            return status(status::code::ignore);
+                        },
+                        [&](auto&& _)
+                        {
+                            return status(_(op)(property(_(this)->check_member().key(),_(prop)),extract(_(b))));
+                        }
+                    );
+                },
+                [&](auto&&)
+                {
+                    return hana::eval_if(
+                        std::is_base_of<element_aggregation_with_modifier<iterators_t>,key_type>{},
+                        [](auto&&)
+                        {
+                            return status(status::code::ignore);
+                        },
+                        [&](auto&& _)
+                        {
+                            return _(this)->validate_property(
+                                        std::forward<AdapterT>(adpt),
+                                        std::forward<PropT>(prop),
+                                        std::forward<OpT>(op),
+                                        std::forward<T2>(b),
+                                        _(member).key_is_any()
+                                    );
+                        }
+                    );
+                }
+            );
+        }
+
         template <typename AdapterT, typename T2, typename OpT, typename MemberT>
         status validate_exists(AdapterT&& adpt, MemberT&& member, OpT&&, T2&& b, bool from_check_member=false, bool skip_check=false) const
         {
@@ -212,6 +257,11 @@ class prevalidation_adapter_impl : public strict_any_tag
                         {
                             if (self->_member_checked)
                             {
+                                if (is_element_aggregation_of_keys_or_iterators(member.key()))
+                                {
+                                    // keys of elements are not known here
+                                    return status(status::code::ignore);
+                                }
                                 return self->validate_property(
                                             std::forward<decltype(adpt)>(adpt),
                                             std::forward<decltype(prop)>(prop),
@@ -232,12 +282,12 @@ class prevalidation_adapter_impl : public strict_any_tag
                                     {
                                         return status(status::code::ignore);
                                     }
-                                    return self->validate_property(
+                                    return self->validate_element(
                                                 std::forward<decltype(adpt)>(adpt),
+                                                member,
                                                 std::forward<decltype(prop)>(prop),
                                                 std::forward<decltype(op)>(op),
-                                                std::forward<decltype(b)>(b),
-                                                member.key_is_any()
+                                                std::forward<decltype(b)>(b)
                                             );
                                 },
                                 [](auto&&)
@@ -403,6 +453,14 @@ class prevalidation_adapter_impl : public strict_any_tag
 
     private:
 
+        template <typename KeyT>
+        constexpr static bool is_element_aggregation_of_keys_or_iterators(const KeyT&) noexcept
+        {
+            return std::is_base_of<element_aggregation_with_modifier<keys_t>,KeyT>::value
+                    ||
+                   std::is_base_of<element_aggregation_with_modifier<iterators_t>,KeyT>::value;
+        }
+
         template <typename MemberT>
         bool filter_member(const MemberT& member) const noexcept
         {
@@ -0,0 +1,139 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/prevalidation/push_back_validated.hpp
+*
+*  Defines "push_back_validated" helpers.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_PUSH_BACK_VALIDATED_HPP
+#define HATN_VALIDATOR_PUSH_BACK_VALIDATED_HPP
+
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+#include <hatn/validator/prevalidation/validate_new_element.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+/**
+ * @brief Default implementation of push_back_member_t that uses push_back() method of member's value.
+ */
+template <typename ObjectT, typename MemberT, typename Enable=void>
+struct push_back_member_t
+{
+    template <typename ObjectT1, typename MemberT1, typename ValueT>
+    void operator() (
+            ObjectT1& obj,
+            MemberT1&& member,
+            ValueT&& val
+        ) const
+    {
+        auto path=member_path(member);
+        if (check_exists(obj,path))
+        {
+            auto& element=get_member(obj,path);
+            element.push_back(std::forward<ValueT>(val));
+        }
+    }
+};
+
+/**
+ * @brief Instantiation of appender template.
+ */
+template <typename ObjectT, typename MemberT>
+constexpr push_back_member_t<ObjectT,MemberT> push_back_member_inst{};
+
+/**
+ * @brief Append element to object's member.
+ * @param obj Object whose member to append to.
+ * @param member Member name.
+ * @param val Value to append.
+ */
+template <typename ObjectT, typename MemberT, typename ValueT>
+void push_back_member(
+        ObjectT& obj,
+        MemberT&& member,
+        ValueT&& val
+    )
+{
+    push_back_member_inst<std::decay_t<ObjectT>,unwrap_object_t<MemberT>>(
+                obj,
+                unwrap_object(std::forward<MemberT>(member)),
+                std::forward<ValueT>(val)
+            );
+}
+
+/**
+ * @brief Append element to object's member with pre-validation with validation result put in the last argument.
+ * @param obj Object whose member to append to.
+ * @param member Member name.
+ * @param val Value to append.
+ * @param validator Validator to use for validation. If wrapped into strict_any then strict ANY validation will be invoked.
+ * @param err Validation result.
+ *
+ * Only the new element is validated against rules of container's elements, e.g. [ALL] or [ANY] members,
+ * and only the new size is validated against rules of "size" and "empty" properties.
+ * Thus, validation does not depend on the number of elements already in the container.
+ * If the member does not exist then err will contain corresponding report.
+ */
+template <typename ObjectT, typename MemberT, typename ValueT, typename ValidatorT>
+void push_back_validated(
+        ObjectT& obj,
+        MemberT&& member,
+        ValueT&& val,
+        ValidatorT&& validator,
+        error_report& err
+    )
+{
+    err.reset();
+    const auto& m=unwrap_object(member);
+    if (detail::report_missing_container(obj,m,err))
+    {
+        return;
+    }
+    auto current_size=container_member_size(obj,m);
+    validate_new_element(m,current_size,val,current_size+1,std::forward<ValidatorT>(validator),err);
+    if (!err)
+    {
+        push_back_member(obj,m,std::forward<ValueT>(val));
+    }
+}
+
+/**
+ * @brief Append element to object's member with pre-validation with exception if validation fails.
+ * @param obj Object whose member to append to.
+ * @param member Member name.
+ * @param val Value to append.
+ * @param validator Validator to use for validation. If wrapped into strict_any then strict ANY validation will be invoked.
+ *
+ * @throws validation_error if validation fails.
+ */
+template <typename ObjectT, typename MemberT, typename ValueT, typename ValidatorT>
+void push_back_validated(
+        ObjectT& obj,
+        MemberT&& member,
+        ValueT&& val,
+        ValidatorT&& validator
+    )
+{
+    error_report err;
+    push_back_validated(obj,std::forward<MemberT>(member),std::forward<ValueT>(val),std::forward<ValidatorT>(validator),err);
+    if (err)
+    {
+        throw validation_error(err);
+    }
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_PUSH_BACK_VALIDATED_HPP
@@ -44,10 +44,25 @@ struct set_member_t
         auto parent_path=member.parent_path();
         if (check_exists(obj,parent_path))
         {
-            auto& parent_element=get_member(obj,parent_path);
-            parent_element[member.key()]=unadjust_view_type<decltype(parent_element[member.key()])>(std::forward<ValueT>(val));
+            set_element(get_member(obj,parent_path),member,std::forward<ValueT>(val));
         }
     }
+
+    /**
+     * @brief Set element in parent element of the member.
+     * @param parent_element Parent element.
+     * @param member Member.
+     * @param val Value to set.
+     */
+    template <typename ParentT, typename MemberT1, typename ValueT>
+    static auto set_element(
+            ParentT& parent_element,
+            const MemberT1& member,
+            ValueT&& val
+        ) -> decltype((void)(parent_element[member.key()]=unadjust_view_type<decltype(parent_element[member.key()])>(std::forward<ValueT>(val))))
+    {
+        parent_element[member.key()]=unadjust_view_type<decltype(parent_element[member.key()])>(std::forward<ValueT>(val));
+    }
 };
 
 /**
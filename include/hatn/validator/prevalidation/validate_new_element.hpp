@@ -0,0 +1,135 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/prevalidation/validate_new_element.hpp
+*
+*  Defines helpers for validation of element to be added to a container.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_VALIDATE_NEW_ELEMENT_HPP
+#define HATN_VALIDATOR_VALIDATE_NEW_ELEMENT_HPP
+
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/check_exists.hpp>
+#include <hatn/validator/check_contains.hpp>
+#include <hatn/validator/get_member.hpp>
+#include <hatn/validator/make_member.hpp>
+#include <hatn/validator/operators/exists.hpp>
+#include <hatn/validator/properties/size.hpp>
+#include <hatn/validator/properties/empty.hpp>
+#include <hatn/validator/prevalidation/validate_value.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+/**
+ * @brief Get current size of container member.
+ * @param obj Object.
+ * @param member Member of container type.
+ * @return Size of container or 0 if member does not exist.
+ */
+template <typename ObjectT, typename MemberT>
+size_t container_member_size(
+        const ObjectT& obj,
+        const MemberT& member
+    )
+{
+    auto path=member_path(member);
+    if (check_exists(obj,path))
+    {
+        return get_member(obj,path).size();
+    }
+    return 0;
+}
+
+/**
+ * @brief Check if container member contains element with given key.
+ * @param obj Object.
+ * @param member Member of container type.
+ * @param key Key of the element.
+ * @return True if container contains the element.
+ */
+template <typename ObjectT, typename MemberT, typename KeyT>
+bool container_member_contains(
+        const ObjectT& obj,
+        const MemberT& member,
+        const KeyT& key
+    )
+{
+    auto path=member_path(member);
+    if (check_exists(obj,path))
+    {
+        return check_contains(get_member(obj,path),key);
+    }
+    return false;
+}
+
+namespace detail
+{
+
+/**
+ * @brief Report that container member does not exist.
+ * @param obj Object.
+ * @param member Member of container type.
+ * @param err Validation result.
+ * @return True if container member does not exist, in that case err contains corresponding report.
+ */
+template <typename ObjectT, typename MemberT>
+bool report_missing_container(const ObjectT& obj, const MemberT& member, error_report& err)
+{
+    auto path=member_path(member);
+    if (check_exists(obj,path))
+    {
+        return false;
+    }
+    validate(obj,HATN_VALIDATOR_NAMESPACE::validator(make_member(path)(exists,true)),err);
+    return true;
+}
+
+}
+
+/**
+ * @brief Validate element to be added to container.
+ * @param member Member of container type.
+ * @param key Key the new element will have in the container.
+ * @param val Value of the new element.
+ * @param new_size Size of container after adding the element.
+ * @param validator Validator to use for validation. If wrapped into strict_any then strict ANY validation will be invoked.
+ * @param err Validation result.
+ *
+ * Only rules of container's size and emptiness and rules of container's elements are checked,
+ * i.e. the rest elements of the container are not validated again.
+ */
+template <typename MemberT, typename KeyT, typename ValueT, typename ValidatorT>
+void validate_new_element(
+        const MemberT& member,
+        KeyT&& key,
+        ValueT&& val,
+        size_t new_size,
+        ValidatorT&& validator,
+        error_report& err
+    )
+{
+    validate(member[size],wrap_strict_any(new_size,validator),extract_strict_any(validator),err);
+    if (!err)
+    {
+        validate(member[empty],wrap_strict_any(false,validator),extract_strict_any(validator),err);
+        if (!err)
+        {
+            validate_value(member[std::forward<KeyT>(key)],std::forward<ValueT>(val),std::forward<ValidatorT>(validator),err);
+        }
+    }
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_VALIDATE_NEW_ELEMENT_HPP
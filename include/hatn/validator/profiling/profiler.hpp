@@ -0,0 +1,533 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/profiling/profiler.hpp
+*
+*  Defines profiler collecting counters and timings of validation rules.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_PROFILER_HPP
+#define HATN_VALIDATOR_PROFILER_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Kinds of profiled nodes of validator.
+ */
+enum class profiling_node_kind : uint8_t
+{
+    check_operator, //!< Operator applied to the whole object.
+    check_property, //!< Operator applied to property of the whole object.
+    check_exists, //!< Check of member existence.
+    check_member, //!< Operator applied to property of a member.
+    check_other_member, //!< Operator applied to properties of two members.
+    check_master_sample, //!< Operator applied to properties of member and of sample object.
+    aggregation_and, //!< AND aggregation.
+    aggregation_or, //!< OR aggregation.
+    aggregation_not //!< NOT aggregation.
+};
+
+/**
+ * @brief Get name of kind of profiled node.
+ * @param kind Kind of node.
+ * @return Name.
+ */
+inline const char* profiling_node_kind_name(profiling_node_kind kind) noexcept
+{
+    switch (kind)
+    {
+        case profiling_node_kind::check_operator: return "operator";
+        case profiling_node_kind::check_property: return "property";
+        case profiling_node_kind::check_exists: return "exists";
+        case profiling_node_kind::check_member: return "member";
+        case profiling_node_kind::check_other_member: return "other_member";
+        case profiling_node_kind::check_master_sample: return "master_sample";
+        case profiling_node_kind::aggregation_and: return "and";
+        case profiling_node_kind::aggregation_or: return "or";
+        case profiling_node_kind::aggregation_not: return "not";
+    }
+    return "unknown";
+}
+
+/**
+ * @brief Counters of profiled node.
+ */
+struct profiling_entry
+{
+    profiling_node_kind kind;
+    uint64_t node=0; //!< Identifier of node, i.e. address of the node within validator.
+    std::string label; //!< Description of the rule, used only for display.
+    uint64_t evaluations=0;
+    uint64_t failures=0;
+    uint64_t ignores=0;
+    uint64_t nanoseconds=0; //!< Cumulative time including time of nested nodes.
+};
+
+/**
+ * @brief Snapshot of profiling counters.
+ *
+ * Nodes are identified by kind and node identifier, so identical rules in different places of a validator are reported separately.
+ * Snapshots of different threads or profilers of the same validator can be merged.
+ */
+class profiling_report
+{
+    public:
+
+        /**
+         * @brief Add counters of node.
+         * @param entry Counters to add.
+         */
+        void add(const profiling_entry& entry)
+        {
+            auto it=_index.find(std::make_pair(entry.node,entry.kind));
+            if (it==_index.end())
+            {
+                _index.emplace(std::make_pair(entry.node,entry.kind),_entries.size());
+                _entries.push_back(entry);
+                return;
+            }
+            auto& dst=_entries[it->second];
+            dst.evaluations+=entry.evaluations;
+            dst.failures+=entry.failures;
+            dst.ignores+=entry.ignores;
+            dst.nanoseconds+=entry.nanoseconds;
+        }
+
+        /**
+         * @brief Merge other report into this report.
+         * @param other Other report.
+         */
+        void merge(const profiling_report& other)
+        {
+            for (auto&& entry:other._entries)
+            {
+                add(entry);
+            }
+            _dropped+=other._dropped;
+        }
+
+        /**
+         * @brief Get counters of nodes sorted by cumulative time in descending order.
+         * @return Counters of nodes.
+         */
+        std::vector<profiling_entry> entries() const
+        {
+            auto result=_entries;
+            std::stable_sort(result.begin(),result.end(),
+                [](const profiling_entry& l, const profiling_entry& r)
+                {
+                    return std::make_tuple(r.nanoseconds,r.evaluations) < std::make_tuple(l.nanoseconds,l.evaluations);
+                }
+            );
+            return result;
+        }
+
+        /**
+         * @brief Find counters of node.
+         * @param node Identifier of node.
+         * @param kind Kind of node.
+         * @return Pointer to counters or nullptr if not found.
+         */
+        const profiling_entry* find(uint64_t node, profiling_node_kind kind) const
+        {
+            auto it=_index.find(std::make_pair(node,kind));
+            if (it==_index.end())
+            {
+                return nullptr;
+            }
+            return &_entries[it->second];
+        }
+
+        /**
+         * @brief Find counters of node by label.
+         * @param kind Kind of node.
+         * @param label Label of node.
+         * @return Pointer to counters of the first added node with the label or nullptr if not found.
+         */
+        const profiling_entry* find(profiling_node_kind kind, const std::string& label) const
+        {
+            for (auto&& entry:_entries)
+            {
+                if (entry.kind==kind && entry.label==label)
+                {
+                    return &entry;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Find counters of all nodes with label.
+         * @param kind Kind of node.
+         * @param label Label of node.
+         * @return Counters of nodes in order of adding.
+         */
+        std::vector<profiling_entry> find_all(profiling_node_kind kind, const std::string& label) const
+        {
+            std::vector<profiling_entry> result;
+            for (auto&& entry:_entries)
+            {
+                if (entry.kind==kind && entry.label==label)
+                {
+                    result.push_back(entry);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get number of events that were dropped because profiler capacity was exceeded.
+         */
+        uint64_t dropped() const noexcept
+        {
+            return _dropped;
+        }
+
+        void add_dropped(uint64_t count) noexcept
+        {
+            _dropped+=count;
+        }
+
+        /**
+         * @brief Format report as plain text table.
+         * @return Text table.
+         */
+        std::string to_text() const
+        {
+            std::ostringstream os;
+            os<<"time_ns\tevaluations\tfailures\tignores\tkind\tnode\trule\n";
+            for (auto&& entry:entries())
+            {
+                os<<entry.nanoseconds<<'\t'<<entry.evaluations<<'\t'<<entry.failures<<'\t'<<entry.ignores
+                  <<'\t'<<profiling_node_kind_name(entry.kind)<<'\t'<<node_name(entry.node)<<'\t'<<entry.label<<'\n';
+            }
+            if (_dropped!=0)
+            {
+                os<<"dropped\t"<<_dropped<<'\n';
+            }
+            return os.str();
+        }
+
+        /**
+         * @brief Format report in Prometheus text exposition format.
+         * @param prefix Prefix of metric names.
+         * @return Metrics.
+         */
+        std::string to_prometheus(const std::string& prefix="hatn_validator") const
+        {
+            std::ostringstream os;
+            auto sorted=entries();
+            auto metric=[&](const char* name, const char* help, const std::function<void(const profiling_entry&)>& value)
+            {
+                os<<"# HELP "<<prefix<<"_"<<name<<" "<<help<<"\n";
+                os<<"# TYPE "<<prefix<<"_"<<name<<" counter\n";
+                for (auto&& entry:sorted)
+                {
+                    os<<prefix<<"_"<<name<<"{kind=\""<<profiling_node_kind_name(entry.kind)<<"\",node=\""<<node_name(entry.node)
+                      <<"\",rule=\""<<escape(entry.label)<<"\"} ";
+                    value(entry);
+                    os<<"\n";
+                }
+            };
+            metric("evaluations_total","Number of evaluations of validation rule.",[&](const profiling_entry& e){os<<e.evaluations;});
+            metric("failures_total","Number of failed evaluations of validation rule.",[&](const profiling_entry& e){os<<e.failures;});
+            metric("ignores_total","Number of ignored evaluations of validation rule.",[&](const profiling_entry& e){os<<e.ignores;});
+            metric("seconds_total","Cumulative time of evaluations of validation rule.",[&](const profiling_entry& e){os<<static_cast<double>(e.nanoseconds)/1e9;});
+            os<<"# HELP "<<prefix<<"_dropped_total Number of profiling events dropped because capacity was exceeded.\n";
+            os<<"# TYPE "<<prefix<<"_dropped_total counter\n";
+            os<<prefix<<"_dropped_total "<<_dropped<<"\n";
+            return os.str();
+        }
+
+        /**
+         * @brief Write report as plain text table to file.
+         * @param path Path to file.
+         * @return True if file was written.
+         */
+        bool write_text(const std::string& path) const
+        {
+            return write(path,to_text());
+        }
+
+        /**
+         * @brief Write report in Prometheus text exposition format to file.
+         * @param path Path to file.
+         * @param prefix Prefix of metric names.
+         * @return True if file was written.
+         */
+        bool write_prometheus(const std::string& path, const std::string& prefix="hatn_validator") const
+        {
+            return write(path,to_prometheus(prefix));
+        }
+
+    private:
+
+        static std::string node_name(uint64_t node)
+        {
+            std::ostringstream os;
+            os<<std::hex<<node;
+            return os.str();
+        }
+
+        static std::string escape(const std::string& str)
+        {
+            std::string result;
+            result.reserve(str.size());
+            for (auto c:str)
+            {
+                switch (c)
+                {
+                    case '\\': result+="\\\\"; break;
+                    case '"': result+="\\\""; break;
+                    case '\n': result+="\\n"; break;
+                    default: result.push_back(c); break;
+                }
+            }
+            return result;
+        }
+
+        static bool write(const std::string& path, const std::string& content)
+        {
+            std::ofstream f(path,std::ios::binary|std::ios::trunc);
+            if (!f)
+            {
+                return false;
+            }
+            f<<content;
+            return static_cast<bool>(f);
+        }
+
+        std::vector<profiling_entry> _entries;
+        std::map<std::pair<uint64_t,profiling_node_kind>,size_t> _index;
+        uint64_t _dropped=0;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Counters of one thread.
+ *
+ * Counters are kept in preallocated open addressing table. Only the owning thread writes to the table,
+ * other threads can read it concurrently, so updates are lock-free and use only relaxed atomic loads and stores.
+ */
+class profiling_counters
+{
+    public:
+
+        explicit profiling_counters(size_t capacity)
+            : _nodes(capacity==0?1:capacity),
+              _dropped(0)
+        {}
+
+        /**
+         * @brief Record evaluation of node.
+         * @param id Address identifying the node within validator.
+         * @param kind Kind of node.
+         * @param result Validation status.
+         * @param nanoseconds Duration of evaluation.
+         * @param make_label Callable returning label of node, invoked only once for each node.
+         */
+        template <typename MakeLabelT>
+        void record(const void* id, profiling_node_kind kind, const status& result, uint64_t nanoseconds, MakeLabelT&& make_label)
+        {
+            auto node=find_or_insert(id,kind,make_label);
+            if (node==nullptr)
+            {
+                increment(_dropped,1);
+                return;
+            }
+            increment(node->evaluations,1);
+            if (result.value()==status::code::fail)
+            {
+                increment(node->failures,1);
+            }
+            else if (result.value()==status::code::ignore)
+            {
+                increment(node->ignores,1);
+            }
+            increment(node->nanoseconds,nanoseconds);
+        }
+
+        /**
+         * @brief Add counters to report.
+         * @param report Report.
+         */
+        void collect(profiling_report& report) const
+        {
+            for (auto&& node:_nodes)
+            {
+                if (node.id.load(std::memory_order_acquire)==nullptr)
+                {
+                    continue;
+                }
+                profiling_entry entry;
+                entry.kind=node.kind;
+                entry.node=static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node.id.load(std::memory_order_relaxed)));
+                entry.label=node.label;
+                entry.evaluations=node.evaluations.load(std::memory_order_relaxed);
+                entry.failures=node.failures.load(std::memory_order_relaxed);
+                entry.ignores=node.ignores.load(std::memory_order_relaxed);
+                entry.nanoseconds=node.nanoseconds.load(std::memory_order_relaxed);
+                report.add(entry);
+            }
+            report.add_dropped(_dropped.load(std::memory_order_relaxed));
+        }
+
+    private:
+
+        struct node_t
+        {
+            std::atomic<const void*> id{nullptr};
+            profiling_node_kind kind=profiling_node_kind::check_operator;
+            std::string label;
+            std::atomic<uint64_t> evaluations{0};
+            std::atomic<uint64_t> failures{0};
+            std::atomic<uint64_t> ignores{0};
+            std::atomic<uint64_t> nanoseconds{0};
+        };
+
+        static void increment(std::atomic<uint64_t>& counter, uint64_t value) noexcept
+        {
+            // only the owning thread writes, so read-modify-write is not needed
+            counter.store(counter.load(std::memory_order_relaxed)+value,std::memory_order_relaxed);
+        }
+
+        template <typename MakeLabelT>
+        node_t* find_or_insert(const void* id, profiling_node_kind kind, MakeLabelT& make_label)
+        {
+            auto h=std::hash<const void*>()(id)^(static_cast<size_t>(kind)*0x9e3779b97f4a7c15ull);
+            auto size=_nodes.size();
+            for (size_t i=0;i<size;i++)
+            {
+                auto& node=_nodes[(h+i)%size];
+                auto node_id=node.id.load(std::memory_order_relaxed);
+                if (node_id==nullptr)
+                {
+                    node.kind=kind;
+                    node.label=make_label();
+                    node.id.store(id,std::memory_order_release);
+                    return &node;
+                }
+                if (node_id==id && node.kind==kind)
+                {
+                    return &node;
+                }
+            }
+            return nullptr;
+        }
+
+        std::vector<node_t> _nodes;
+        std::atomic<uint64_t> _dropped;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Profiler of validation rules.
+ *
+ * Profiler keeps separate counters for each thread that uses it. Counters of all threads can be merged into
+ * a report at any time without stopping validation.
+ */
+class profiler
+{
+    public:
+
+        constexpr static const size_t default_capacity=1024;
+
+        /**
+         * @brief Constructor.
+         * @param capacity Maximum number of profiled nodes per thread.
+         */
+        explicit profiler(size_t capacity=default_capacity)
+            : _id(next_id()),
+              _capacity(capacity)
+        {}
+
+        profiler(const profiler&)=delete;
+        profiler& operator=(const profiler&)=delete;
+
+        /**
+         * @brief Get counters of current thread.
+         * @return Counters.
+         */
+        profiling_counters& local()
+        {
+            thread_local std::unordered_map<uint64_t,profiling_counters*> counters;
+            auto it=counters.find(_id);
+            if (it!=counters.end())
+            {
+                return *it->second;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            _threads.push_back(std::make_unique<profiling_counters>(_capacity));
+            auto ptr=_threads.back().get();
+            counters.emplace(_id,ptr);
+            return *ptr;
+        }
+
+        /**
+         * @brief Merge counters of all threads into report.
+         * @return Report.
+         */
+        profiling_report report() const
+        {
+            profiling_report result;
+            std::lock_guard<std::mutex> lock(_mutex);
+            for (auto&& counters:_threads)
+            {
+                counters->collect(result);
+            }
+            return result;
+        }
+
+    private:
+
+        static uint64_t next_id() noexcept
+        {
+            static std::atomic<uint64_t> id{0};
+            return ++id;
+        }
+
+        uint64_t _id;
+        size_t _capacity;
+
+        mutable std::mutex _mutex;
+        std::vector<std::unique_ptr<profiling_counters>> _threads;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_PROFILER_HPP
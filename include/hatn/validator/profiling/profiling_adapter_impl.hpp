@@ -0,0 +1,253 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/profiling/profiling_adapter_impl.hpp
+*
+*  Defines implementation of profiling adapter.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_PROFILING_ADAPTER_IMPL_HPP
+#define HATN_VALIDATOR_PROFILING_ADAPTER_IMPL_HPP
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/adapters/impl/default_adapter_impl.hpp>
+#include <hatn/validator/reporting/reporter.hpp>
+#include <hatn/validator/utils/has_reset.hpp>
+#include <hatn/validator/profiling/profiler.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+struct profiling_adapter_tag{};
+
+/**
+ * @brief Implementation of profiling adapter.
+ *
+ * Each call is forwarded to the next adapter implementation and its result and duration are recorded in counters of the current thread.
+ * Nodes of validator are identified by addresses of their operands, thus the validator must not be moved while the profiler is in use.
+ */
+template <typename NextAdapterImplT>
+class profiling_adapter_impl : public profiling_adapter_tag
+{
+    public:
+
+        using base_tag=profiling_adapter_tag;
+
+        template <typename ...Args>
+        profiling_adapter_impl(
+            profiler& prof,
+            Args&&... args
+        ) : _counters(&prof.local()),
+            _next_adapter_impl(std::forward<Args>(args)...)
+        {}
+
+        const auto& next_adapter_impl() const
+        {
+            return _next_adapter_impl;
+        }
+
+        auto& next_adapter_impl()
+        {
+            return _next_adapter_impl;
+        }
+
+        void reset()
+        {
+            auto self=this;
+            hana::eval_if(
+                has_reset(hana::template type_c<NextAdapterImplT>),
+                [&](auto _)
+                {
+                    _(self)->_next_adapter_impl.reset();
+                },
+                [](auto)
+                {}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT>
+        status validate_operator(AdapterT&& adpt, OpT&& op, T2&& b)
+        {
+            return measure(std::addressof(b),profiling_node_kind::check_operator,
+                [&](){return _next_adapter_impl.validate_operator(adpt,op,b);},
+                [&](auto& r){r.validate_operator(op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT>
+        status validate_property(AdapterT&& adpt, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return measure(std::addressof(b),profiling_node_kind::check_property,
+                [&](){return _next_adapter_impl.validate_property(adpt,prop,op,b);},
+                [&](auto& r){r.validate_property(prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename MemberT>
+        status validate_exists(AdapterT&& adpt, MemberT&& member, OpT&& op, T2&& b, bool from_check_member=false, bool already_failed=false)
+        {
+            if (from_check_member)
+            {
+                // implicit check of member existence is a part of checking the member
+                return _next_adapter_impl.validate_exists(adpt,member,op,b,from_check_member,already_failed);
+            }
+            return measure(std::addressof(b),profiling_node_kind::check_exists,
+                [&](){return _next_adapter_impl.validate_exists(adpt,member,op,b,from_check_member,already_failed);},
+                [&](auto& r){r.validate_exists(member,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return measure(std::addressof(b),profiling_node_kind::check_member,
+                [&](){return _next_adapter_impl.validate(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate(member,prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate_with_other_member(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return measure(std::addressof(b),profiling_node_kind::check_other_member,
+                [&](){return _next_adapter_impl.validate_with_other_member(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate_with_other_member(member,prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate_with_master_sample(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return measure(std::addressof(b),profiling_node_kind::check_master_sample,
+                [&](){return _next_adapter_impl.validate_with_master_sample(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate_with_master_sample(member,prop,op,member,b);}
+            );
+        }
+
+        template <typename AdapterT, typename OpsT>
+        status validate_and(AdapterT&& adpt, OpsT&& ops)
+        {
+            return measure_aggregation(std::addressof(ops),profiling_node_kind::aggregation_and,"AND",
+                [&](){return _next_adapter_impl.validate_and(std::forward<AdapterT>(adpt),std::forward<OpsT>(ops));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpsT>
+        status validate_and(AdapterT&& adpt, MemberT&& member, OpsT&& ops)
+        {
+            return measure_aggregation(std::addressof(ops),profiling_node_kind::aggregation_and,"AND",
+                [&](){return _next_adapter_impl.validate_and(std::forward<AdapterT>(adpt),member,std::forward<OpsT>(ops));},
+                member
+            );
+        }
+
+        template <typename AdapterT, typename OpsT>
+        status validate_or(AdapterT&& adpt, OpsT&& ops)
+        {
+            return measure_aggregation(std::addressof(ops),profiling_node_kind::aggregation_or,"OR",
+                [&](){return _next_adapter_impl.validate_or(std::forward<AdapterT>(adpt),std::forward<OpsT>(ops));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpsT>
+        status validate_or(AdapterT&& adpt, MemberT&& member, OpsT&& ops)
+        {
+            return measure_aggregation(std::addressof(ops),profiling_node_kind::aggregation_or,"OR",
+                [&](){return _next_adapter_impl.validate_or(std::forward<AdapterT>(adpt),member,std::forward<OpsT>(ops));},
+                member
+            );
+        }
+
+        template <typename AdapterT, typename OpT>
+        status validate_not(AdapterT&& adpt, OpT&& op)
+        {
+            return measure_aggregation(std::addressof(op),profiling_node_kind::aggregation_not,"NOT",
+                [&](){return _next_adapter_impl.validate_not(std::forward<AdapterT>(adpt),std::forward<OpT>(op));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpT>
+        status validate_not(AdapterT&& adpt, MemberT&& member, OpT&& op)
+        {
+            return measure_aggregation(std::addressof(op),profiling_node_kind::aggregation_not,"NOT",
+                [&](){return _next_adapter_impl.validate_not(std::forward<AdapterT>(adpt),member,std::forward<OpT>(op));},
+                member
+            );
+        }
+
+        profiling_counters& counters() noexcept
+        {
+            return *_counters;
+        }
+
+    private:
+
+        template <typename HandlerT, typename ReportT>
+        status measure(const void* id, profiling_node_kind kind, HandlerT&& handler, ReportT&& report)
+        {
+            auto start=std::chrono::steady_clock::now();
+            auto st=status(handler());
+            auto duration=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start);
+            _counters->record(id,kind,st,static_cast<uint64_t>(duration.count()),
+                [&]()
+                {
+                    std::string label;
+                    auto r=make_reporter(label);
+                    report(r);
+                    return label;
+                }
+            );
+            return st;
+        }
+
+        template <typename HandlerT, typename ...Args>
+        status measure_aggregation(const void* id, profiling_node_kind kind, const char* name, HandlerT&& handler, Args&&... member)
+        {
+            auto start=std::chrono::steady_clock::now();
+            auto st=status(handler());
+            auto duration=std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-start);
+            _counters->record(id,kind,st,static_cast<uint64_t>(duration.count()),
+                [&]()
+                {
+                    return aggregation_label(name,member...);
+                }
+            );
+            return st;
+        }
+
+        static std::string aggregation_label(const char* name)
+        {
+            return name;
+        }
+
+        template <typename MemberT>
+        static std::string aggregation_label(const char* name, const MemberT& member)
+        {
+            return std::string(name)+" of "+get_default_formatter().member_to_string(member);
+        }
+
+        profiling_counters* _counters;
+        NextAdapterImplT _next_adapter_impl;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_PROFILING_ADAPTER_IMPL_HPP
@@ -35,6 +35,52 @@ HATN_VALIDATOR_NAMESPACE_BEGIN
 struct type_p_value;
 struct property_validator_tag;
 
+/**
+ * @brief Handler of property validator that dispatches validation of a property using operator and operand.
+ *
+ * Handler keeps property, operator and operand accessible so that they can be inspected by
+ * optimized validation paths, e.g. by vectorized element aggregations.
+ */
+template <typename PropT, typename OpT, typename OperandT>
+struct property_validator_handler
+{
+    using property_type=PropT;
+    using operator_type=OpT;
+    using operand_type=OperandT;
+
+    /**
+     * @brief Dispatch validation appending property, operator and operand to the arguments.
+     * @param args Validation arguments, i.e. adapter and optionally member.
+     * @return Validation status.
+     */
+    template <typename ... Args>
+    auto operator () (Args&&... args) const -> decltype(auto)
+    {
+        return dispatch(std::forward<Args>(args)...,prop,op,operand);
+    }
+
+    PropT prop;
+    OpT op;
+    OperandT operand;
+};
+
+/**
+ * @brief Make handler of property validator.
+ * @param prop Property.
+ * @param op Operator.
+ * @param operand Operand adjusted for storage.
+ * @return Handler of property validator.
+ */
+template <typename PropT, typename OpT, typename OperandT>
+auto make_property_validator_handler(PropT&& prop, OpT&& op, OperandT&& operand)
+{
+    return property_validator_handler<std::decay_t<PropT>,std::decay_t<OpT>,std::decay_t<OperandT>>{
+                std::forward<PropT>(prop),
+                std::forward<OpT>(op),
+                std::forward<OperandT>(operand)
+            };
+}
+
 /**
  * @brief Property validator functor.
  */
@@ -67,8 +113,8 @@ constexpr auto make_property_validator(PropT&& prop, OpT&& op, OperandT&& operan
 
                 auto op1=copy(op);
                 auto operand1=copy(operand);
-                auto fn=hana::reverse_partial(dispatch,std::forward<decltype(prop)>(prop),std::forward<decltype(op)>(op),
-                                              adjust_storable(std::forward<decltype(operand)>(operand)));
+                auto fn=make_property_validator_handler(std::forward<decltype(prop)>(prop),std::forward<decltype(op)>(op),
+                                                       adjust_storable(std::forward<decltype(operand)>(operand)));
 
                 return property_validator<
                         decltype(fn),
@@ -79,8 +125,8 @@ constexpr auto make_property_validator(PropT&& prop, OpT&& op, OperandT&& operan
             },
             [](auto&& prop, auto&& op, auto&& operand)
             {
-                auto fn=hana::reverse_partial(dispatch,std::forward<decltype(prop)>(prop),std::forward<decltype(op)>(op),
-                                              adjust_storable(std::forward<decltype(operand)>(operand)));
+                auto fn=make_property_validator_handler(std::forward<decltype(prop)>(prop),std::forward<decltype(op)>(op),
+                                                       adjust_storable(std::forward<decltype(operand)>(operand)));
 
                 return property_validator<
                         decltype(fn),
@@ -27,6 +27,67 @@ Distributed under the Boost Software License, Version 1.0.
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
+struct report_sink_tag;
+
+namespace detail
+{
+
+/**
+ * @brief Default helper to trim destination object.
+ */
+template <typename DstT, typename =hana::when<true>>
+struct trim_dst_t
+{
+    void operator() (DstT& dst) const
+    {
+        boost::trim(dst);
+    }
+};
+
+/**
+ * @brief Helper to trim report sink that can not be trimmed as a sequence.
+ */
+template <typename DstT>
+struct trim_dst_t<DstT,
+            hana::when<hana::is_a<report_sink_tag,DstT>>
+        >
+{
+    void operator() (DstT& dst) const
+    {
+        dst.trim();
+    }
+};
+
+#ifdef HATN_VALIDATOR_FMT
+
+/**
+ * @brief Helper to trim fmt::memory_buffer.
+ */
+template <typename DstT>
+struct trim_dst_t<DstT,
+            hana::when<is_fmt_memory_buffer<DstT>::value>
+        >
+{
+    void operator() (DstT& dst) const
+    {
+        fmt_trim(dst);
+    }
+};
+
+#endif
+
+/**
+ * @brief Trim destination object.
+ * @param dst Destination object.
+ */
+template <typename DstT>
+void trim_dst(DstT& dst)
+{
+    trim_dst_t<DstT>{}(dst);
+}
+
+}
+
 /**
  * @brief Backend formatter.
  *
@@ -55,7 +116,7 @@ struct backend_formatter_t
     static void append_join_args(DstT& dst, SepT&& sep, Args&&... args)
     {
         detail::backend_formatter_helper<DstT>::append_join_args(dst,std::forward<SepT>(sep),std::forward<Args>(args)...);
-        boost::trim(detail::to_dst(dst));
+        detail::trim_dst(detail::to_dst(dst));
     }
 
     /**
@@ -68,7 +129,7 @@ struct backend_formatter_t
     static void append_join(DstT& dst, SepT&& sep, PartsT&& parts)
     {
         detail::backend_formatter_helper<DstT>::append_join(dst,std::forward<SepT>(sep),std::forward<PartsT>(parts));
-        boost::trim(detail::to_dst(dst));
+        detail::trim_dst(detail::to_dst(dst));
     }
 };
 
@@ -0,0 +1,161 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/buffered_writer.hpp
+*
+*  Defines buffered writer of bytes to destination container.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_BUFFERED_WRITER_HPP
+#define HATN_VALIDATOR_BUFFERED_WRITER_HPP
+
+#include <array>
+#include <cstring>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+
+/**
+ * @brief Size of inline buffer of buffered writer.
+ */
+#ifndef HATN_VALIDATOR_WRITER_BUFFER_SIZE
+    #define HATN_VALIDATOR_WRITER_BUFFER_SIZE 256
+#endif
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Writer that collects small writes in inline buffer and appends them to destination container in blocks.
+ *
+ * Destination container must be a contiguous resizable container of chars or bytes, e.g. std::string or std::vector<uint8_t>.
+ */
+template <typename DstT, size_t BufferSize=HATN_VALIDATOR_WRITER_BUFFER_SIZE>
+class buffered_writer
+{
+    public:
+
+        using destination_type=DstT;
+
+        /**
+         * @brief Constructor.
+         * @param dst Destination container.
+         */
+        explicit buffered_writer(DstT& dst) noexcept : _dst(&dst),_size(0)
+        {}
+
+        /**
+         * @brief Write single char.
+         * @param ch Char to write.
+         */
+        void put(char ch)
+        {
+            if (_size==BufferSize)
+            {
+                flush();
+            }
+            _buffer[_size++]=ch;
+        }
+
+        /**
+         * @brief Write a block of chars.
+         * @param data Pointer to data.
+         * @param size Size of data.
+         */
+        void write(const char* data, size_t size)
+        {
+            if (size>BufferSize-_size)
+            {
+                flush();
+                if (size>BufferSize)
+                {
+                    append(data,size);
+                    return;
+                }
+            }
+            std::memcpy(_buffer.data()+_size,data,size);
+            _size+=size;
+        }
+
+        /**
+         * @brief Write string.
+         * @param str String to write.
+         */
+        void write(string_view str)
+        {
+            write(str.data(),str.size());
+        }
+
+        /**
+         * @brief Append buffered data to destination container.
+         */
+        void flush()
+        {
+            if (_size!=0)
+            {
+                append(_buffer.data(),_size);
+                _size=0;
+            }
+        }
+
+        /**
+         * @brief Get total size of written data including data in destination container.
+         * @return Size.
+         */
+        size_t size() const noexcept
+        {
+            return _dst->size()+_size;
+        }
+
+        /**
+         * @brief Discard written data beyond given size.
+         * @param size Size to truncate to, usually obtained with size() earlier.
+         */
+        void truncate(size_t size)
+        {
+            flush();
+            if (size<_dst->size())
+            {
+                _dst->resize(size);
+            }
+        }
+
+        /**
+         * @brief Get destination container.
+         * @return Destination container.
+         */
+        DstT& destination() noexcept
+        {
+            return *_dst;
+        }
+
+    private:
+
+        void append(const char* data, size_t size)
+        {
+            using value_type=typename DstT::value_type;
+            auto begin=reinterpret_cast<const value_type*>(data);
+            _dst->insert(_dst->end(),begin,begin+size);
+        }
+
+        DstT* _dst;
+        std::array<char,BufferSize> _buffer;
+        size_t _size;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_BUFFERED_WRITER_HPP
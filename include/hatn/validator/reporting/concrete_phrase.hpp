@@ -143,7 +143,7 @@ class concrete_phrase
          * @brief Get text of the phrase.
          * @return Text.
          */
-        std::string text() const
+        const std::string& text() const noexcept
         {
             return _text;
         }
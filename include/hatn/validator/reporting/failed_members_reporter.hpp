@@ -23,6 +23,7 @@ Distributed under the Boost Software License, Version 1.0.
 
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/reporting/reporter.hpp>
+#include <hatn/validator/reporting/member_path_builder.hpp>
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
@@ -52,6 +53,7 @@ class failed_members_reporter
             _explicit_reporting_count=0;
             _members.clear();
             _stack.clear();
+            _path.reset();
         }
 
         /**
@@ -61,6 +63,7 @@ class failed_members_reporter
         template <typename AggregationT>
         void aggregate_open(AggregationT&& aggregation)
         {
+            _path.open();
             if (skip_aggregate_open() || skip_explicit_report())
             {
                 return;
@@ -80,6 +83,7 @@ class failed_members_reporter
         template <typename AggregationT, typename MemberT>
         void aggregate_open(AggregationT&& aggregation, MemberT&& member)
         {
+            _path.open(member);
             if (skip_aggregate_open() || skip_explicit_report())
             {
                 return;
@@ -96,6 +100,7 @@ class failed_members_reporter
          */
         void aggregate_close(bool ok)
         {
+            _path.close();
             if (skip_explicit_report())
             {
                 return;
@@ -292,7 +297,7 @@ class failed_members_reporter
         template <typename MemberT>
         void add_failed_member(const MemberT& member)
         {
-            std::string m=dotted_member_names(member);
+            auto m=_path.format(member);
             if (std::find(std::begin(_members),std::end(_members),m)==std::end(_members))
             {
                 _members.push_back(std::move(m));
@@ -302,7 +307,7 @@ class failed_members_reporter
         template <typename MemberT>
         void drop_failed_member(const MemberT& member)
         {
-            std::string m=dotted_member_names(member);
+            auto m=_path.format(member);
             auto it=std::find(std::begin(_members),std::end(_members),m);
             if (it!=std::end(_members))
             {
@@ -387,6 +392,7 @@ class failed_members_reporter
         size_t _explicit_reporting_count;
 
         std::vector<std::string> _members;
+        member_path_builder<dotted_path_format> _path;
 };
 
 //-------------------------------------------------------------
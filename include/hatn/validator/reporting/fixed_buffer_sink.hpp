@@ -0,0 +1,231 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/fixed_buffer_sink.hpp
+*
+*  Defines report sink with fixed capacity inline buffer.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_FIXED_BUFFER_SINK_HPP
+#define HATN_VALIDATOR_FIXED_BUFFER_SINK_HPP
+
+#include <array>
+#include <cctype>
+#include <cstring>
+#include <string>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/reporting/report_sink.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Report sink that keeps report in inline buffer of fixed capacity.
+ *
+ * If report does not fit into the buffer then either the report is truncated at UTF-8 character boundary,
+ * or, if HeapFallback is true, the report is moved to a heap string that grows as needed.
+ * Thus, a sink placed on stack does not need any heap allocation for typical short reports.
+ */
+template <size_t Capacity, bool HeapFallback=false>
+class fixed_buffer_sink
+{
+    public:
+
+        using hana_tag=report_sink_tag;
+        using value_type=char;
+
+        fixed_buffer_sink() noexcept : _size(0),_truncated(false),_on_heap(false)
+        {}
+
+        /**
+         * @brief Write single char.
+         * @param ch Char to write.
+         */
+        void push_back(char ch)
+        {
+            append(&ch,1);
+        }
+
+        /**
+         * @brief Write a block of chars.
+         * @param data Pointer to data.
+         * @param size Size of data.
+         */
+        void append(const char* data, size_t size)
+        {
+            if (_truncated)
+            {
+                return;
+            }
+            if (_on_heap)
+            {
+                _heap.append(data,size);
+                return;
+            }
+            if (size<=Capacity-_size)
+            {
+                std::memcpy(_buffer.data()+_size,data,size);
+                _size+=size;
+                return;
+            }
+            overflow(data,size,std::integral_constant<bool,HeapFallback>{});
+        }
+
+        /**
+         * @brief Drop leading and trailing whitespaces.
+         */
+        void trim()
+        {
+            auto* data=_on_heap ? &_heap[0] : _buffer.data();
+            auto size=this->size();
+
+            size_t begin=0;
+            while (begin<size && std::isspace(static_cast<unsigned char>(data[begin])))
+            {
+                ++begin;
+            }
+            size_t end=size;
+            while (end>begin && std::isspace(static_cast<unsigned char>(data[end-1])))
+            {
+                --end;
+            }
+            if (begin!=0)
+            {
+                std::memmove(data,data+begin,end-begin);
+            }
+            resize(end-begin);
+        }
+
+        /**
+         * @brief Get report.
+         * @return View of report.
+         */
+        string_view view() const noexcept
+        {
+            return _on_heap ? string_view(_heap) : string_view(_buffer.data(),_size);
+        }
+
+        /**
+         * @brief Get report as string.
+         * @return Report.
+         */
+        std::string str() const
+        {
+            auto v=view();
+            return std::string(v.data(),v.size());
+        }
+
+        size_t size() const noexcept
+        {
+            return _on_heap ? _heap.size() : _size;
+        }
+
+        bool empty() const noexcept
+        {
+            return size()==0;
+        }
+
+        /**
+         * @brief Check if report was truncated because it did not fit into the buffer.
+         */
+        bool truncated() const noexcept
+        {
+            return _truncated;
+        }
+
+        /**
+         * @brief Check if report was moved to heap because it did not fit into the buffer.
+         */
+        bool on_heap() const noexcept
+        {
+            return _on_heap;
+        }
+
+        /**
+         * @brief Clear the sink to reuse it for the next report.
+         */
+        void clear() noexcept
+        {
+            _size=0;
+            _truncated=false;
+            _on_heap=false;
+            _heap.clear();
+        }
+
+        constexpr static size_t capacity() noexcept
+        {
+            return Capacity;
+        }
+
+    private:
+
+        void overflow(const char* data, size_t size, std::true_type)
+        {
+            _heap.reserve(_size+size);
+            _heap.assign(_buffer.data(),_size);
+            _heap.append(data,size);
+            _on_heap=true;
+        }
+
+        void overflow(const char* data, size_t, std::false_type)
+        {
+            auto count=Capacity-_size;
+            std::memcpy(_buffer.data()+_size,data,count);
+            _size+=count;
+            _truncated=true;
+
+            // drop incomplete UTF-8 character at the end
+            size_t lead=_size;
+            while (lead!=0 && _size-lead<4)
+            {
+                --lead;
+                auto ch=static_cast<unsigned char>(_buffer[lead]);
+                if ((ch&0xC0)!=0x80)
+                {
+                    size_t length=(ch&0x80)==0 ? 1 : ((ch&0xE0)==0xC0 ? 2 : ((ch&0xF0)==0xE0 ? 3 : 4));
+                    if (lead+length>_size)
+                    {
+                        _size=lead;
+                    }
+                    break;
+                }
+            }
+        }
+
+        void resize(size_t size)
+        {
+            if (_on_heap)
+            {
+                _heap.resize(size);
+            }
+            else
+            {
+                _size=size;
+            }
+        }
+
+        std::array<char,Capacity> _buffer;
+        size_t _size;
+        bool _truncated;
+        bool _on_heap;
+        std::string _heap;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_FIXED_BUFFER_SINK_HPP
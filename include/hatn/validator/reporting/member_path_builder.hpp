@@ -0,0 +1,367 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/member_path_builder.hpp
+*
+* Defines builder of member paths that reuses a single buffer while traversing nested members.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_MEMBER_PATH_BUILDER_HPP
+#define HATN_VALIDATOR_MEMBER_PATH_BUILDER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+#include <hatn/validator/utils/safe_compare.hpp>
+#include <hatn/validator/compact_variadic_property.hpp>
+#include <hatn/validator/reporting/concrete_phrase.hpp>
+#include <hatn/validator/reporting/single_member_name.hpp>
+#include <hatn/validator/reporting/dotted_member_names.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Format of member path as JSON Pointer defined in RFC 6901.
+ *
+ * For example: ["field1"]["sub/field"][1] will be formatted as /field1/sub~1field/1
+ */
+struct json_pointer_path_format
+{
+    static void append_segment(std::string& dst, const string_view& segment, bool)
+    {
+        dst.push_back('/');
+        for (auto ch:segment)
+        {
+            if (ch=='~')
+            {
+                dst.append("~0",2);
+            }
+            else if (ch=='/')
+            {
+                dst.append("~1",2);
+            }
+            else
+            {
+                dst.push_back(ch);
+            }
+        }
+    }
+};
+
+/**
+ * @brief Format of member path as dot separated names.
+ *
+ * For example: ["field1"]["subfield1"][1] will be formatted as field1.subfield1.1
+ */
+struct dotted_path_format
+{
+    static void append_segment(std::string& dst, const string_view& segment, bool first)
+    {
+        if (!first)
+        {
+            dst.push_back('.');
+        }
+        dst.append(segment.data(),segment.size());
+    }
+};
+
+namespace detail
+{
+
+inline string_view member_path_segment(const std::string& str) noexcept
+{
+    return str;
+}
+
+inline string_view member_path_segment(const char* str) noexcept
+{
+    return str;
+}
+
+inline string_view member_path_segment(const concrete_phrase& phrase) noexcept
+{
+    return phrase.text();
+}
+
+/**
+ * @brief Unique key of a type of member path key that does not require RTTI.
+ */
+template <typename T>
+struct member_path_key_type
+{
+    static const char id;
+};
+template <typename T>
+const char member_path_key_type<T>::id=0;
+
+}
+
+/**
+ * @brief Builder of member paths with a single reusable buffer.
+ *
+ * Builder keeps segments of the path of the current level of traversal in the buffer.
+ * When traversal descends into a member the keys of the member are appended to the buffer with open(member)
+ * and they are dropped with close() when traversal ascends. Builder keeps copies of the keys of current level,
+ * so a member is nested into current level if the keys of its path are equal to the keys of current level.
+ * Thus, formatting of a member nested into current level costs only comparing the keys of current level
+ * and formatting of the keys that follow them. Keys of different types are never equal and
+ * members that are not nested into current level are formatted from scratch.
+ *
+ * Keys are formatted the same way as by dotted_member_names and then joined according to FormatT.
+ */
+template <typename FormatT, typename TraitsT=dotted_member_names_traits_t>
+class member_path_builder
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param traits Traits to format single keys of member path.
+         */
+        explicit member_path_builder(TraitsT traits=TraitsT{})
+            : _traits(std::move(traits))
+        {}
+
+        /**
+         * @brief Open level without member.
+         */
+        void open()
+        {
+            _levels.push_back(level{_segments.size(),true});
+        }
+
+        /**
+         * @brief Open level of member.
+         * @param member Member.
+         *
+         * If the member is not nested into member of current level then the level is opened but
+         * all members are formatted from scratch until the level is closed.
+         */
+        template <typename MemberT>
+        void open(const MemberT& member)
+        {
+            auto valid=is_incremental(member);
+            _levels.push_back(level{_segments.size(),valid});
+            if (valid)
+            {
+                // keys of the path are kept in a single copy shared by segments
+                auto path=std::make_shared<typename MemberT::path_type>(member.path());
+                size_t i=0;
+                auto from=_segments.size();
+                hana::for_each(
+                    *path,
+                    [&](const auto& key)
+                    {
+                        if (i++>=from)
+                        {
+                            this->push_segment(key,std::shared_ptr<const void>(path,&key));
+                        }
+                    }
+                );
+            }
+            else
+            {
+                ++_invalid_levels;
+            }
+        }
+
+        /**
+         * @brief Close current level and drop keys pushed since the level was opened.
+         */
+        void close()
+        {
+            if (!_levels.empty())
+            {
+                const auto& back=_levels.back();
+                if (!back.valid)
+                {
+                    --_invalid_levels;
+                }
+                truncate(back.depth);
+                _levels.pop_back();
+            }
+        }
+
+        /**
+         * @brief Append single key to the path.
+         * @param key Key.
+         */
+        template <typename KeyT>
+        void push(const KeyT& key)
+        {
+            push_segment(key,std::make_shared<KeyT>(key));
+        }
+
+        /**
+         * @brief Drop last key from the path.
+         */
+        void pop()
+        {
+            if (!_segments.empty())
+            {
+                truncate(_segments.size()-1);
+            }
+        }
+
+        /**
+         * @brief Format path of a member.
+         * @param member Member.
+         * @return Formatted path.
+         *
+         * If the member is nested into member of current level then only the keys following the path of current level
+         * are formatted, otherwise the path is formatted from scratch.
+         */
+        template <typename MemberT>
+        std::string format(const MemberT& member)
+        {
+            if (_invalid_levels!=0 || !is_incremental(member))
+            {
+                // format the path from scratch
+                member_path_builder builder{_traits};
+                builder.push_keys(compact_variadic_property(member.path()),0);
+                return builder.str();
+            }
+
+            auto depth=_segments.size();
+            push_keys(member.path(),depth);
+            std::string result(_buf);
+            truncate(depth);
+            return result;
+        }
+
+        /**
+         * @brief Get formatted path of current level.
+         * @return Formatted path.
+         */
+        const std::string& str() const noexcept
+        {
+            return _buf;
+        }
+
+        /**
+         * @brief Get number of keys in the path.
+         * @return Depth of the path.
+         */
+        size_t depth() const noexcept
+        {
+            return _segments.size();
+        }
+
+        /**
+         * @brief Clear path and levels.
+         */
+        void reset()
+        {
+            _buf.clear();
+            _segments.clear();
+            _levels.clear();
+            _invalid_levels=0;
+        }
+
+    private:
+
+        struct level
+        {
+            size_t depth;
+            bool valid;
+        };
+
+        struct segment
+        {
+            size_t offset;
+            std::shared_ptr<const void> key;
+            const void* type;
+        };
+
+        template <typename MemberT>
+        bool is_incremental(const MemberT& member) const
+        {
+            // paths with variadic properties are compacted, so they can not be extended incrementally
+            return !MemberT::is_with_varg::value && MemberT::path_depth()>=_segments.size() && has_prefix(member.path());
+        }
+
+        template <typename PathT>
+        bool has_prefix(const PathT& path) const
+        {
+            bool ok=true;
+            size_t i=0;
+            hana::for_each(
+                path,
+                [&](const auto& key)
+                {
+                    if (ok && i<_segments.size())
+                    {
+                        using key_type=std::decay_t<decltype(key)>;
+                        const auto& seg=_segments[i];
+                        ok=seg.type==&detail::member_path_key_type<key_type>::id
+                            &&
+                           safe_compare_equal(unwrap_object(*static_cast<const key_type*>(seg.key.get())),unwrap_object(key));
+                    }
+                    ++i;
+                }
+            );
+            return ok;
+        }
+
+        template <typename KeyT>
+        void push_segment(const KeyT& key, std::shared_ptr<const void> stored_key)
+        {
+            _segments.push_back(segment{_buf.size(),std::move(stored_key),&detail::member_path_key_type<KeyT>::id});
+            auto&& name=single_member_name(key,_traits);
+            FormatT::append_segment(_buf,detail::member_path_segment(name),_segments.size()==1);
+        }
+
+        template <typename PathT>
+        void push_keys(const PathT& path, size_t from)
+        {
+            // keys are formatted but not kept, so such segments must be truncated before the next comparison of paths
+            size_t i=0;
+            hana::for_each(
+                path,
+                [&](const auto& key)
+                {
+                    if (i++>=from)
+                    {
+                        this->push_segment(key,nullptr);
+                    }
+                }
+            );
+        }
+
+        void truncate(size_t depth)
+        {
+            if (depth<_segments.size())
+            {
+                _buf.resize(_segments[depth].offset);
+                _segments.resize(depth);
+            }
+        }
+
+        TraitsT _traits;
+        std::string _buf;
+        std::vector<segment> _segments;
+        std::vector<level> _levels;
+        size_t _invalid_levels=0;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_MEMBER_PATH_BUILDER_HPP
@@ -0,0 +1,619 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/mo_translator.hpp
+*
+*  Defines translator that uses memory-mapped gettext .mo catalogs.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_MO_TRANSLATOR_HPP
+#define HATN_VALIDATOR_MO_TRANSLATOR_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/reporting/grammar_categories.hpp>
+#include <hatn/validator/reporting/translator.hpp>
+
+/**
+ * @brief Size of inline buffer for lookup keys with contexts, longer keys are constructed on heap.
+ */
+#ifndef HATN_VALIDATOR_MO_KEY_BUFFER_SIZE
+    #define HATN_VALIDATOR_MO_KEY_BUFFER_SIZE 256
+#endif
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Error of loading gettext catalog.
+ */
+class mo_error : public std::runtime_error
+{
+    public:
+
+        using std::runtime_error::runtime_error;
+};
+
+namespace detail
+{
+
+/**
+ * @brief Read-only memory mapping of a file.
+ */
+class mapped_file
+{
+    public:
+
+        /**
+         * @brief Constructor.
+         * @param path Path to file.
+         */
+        explicit mapped_file(const std::string& path) : _data(nullptr),_size(0)
+        {
+#ifdef _WIN32
+            _file=::CreateFileA(path.c_str(),GENERIC_READ,FILE_SHARE_READ,nullptr,OPEN_EXISTING,FILE_ATTRIBUTE_NORMAL,nullptr);
+            if (_file==INVALID_HANDLE_VALUE)
+            {
+                throw mo_error("failed to open file "+path);
+            }
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(_file,&size))
+            {
+                ::CloseHandle(_file);
+                throw mo_error("failed to get size of file "+path);
+            }
+            _size=static_cast<size_t>(size.QuadPart);
+            _mapping=nullptr;
+            if (_size!=0)
+            {
+                _mapping=::CreateFileMappingA(_file,nullptr,PAGE_READONLY,0,0,nullptr);
+                if (_mapping==nullptr)
+                {
+                    ::CloseHandle(_file);
+                    throw mo_error("failed to map file "+path);
+                }
+                _data=static_cast<const char*>(::MapViewOfFile(_mapping,FILE_MAP_READ,0,0,0));
+                if (_data==nullptr)
+                {
+                    ::CloseHandle(_mapping);
+                    ::CloseHandle(_file);
+                    throw mo_error("failed to map file "+path);
+                }
+            }
+#else
+            auto fd=::open(path.c_str(),O_RDONLY);
+            if (fd<0)
+            {
+                throw mo_error("failed to open file "+path);
+            }
+            struct stat st;
+            if (::fstat(fd,&st)!=0)
+            {
+                ::close(fd);
+                throw mo_error("failed to get size of file "+path);
+            }
+            _size=static_cast<size_t>(st.st_size);
+            if (_size!=0)
+            {
+                auto data=::mmap(nullptr,_size,PROT_READ,MAP_PRIVATE,fd,0);
+                if (data==MAP_FAILED)
+                {
+                    ::close(fd);
+                    throw mo_error("failed to map file "+path);
+                }
+                _data=static_cast<const char*>(data);
+            }
+            ::close(fd);
+#endif
+        }
+
+        ~mapped_file()
+        {
+#ifdef _WIN32
+            if (_data!=nullptr)
+            {
+                ::UnmapViewOfFile(_data);
+            }
+            if (_mapping!=nullptr)
+            {
+                ::CloseHandle(_mapping);
+            }
+            ::CloseHandle(_file);
+#else
+            if (_data!=nullptr)
+            {
+                ::munmap(const_cast<char*>(_data),_size);
+            }
+#endif
+        }
+
+        mapped_file(const mapped_file&)=delete;
+        mapped_file(mapped_file&&)=delete;
+        mapped_file& operator=(const mapped_file&)=delete;
+        mapped_file& operator=(mapped_file&&)=delete;
+
+        string_view view() const noexcept
+        {
+            return string_view(_data,_size);
+        }
+
+    private:
+
+        const char* _data;
+        size_t _size;
+#ifdef _WIN32
+        HANDLE _file;
+        HANDLE _mapping;
+#endif
+};
+
+}
+
+/**
+ * @brief Result of lookup in gettext catalog.
+ */
+struct mo_phrase
+{
+    string_view text;
+    grammar_categories grammar_cats;
+    bool found;
+};
+
+/**
+ * @brief Translator that serves translations directly from gettext .mo catalog.
+ *
+ * The catalog is either memory-mapped from a file or used in place from a buffer provided by the caller.
+ * No tables are built when the catalog is loaded, strings are looked up in the hash table of the catalog
+ * or with binary search if the catalog has no hash table. Phrases returned by find() refer to the catalog without copying.
+ *
+ * Grammatical categories are supported through message contexts:
+ *  - context "cats:<list of categories>" marks variant of translation that is selected if preceding phrase has all listed categories,
+ *    e.g. "cats:1,5" for categories with values 1 and 5; categories in the list must be sorted in ascending order;
+ *  - translation of context "grammar:<list of categories>" holds comma separated list of categories of the translated phrase itself
+ *    for the variant with the same list of categories in "cats:" context, the list is empty for default variant.
+ *
+ * Translator selects the variant with the maximum number of matching categories. If a message has plural forms then
+ * the first plural form is used when plural grammatical category is requested, otherwise the singular form is used.
+ *
+ * Translator can be copied, copies share the same catalog.
+ */
+class mo_translator : public translator
+{
+    public:
+
+        /**
+         * @brief Default constructor.
+         */
+        mo_translator() : _strings_count(0),_hash_size(0),_originals(0),_translations(0),_hash_table(0),_swap(false),_plural_cats(0)
+        {}
+
+        /**
+         * @brief Constructor from file.
+         * @param path Path to .mo file.
+         * @param plural_cats Bitmask of grammatical categories that select plural form of messages.
+         */
+        explicit mo_translator(
+                const std::string& path,
+                grammar_categories plural_cats=grammar_categories_bitmask(grammar::plural)
+            ) : mo_translator()
+        {
+            _file=std::make_shared<detail::mapped_file>(path);
+            _plural_cats=plural_cats;
+            load(_file->view());
+        }
+
+        /**
+         * @brief Constructor from buffer.
+         * @param data Contents of .mo catalog, the buffer must be valid for the lifetime of translator and its copies.
+         * @param size Size of the buffer.
+         * @param plural_cats Bitmask of grammatical categories that select plural form of messages.
+         */
+        mo_translator(
+                const char* data,
+                size_t size,
+                grammar_categories plural_cats=grammar_categories_bitmask(grammar::plural)
+            ) : mo_translator()
+        {
+            _plural_cats=plural_cats;
+            load(string_view(data,size));
+        }
+
+        /**
+         * @brief Reset translator.
+         */
+        virtual void reset() override
+        {
+            *this=mo_translator();
+        }
+
+        /**
+         * @brief Translate a string.
+         * @param id String id.
+         * @param cats Grammar categories to look for.
+         * @return Translated string or id if such string not found.
+         */
+        virtual translation_result translate(const std::string& id, grammar_categories cats=0) const override
+        {
+            auto phrase=find(id,cats);
+            if (phrase.found)
+            {
+                return translation_result{concrete_phrase(std::string(phrase.text.data(),phrase.text.size()),phrase.grammar_cats),true};
+            }
+            return translation_result{id,false};
+        }
+
+        using translator::translate;
+
+        /**
+         * @brief Find translation of a string without copying.
+         * @param id String id.
+         * @param cats Grammar categories to look for.
+         * @return Phrase referring to the catalog.
+         */
+        mo_phrase find(string_view id, grammar_categories cats=0) const
+        {
+            mo_phrase result{string_view(),0,false};
+
+            // variant with the maximum number of categories that are set in requested categories
+            for (auto count=count_grammar_categories(cats);count!=0 && !result.found;--count)
+            {
+                // enumerate subsets of requested categories with given number of categories
+                for (grammar_categories sub=cats;;sub=static_cast<grammar_categories>((sub-1)&cats))
+                {
+                    if (count_grammar_categories(sub)==count)
+                    {
+                        if (lookup_variant(id,sub,cats,result))
+                        {
+                            break;
+                        }
+                    }
+                    if (sub==0)
+                    {
+                        break;
+                    }
+                }
+            }
+            if (!result.found)
+            {
+                lookup_variant(id,0,cats,result);
+            }
+            return result;
+        }
+
+        /**
+         * @brief Get number of strings in catalog.
+         * @return Number of strings.
+         */
+        size_t size() const noexcept
+        {
+            return _strings_count;
+        }
+
+        /**
+         * @brief Check if translator is empty.
+         * @return Boolean flag.
+         */
+        bool empty() const noexcept
+        {
+            return _strings_count==0;
+        }
+
+    private:
+
+        void load(string_view data)
+        {
+            _data=data;
+            if (_data.size()<28)
+            {
+                throw mo_error("gettext catalog is too small");
+            }
+            auto magic=read_u32(0);
+            if (magic==0x950412deu)
+            {
+                _swap=false;
+            }
+            else if (magic==0xde120495u)
+            {
+                _swap=true;
+            }
+            else
+            {
+                throw mo_error("invalid magic number of gettext catalog");
+            }
+            if ((read_u32(4)>>16)>1)
+            {
+                throw mo_error("unsupported revision of gettext catalog");
+            }
+            _strings_count=read_u32(8);
+            _originals=read_u32(12);
+            _translations=read_u32(16);
+            _hash_size=read_u32(20);
+            _hash_table=read_u32(24);
+
+            auto fits=[this](uint64_t offset, uint64_t size)
+            {
+                return offset+size<=_data.size();
+            };
+            if (!fits(_originals,uint64_t(_strings_count)*8) || !fits(_translations,uint64_t(_strings_count)*8))
+            {
+                throw mo_error("string tables of gettext catalog are out of bounds");
+            }
+            if (_hash_size<3 || !fits(_hash_table,uint64_t(_hash_size)*4))
+            {
+                // catalog without valid hash table is searched with binary search
+                _hash_size=0;
+            }
+        }
+
+        uint32_t read_u32(size_t offset) const noexcept
+        {
+            uint32_t val;
+            std::memcpy(&val,_data.data()+offset,sizeof(val));
+            if (_swap)
+            {
+                val=((val&0xffu)<<24) | ((val&0xff00u)<<8) | ((val&0xff0000u)>>8) | (val>>24);
+            }
+            return val;
+        }
+
+        /**
+         * @brief Get string from table of catalog.
+         * @param table Offset of the table.
+         * @param index Index of the string.
+         * @return String including plural forms separated with zeros or empty string if descriptor of the string is invalid.
+         */
+        string_view table_string(uint32_t table, uint32_t index) const noexcept
+        {
+            auto length=read_u32(table+size_t(index)*8);
+            auto offset=read_u32(table+size_t(index)*8+4);
+            if (uint64_t(offset)+length>=_data.size())
+            {
+                return string_view();
+            }
+            return string_view(_data.data()+offset,length);
+        }
+
+        /**
+         * @brief Check if original string of catalog matches the key.
+         *
+         * Original string of message with plural forms contains also the plural form of message after zero separator.
+         */
+        static bool matches(string_view original, string_view key) noexcept
+        {
+            return original.size()>=key.size()
+                    && std::memcmp(original.data(),key.data(),key.size())==0
+                    && (original.size()==key.size() || original[key.size()]=='\0');
+        }
+
+        static uint32_t hash(string_view key) noexcept
+        {
+            // hash function of GNU gettext
+            uint32_t hval=0;
+            for (auto ch:key)
+            {
+                hval<<=4;
+                hval+=static_cast<unsigned char>(ch);
+                auto g=hval&0xf0000000u;
+                if (g!=0)
+                {
+                    hval^=g>>24;
+                    hval^=g;
+                }
+            }
+            return hval;
+        }
+
+        /**
+         * @brief Find index of string in catalog.
+         * @param key String to look for.
+         * @return Index of string or _strings_count if not found.
+         */
+        uint32_t index_of(string_view key) const noexcept
+        {
+            if (_hash_size!=0)
+            {
+                auto hval=hash(key);
+                auto idx=hval%_hash_size;
+                auto incr=1+(hval%(_hash_size-2));
+                for (uint32_t i=0;i<_hash_size;i++)
+                {
+                    auto nstr=read_u32(_hash_table+size_t(idx)*4);
+                    if (nstr==0)
+                    {
+                        break;
+                    }
+                    --nstr;
+                    if (nstr<_strings_count && matches(table_string(_originals,nstr),key))
+                    {
+                        return nstr;
+                    }
+                    idx=(idx>=_hash_size-incr) ? idx-(_hash_size-incr) : idx+incr;
+                }
+                return _strings_count;
+            }
+
+            // original strings are sorted in catalog
+            uint32_t begin=0;
+            uint32_t end=_strings_count;
+            while (begin<end)
+            {
+                auto middle=begin+(end-begin)/2;
+                auto original=table_string(_originals,middle);
+                auto len=std::min(original.size(),key.size());
+                auto cmp=std::memcmp(original.data(),key.data(),len);
+                if (cmp==0 && matches(original,key))
+                {
+                    return middle;
+                }
+                if (cmp<0 || (cmp==0 && original.size()<key.size()))
+                {
+                    begin=middle+1;
+                }
+                else
+                {
+                    end=middle;
+                }
+            }
+            return _strings_count;
+        }
+
+        /**
+         * @brief Find string with context.
+         * @param context Context or empty string.
+         * @param cats_list Categories to append to context.
+         * @param id String id.
+         * @param translation Found translation.
+         * @return True if found.
+         */
+        bool lookup(string_view context, grammar_categories cats_list, string_view id, string_view& translation) const
+        {
+            char buf[HATN_VALIDATOR_MO_KEY_BUFFER_SIZE];
+            std::string heap_key;
+            string_view key=id;
+            if (!context.empty())
+            {
+                // cats list takes at most 3 chars per category
+                auto max_size=context.size()+3*count_grammar_categories(cats_list)+1+id.size();
+                char* ptr=buf;
+                if (max_size>sizeof(buf))
+                {
+                    heap_key.resize(max_size);
+                    ptr=&heap_key[0];
+                }
+                auto begin=ptr;
+                std::memcpy(ptr,context.data(),context.size());
+                ptr+=context.size();
+                bool first=true;
+                for (size_t i=0;i<sizeof(grammar_categories)*8;i++)
+                {
+                    if ((cats_list&(grammar_categories(1)<<i))!=0)
+                    {
+                        if (!first)
+                        {
+                            *ptr++=',';
+                        }
+                        first=false;
+                        if (i>=10)
+                        {
+                            *ptr++=static_cast<char>('0'+i/10);
+                        }
+                        *ptr++=static_cast<char>('0'+i%10);
+                    }
+                }
+                *ptr++='\x04';
+                std::memcpy(ptr,id.data(),id.size());
+                ptr+=id.size();
+                key=string_view(begin,static_cast<size_t>(ptr-begin));
+            }
+
+            auto idx=index_of(key);
+            if (idx==_strings_count)
+            {
+                return false;
+            }
+            translation=table_string(_translations,idx);
+            return true;
+        }
+
+        bool lookup_variant(string_view id, grammar_categories sub, grammar_categories cats, mo_phrase& result) const
+        {
+            string_view translation;
+            auto found=(sub==0) ? lookup(string_view(),0,id,translation) : lookup("cats:",sub,id,translation);
+            if (!found)
+            {
+                return false;
+            }
+
+            // select plural form
+            auto separator=translation.find('\0');
+            if (separator!=string_view::npos)
+            {
+                if ((cats&_plural_cats)!=0)
+                {
+                    auto plural=translation.substr(separator+1);
+                    translation=plural.substr(0,plural.find('\0'));
+                }
+                else
+                {
+                    translation=translation.substr(0,separator);
+                }
+            }
+
+            result.text=translation;
+            result.found=true;
+
+            // grammatical categories of the phrase
+            string_view cats_str;
+            if (lookup("grammar:",sub,id,cats_str))
+            {
+                grammar_categories phrase_cats=0;
+                size_t val=0;
+                bool has_val=false;
+                for (size_t i=0;i<=cats_str.size();i++)
+                {
+                    if (i==cats_str.size() || cats_str[i]==',')
+                    {
+                        if (has_val && val<sizeof(grammar_categories)*8)
+                        {
+                            phrase_cats|=grammar_categories(1)<<val;
+                        }
+                        val=0;
+                        has_val=false;
+                    }
+                    else if (cats_str[i]>='0' && cats_str[i]<='9')
+                    {
+                        val=val*10+static_cast<size_t>(cats_str[i]-'0');
+                        has_val=true;
+                    }
+                }
+                result.grammar_cats=phrase_cats;
+            }
+            return true;
+        }
+
+        std::shared_ptr<detail::mapped_file> _file;
+        string_view _data;
+        uint32_t _strings_count;
+        uint32_t _hash_size;
+        uint32_t _originals;
+        uint32_t _translations;
+        uint32_t _hash_table;
+        bool _swap;
+        grammar_categories _plural_cats;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_MO_TRANSLATOR_HPP
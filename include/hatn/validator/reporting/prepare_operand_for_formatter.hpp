@@ -20,6 +20,7 @@ Distributed under the Boost Software License, Version 1.0.
 #define HATN_VALIDATOR_PREPARE_OPERAND_FORMATTER_HPP
 
 #include <hatn/validator/config.hpp>
+#include <hatn/validator/lazy.hpp>
 #include <hatn/validator/member.hpp>
 #include <hatn/validator/make_member.hpp>
 #include <hatn/validator/operators/contains.hpp>
@@ -59,6 +60,26 @@ struct prepare_operand_for_formatter_t<OpT,T,
     }
 };
 
+/**
+ * @brief Helper to prepare operand for formatter for lazy operands.
+ *
+ * Lazy operand is evaluated and its value is formatted.
+ */
+template <typename OpT, typename T>
+struct prepare_operand_for_formatter_t<OpT,T,
+            hana::when<
+                hana::is_a<lazy_tag,std::decay_t<T>>
+                &&
+                !std::is_same<std::decay_t<OpT>,contains_t>::value
+            >
+        >
+{
+    auto operator () (OpT&&, T&& b) const -> decltype(auto)
+    {
+        return b();
+    }
+};
+
 /**
  * @brief Template instance of helper for preparing operand for formatter.
  */
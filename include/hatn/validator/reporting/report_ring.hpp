@@ -0,0 +1,278 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/report_ring.hpp
+*
+*  Defines lock-free ring of reports and writer to it.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_REPORT_RING_HPP
+#define HATN_VALIDATOR_REPORT_RING_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/reporting/stream_sink.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Bounded lock-free ring of reports for multiple producers and multiple consumers.
+ *
+ * Each report occupies a slot of fixed size, reports that do not fit into a slot are truncated.
+ * If the ring is full then new reports are dropped and counted.
+ */
+template <size_t SlotSize=512, size_t SlotCount=64>
+class report_ring
+{
+    static_assert(SlotCount!=0 && (SlotCount&(SlotCount-1))==0,"Number of slots must be a power of 2");
+
+    struct slot
+    {
+        std::atomic<size_t> sequence;
+        size_t size;
+        bool truncated;
+        std::array<char,SlotSize> data;
+    };
+
+    public:
+
+        /**
+         * @brief Slot reserved by producer.
+         */
+        class reservation
+        {
+            public:
+
+                reservation() noexcept : _slot(nullptr),_position(0)
+                {}
+
+                /**
+                 * @brief Append data to reserved slot truncating the data that does not fit.
+                 * @param data Pointer to data.
+                 * @param size Size of data.
+                 */
+                void append(const char* data, size_t size) noexcept
+                {
+                    auto count=std::min(size,SlotSize-_slot->size);
+                    std::memcpy(_slot->data.data()+_slot->size,data,count);
+                    _slot->size+=count;
+                    if (count!=size)
+                    {
+                        _slot->truncated=true;
+                    }
+                }
+
+                explicit operator bool() const noexcept
+                {
+                    return _slot!=nullptr;
+                }
+
+            private:
+
+                slot* _slot;
+                size_t _position;
+
+                friend class report_ring;
+        };
+
+        report_ring() : _enqueue_position(0),_dequeue_position(0),_dropped(0)
+        {
+            for (size_t i=0;i<SlotCount;i++)
+            {
+                _slots[i].sequence.store(i,std::memory_order_relaxed);
+            }
+        }
+
+        report_ring(const report_ring&)=delete;
+        report_ring& operator=(const report_ring&)=delete;
+
+        /**
+         * @brief Reserve a slot for the next report.
+         * @return Reservation that is empty if the ring is full.
+         */
+        reservation reserve() noexcept
+        {
+            reservation r;
+            auto position=_enqueue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& s=_slots[position&(SlotCount-1)];
+                auto sequence=s.sequence.load(std::memory_order_acquire);
+                auto diff=static_cast<std::intptr_t>(sequence)-static_cast<std::intptr_t>(position);
+                if (diff==0)
+                {
+                    if (_enqueue_position.compare_exchange_weak(position,position+1,std::memory_order_relaxed))
+                    {
+                        s.size=0;
+                        s.truncated=false;
+                        r._slot=&s;
+                        r._position=position;
+                        return r;
+                    }
+                }
+                else if (diff<0)
+                {
+                    _dropped.fetch_add(1,std::memory_order_relaxed);
+                    return r;
+                }
+                else
+                {
+                    position=_enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Publish reserved slot to consumers.
+         * @param r Reservation.
+         */
+        void commit(reservation& r) noexcept
+        {
+            if (r)
+            {
+                r._slot->sequence.store(r._position+1,std::memory_order_release);
+                r._slot=nullptr;
+            }
+        }
+
+        /**
+         * @brief Consume the oldest report.
+         * @param handler Handler invoked with report and flag if the report was truncated.
+         * @return False if the ring is empty or the oldest report is not committed yet.
+         */
+        template <typename HandlerT>
+        bool consume(HandlerT&& handler)
+        {
+            auto position=_dequeue_position.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                auto& s=_slots[position&(SlotCount-1)];
+                auto sequence=s.sequence.load(std::memory_order_acquire);
+                auto diff=static_cast<std::intptr_t>(sequence)-static_cast<std::intptr_t>(position+1);
+                if (diff==0)
+                {
+                    if (_dequeue_position.compare_exchange_weak(position,position+1,std::memory_order_relaxed))
+                    {
+                        handler(string_view(s.data.data(),s.size),s.truncated);
+                        s.sequence.store(position+SlotCount,std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff<0)
+                {
+                    return false;
+                }
+                else
+                {
+                    position=_dequeue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        /**
+         * @brief Get number of reports dropped because the ring was full.
+         */
+        size_t dropped() const noexcept
+        {
+            return _dropped.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        std::array<slot,SlotCount> _slots;
+        alignas(64) std::atomic<size_t> _enqueue_position;
+        alignas(64) std::atomic<size_t> _dequeue_position;
+        std::atomic<size_t> _dropped;
+};
+
+/**
+ * @brief Writer of reports to ring, each report is published to the ring as a single message when it is completed.
+ */
+template <typename RingT>
+class ring_writer
+{
+    public:
+
+        explicit ring_writer(RingT& ring) noexcept : _ring(&ring),_reserved(false)
+        {}
+
+        ring_writer(ring_writer&& other) noexcept
+            : _ring(other._ring),
+              _reservation(other._reservation),
+              _reserved(other._reserved)
+        {
+            other._reservation=typename RingT::reservation();
+            other._reserved=false;
+        }
+
+        ring_writer(const ring_writer&)=delete;
+        ring_writer& operator=(const ring_writer&)=delete;
+        ring_writer& operator=(ring_writer&&)=delete;
+
+        ~ring_writer()
+        {
+            flush();
+        }
+
+        void write(const char* data, size_t size) noexcept
+        {
+            if (!_reserved)
+            {
+                _reservation=_ring->reserve();
+                _reserved=true;
+            }
+            if (_reservation)
+            {
+                _reservation.append(data,size);
+            }
+        }
+
+        void flush() noexcept
+        {
+            _ring->commit(_reservation);
+            _reserved=false;
+        }
+
+    private:
+
+        RingT* _ring;
+        typename RingT::reservation _reservation;
+        bool _reserved;
+};
+
+/**
+ * @brief Make sink that writes reports to lock-free ring.
+ * @param ring Ring of reports.
+ * @return Report sink.
+ *
+ * The sink buffer has the same size as ring's slot.
+ */
+template <size_t SlotSize, size_t SlotCount>
+auto make_ring_sink(report_ring<SlotSize,SlotCount>& ring)
+{
+    return stream_sink<ring_writer<report_ring<SlotSize,SlotCount>>,SlotSize>(ring);
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_REPORT_RING_HPP
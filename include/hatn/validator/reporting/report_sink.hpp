@@ -0,0 +1,137 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/report_sink.hpp
+*
+*  Defines backend formatter that writes reports to report sinks.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_REPORT_SINK_HPP
+#define HATN_VALIDATOR_REPORT_SINK_HPP
+
+#include <string>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/reporting/backend_formatter.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Tag of report sinks.
+ *
+ * Report sink is a destination of reports that is not a string. A sink must implement the following methods:
+ *  - push_back(char) and append(const char*, size_t) to write data;
+ *  - trim() to drop trailing whitespaces of data written so far, leading whitespaces must be skipped by the sink itself.
+ *
+ * Also a sink must define value_type as char.
+ */
+struct report_sink_tag;
+
+namespace detail
+{
+
+/**
+ * @brief Backend formatter that writes to report sink.
+ *
+ * Intermediate parts of reports of aggregations are constructed in strings, only the final report goes to the sink.
+ */
+template <typename SinkT>
+struct sink_backend_formatter
+{
+    using hana_tag=backend_formatter_tag;
+    using type=std::string;
+
+    SinkT& _sink;
+
+    template <typename ...Args>
+    void append(Args&&... args)
+    {
+#ifdef HATN_VALIDATOR_FMT
+        fmt_append_args(_sink,std::forward<Args>(args)...);
+#else
+        std_append(_sink,"",std::forward<Args>(args)...);
+#endif
+    }
+
+    template <typename SepT, typename ...Args>
+    void append_join_args(SepT&& sep, Args&&... args)
+    {
+#ifdef HATN_VALIDATOR_FMT
+        fmt_append_join_args(_sink,std::forward<SepT>(sep),std::forward<Args>(args)...);
+#else
+        std_append(_sink,std::forward<SepT>(sep),std::forward<Args>(args)...);
+#endif
+    }
+
+    template <typename SepT, typename PartsT>
+    void append_join(SepT&& sep, PartsT&& parts)
+    {
+#ifdef HATN_VALIDATOR_FMT
+        fmt_append_join(_sink,std::forward<SepT>(sep),std::forward<PartsT>(parts));
+#else
+        std_append_join(_sink,std::forward<SepT>(sep),std::forward<PartsT>(parts));
+#endif
+    }
+
+    SinkT& get()
+    {
+        return _sink;
+    }
+
+    static auto clone(std::string& dst)
+    {
+        return wrap_backend_formatter(dst);
+    }
+};
+
+/**
+ * @brief Backend formatter helper used when destination object is a report sink.
+ */
+template <typename DstT>
+struct backend_formatter_helper<DstT,
+            hana::when<hana::is_a<report_sink_tag,DstT>>
+        >
+{
+    template <typename ...Args>
+    static void append(DstT& dst, Args&&... args)
+    {
+        wrap(dst).append(std::forward<Args>(args)...);
+    }
+
+    template <typename SepT, typename ...Args>
+    static void append_join_args(DstT& dst, SepT&& sep, Args&&... args)
+    {
+        wrap(dst).append_join_args(std::forward<SepT>(sep),std::forward<Args>(args)...);
+    }
+
+    template <typename SepT, typename PartsT>
+    static void append_join(DstT& dst, SepT&& sep, PartsT&& parts)
+    {
+        wrap(dst).append_join(std::forward<SepT>(sep),std::forward<PartsT>(parts));
+    }
+
+    static auto wrap(DstT& dst)
+    {
+        return sink_backend_formatter<DstT>{dst};
+    }
+};
+
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_REPORT_SINK_HPP
@@ -135,8 +135,12 @@ class reporter
                 if (!ok || current_not())
                 {
                     update_brackets();
-                    auto wrapper=wrap_backend_formatter(report_dst(),_dst);
-                    _formatter.aggregate(wrapper,back);
+                    format_report(
+                        [&](auto& dst)
+                        {
+                            _formatter.aggregate(dst,back);
+                        }
+                    );
                 }
                 if (back.aggregation.id==aggregation_id::NOT)
                 {
@@ -158,8 +162,12 @@ class reporter
             {
                 return;
             }
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate_operator(wrapper,op,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate_operator(dst,op,b);
+                }
+            );
         }
 
         /**
@@ -175,8 +183,12 @@ class reporter
             {
                 return;
             }
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate_property(wrapper,prop,op,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate_property(dst,prop,op,b);
+                }
+            );
         }
 
         /**
@@ -199,8 +211,12 @@ class reporter
                 return;
             }
 
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate_exists(wrapper,member,op,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate_exists(dst,member,op,b);
+                }
+            );
         }
 
         /**
@@ -225,8 +241,12 @@ class reporter
                 return;
             }
 
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate(wrapper,member,prop,op,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate(dst,member,prop,op,b);
+                }
+            );
         }
 
         template <typename MemberT>
@@ -257,8 +277,12 @@ class reporter
                 return;
             }
 
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate_with_other_member(wrapper,member,prop,op,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate_with_other_member(dst,member,prop,op,b);
+                }
+            );
         }
 
         /**
@@ -284,8 +308,12 @@ class reporter
                 return;
             }
 
-            auto wrapper=wrap_backend_formatter(current(),_dst);
-            _formatter.validate_with_master_sample(wrapper,member,prop,op,member_sample,b);
+            format_current(
+                [&](auto& dst)
+                {
+                    _formatter.validate_with_master_sample(dst,member,prop,op,member_sample,b);
+                }
+            );
         }
 
         /**
@@ -328,8 +356,12 @@ class reporter
             }
             if (_explicit_reporting_count==0)
             {
-                auto wrapper=wrap_backend_formatter(current(),_dst);
-                wrapper.append(description);
+                format_current(
+                    [&](auto& dst)
+                    {
+                        dst.append(description);
+                    }
+                );
             }
         }
 
@@ -392,24 +424,38 @@ class reporter
             return false;
         }
 
-        typename DstT::type& current()
+        /**
+         * @brief Format report of current validation step either to a new part of current aggregation or to destination object.
+         * @param handler Handler that formats report to backend formatter given as an argument.
+         */
+        template <typename HandlerT>
+        void format_current(HandlerT&& handler)
         {
             if (!_stack.empty())
             {
                 _stack.back().parts.emplace_back();
-                return _stack.back().parts.back();
+                auto wrapper=wrap_backend_formatter(_stack.back().parts.back(),_dst);
+                handler(wrapper);
+                return;
             }
-            return _dst;
+            handler(_dst);
         }
 
-        typename DstT::type& report_dst()
+        /**
+         * @brief Format report of closed aggregation either to a new part of parent aggregation or to destination object.
+         * @param handler Handler that formats report to backend formatter given as an argument.
+         */
+        template <typename HandlerT>
+        void format_report(HandlerT&& handler)
         {
             if (_stack.size()>1)
             {
                 _stack.at(_stack.size()-2).parts.emplace_back();
-                return _stack.at(_stack.size()-2).parts.back();
+                auto wrapper=wrap_backend_formatter(_stack.at(_stack.size()-2).parts.back(),_dst);
+                handler(wrapper);
+                return;
             }
-            return _dst;
+            handler(_dst);
         }
 
         void update_brackets()
@@ -0,0 +1,292 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/stream_sink.hpp
+*
+*  Defines report sink that streams reports to writers such as std::ostream or file descriptor.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_STREAM_SINK_HPP
+#define HATN_VALIDATOR_STREAM_SINK_HPP
+
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <ostream>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/reporting/buffered_writer.hpp>
+#include <hatn/validator/reporting/report_sink.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Report sink that streams report to a writer through inline buffer.
+ *
+ * Writer must implement write(const char* data, size_t size) and flush() methods.
+ * Whitespaces at the beginning of report are skipped and trailing whitespaces are kept in the buffer
+ * until they are followed by other characters, thus the streamed report is trimmed the same way as string reports.
+ *
+ * The report is completed with flush() which must be called after each validation, flush() is also called in destructor.
+ */
+template <typename WriterT, size_t BufferSize=HATN_VALIDATOR_WRITER_BUFFER_SIZE>
+class stream_sink
+{
+    public:
+
+        using hana_tag=report_sink_tag;
+        using value_type=char;
+
+        /**
+         * @brief Constructor.
+         * @param args Arguments to forward to writer's constructor.
+         */
+        template <typename ...Args>
+        explicit stream_sink(Args&&... args)
+            : _writer(std::forward<Args>(args)...),
+              _size(0),
+              _started(false)
+        {}
+
+        stream_sink(stream_sink&& other)
+            : _writer(std::move(other._writer)),
+              _buffer(other._buffer),
+              _size(other._size),
+              _started(other._started)
+        {
+            other._size=0;
+            other._started=false;
+        }
+
+        stream_sink(const stream_sink&)=delete;
+        stream_sink& operator=(const stream_sink&)=delete;
+        stream_sink& operator=(stream_sink&&)=delete;
+
+        ~stream_sink()
+        {
+            flush();
+        }
+
+        /**
+         * @brief Write single char.
+         * @param ch Char to write.
+         */
+        void push_back(char ch)
+        {
+            if (!_started)
+            {
+                if (std::isspace(static_cast<unsigned char>(ch)))
+                {
+                    return;
+                }
+                _started=true;
+            }
+            if (_size==BufferSize)
+            {
+                drain();
+            }
+            _buffer[_size++]=ch;
+        }
+
+        /**
+         * @brief Write a block of chars.
+         * @param data Pointer to data.
+         * @param size Size of data.
+         */
+        void append(const char* data, size_t size)
+        {
+            while (!_started && size!=0)
+            {
+                push_back(*data++);
+                --size;
+            }
+            while (size!=0)
+            {
+                if (_size==BufferSize)
+                {
+                    drain();
+                }
+                auto count=std::min(size,BufferSize-_size);
+                std::memcpy(_buffer.data()+_size,data,count);
+                _size+=count;
+                data+=count;
+                size-=count;
+            }
+        }
+
+        /**
+         * @brief Drop trailing whitespaces that were not streamed yet.
+         */
+        void trim() noexcept
+        {
+            while (_size!=0 && std::isspace(static_cast<unsigned char>(_buffer[_size-1])))
+            {
+                --_size;
+            }
+        }
+
+        /**
+         * @brief Complete report and stream the rest of it to the writer.
+         */
+        void flush()
+        {
+            trim();
+            if (_size!=0)
+            {
+                _writer.write(_buffer.data(),_size);
+                _size=0;
+            }
+            if (_started)
+            {
+                _writer.flush();
+                _started=false;
+            }
+        }
+
+        /**
+         * @brief Get writer.
+         * @return Writer.
+         */
+        WriterT& writer() noexcept
+        {
+            return _writer;
+        }
+
+    private:
+
+        void drain()
+        {
+            // trailing whitespaces are kept in the buffer because they might be trimmed later
+            auto end=_size;
+            while (end!=0 && std::isspace(static_cast<unsigned char>(_buffer[end-1])))
+            {
+                --end;
+            }
+            if (end==0)
+            {
+                end=_size;
+            }
+            _writer.write(_buffer.data(),end);
+            std::memmove(_buffer.data(),_buffer.data()+end,_size-end);
+            _size-=end;
+        }
+
+        WriterT _writer;
+        std::array<char,BufferSize> _buffer;
+        size_t _size;
+        bool _started;
+};
+
+/**
+ * @brief Writer to std::ostream.
+ */
+class ostream_writer
+{
+    public:
+
+        explicit ostream_writer(std::ostream& stream) noexcept : _stream(&stream)
+        {}
+
+        void write(const char* data, size_t size)
+        {
+            _stream->write(data,static_cast<std::streamsize>(size));
+        }
+
+        void flush()
+        {
+            _stream->put('\n');
+            _stream->flush();
+        }
+
+    private:
+
+        std::ostream* _stream;
+};
+
+/**
+ * @brief Writer to file descriptor.
+ */
+class fd_writer
+{
+    public:
+
+        explicit fd_writer(int fd) noexcept : _fd(fd)
+        {}
+
+        void write(const char* data, size_t size)
+        {
+            while (size!=0)
+            {
+#ifdef _WIN32
+                auto count=::_write(_fd,data,static_cast<unsigned int>(size));
+#else
+                auto count=::write(_fd,data,size);
+#endif
+                if (count<0)
+                {
+                    if (errno==EINTR)
+                    {
+                        continue;
+                    }
+                    return;
+                }
+                data+=count;
+                size-=static_cast<size_t>(count);
+            }
+        }
+
+        void flush()
+        {
+            write("\n",1);
+        }
+
+    private:
+
+        int _fd;
+};
+
+/**
+ * @brief Make sink that streams reports to std::ostream, each report is written on a separate line.
+ * @param stream Output stream.
+ * @return Report sink.
+ */
+inline stream_sink<ostream_writer> make_ostream_sink(std::ostream& stream)
+{
+    return stream_sink<ostream_writer>(stream);
+}
+
+/**
+ * @brief Make sink that streams reports to file descriptor, each report is written on a separate line.
+ * @param fd File descriptor.
+ * @return Report sink.
+ */
+inline stream_sink<fd_writer> make_fd_sink(int fd)
+{
+    return stream_sink<fd_writer>(fd);
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_STREAM_SINK_HPP
@@ -96,6 +96,17 @@ struct strings
     TranslatorT _translator;
     AggregationStringsT _aggregation_strings;
 
+    /**
+     * @brief Constructor.
+     * @param translator Translator.
+     * @param aggregation_strings Strings of aggregations.
+     */
+    template <typename T1, typename T2>
+    constexpr strings(T1&& translator, T2&& aggregation_strings)
+        : _translator(std::forward<T1>(translator)),
+          _aggregation_strings(std::forward<T2>(aggregation_strings))
+    {}
+
     ~strings()=default;
     strings(strings&&)=default;
     strings(const strings&)=delete;
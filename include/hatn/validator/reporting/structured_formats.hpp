@@ -0,0 +1,164 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/structured_formats.hpp
+*
+*  Defines formats of structured reports.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_STRUCTURED_FORMATS_HPP
+#define HATN_VALIDATOR_STRUCTURED_FORMATS_HPP
+
+#include <cstdint>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Kind of record of structured report.
+ */
+enum class structured_record_kind : uint8_t
+{
+    check=1, //!< Failed check of operator.
+    hint=2 //!< Explicit description given with hint that replaces reports of all nested checks.
+};
+
+/**
+ * @brief Record of structured report describing a single failure.
+ *
+ * Fields that are not applicable to the record are empty, e.g. member is empty for checks of the object itself.
+ */
+struct structured_record
+{
+    structured_record_kind kind;
+    bool negated; //!< The check is under logical NOT, i.e. it failed because the operator succeeded.
+    string_view member; //!< Dot separated path of the member.
+    string_view op; //!< Untranslated description of the operator that is used as operator's ID.
+    string_view property; //!< Name of the property.
+    string_view operand; //!< Formatted operand.
+    string_view phrase; //!< Translated phrase as it would appear in text report.
+};
+
+/**
+ * @brief Format of structured report where each record is a JSON object written on a separate line.
+ *
+ * Example of a record:
+ * {"kind":"check","negated":false,"member":"field1","operator":"must be greater than or equal to","property":"value","operand":"10","phrase":"field1 must be greater than or equal to 10"}
+ */
+struct json_format_t
+{
+    template <typename WriterT>
+    static void write_record(WriterT& writer, const structured_record& record)
+    {
+        writer.write(record.kind==structured_record_kind::check ? "{\"kind\":\"check\"" : "{\"kind\":\"hint\"");
+        writer.write(record.negated ? ",\"negated\":true" : ",\"negated\":false");
+        write_field(writer,",\"member\":\"",record.member);
+        write_field(writer,",\"operator\":\"",record.op);
+        write_field(writer,",\"property\":\"",record.property);
+        write_field(writer,",\"operand\":\"",record.operand);
+        write_field(writer,",\"phrase\":\"",record.phrase);
+        writer.write("}\n");
+    }
+
+    template <typename WriterT>
+    static void write_field(WriterT& writer, const char* key, string_view value)
+    {
+        writer.write(key);
+        write_escaped(writer,value);
+        writer.put('"');
+    }
+
+    template <typename WriterT>
+    static void write_escaped(WriterT& writer, string_view str)
+    {
+        static const char* hex="0123456789abcdef";
+
+        // unescaped runs are written as blocks, UTF-8 sequences are written as is
+        size_t begin=0;
+        for (size_t i=0;i<str.size();i++)
+        {
+            auto ch=static_cast<unsigned char>(str[i]);
+            if (ch>=0x20 && ch!='"' && ch!='\\')
+            {
+                continue;
+            }
+            writer.write(str.data()+begin,i-begin);
+            begin=i+1;
+            writer.put('\\');
+            switch (ch)
+            {
+                case '"': writer.put('"'); break;
+                case '\\': writer.put('\\'); break;
+                case '\n': writer.put('n'); break;
+                case '\r': writer.put('r'); break;
+                case '\t': writer.put('t'); break;
+                case '\b': writer.put('b'); break;
+                case '\f': writer.put('f'); break;
+                default:
+                    writer.write("u00",3);
+                    writer.put(hex[ch>>4]);
+                    writer.put(hex[ch&0xF]);
+                    break;
+            }
+        }
+        writer.write(str.data()+begin,str.size()-begin);
+    }
+};
+constexpr json_format_t json_format{};
+
+/**
+ * @brief Compact binary format of structured report for inter-process communication.
+ *
+ * Each record is written as:
+ *  - kind, 1 byte;
+ *  - flags, 1 byte, bit 0 is set if the record is negated;
+ *  - fields member, operator, property, operand and phrase, each written as length encoded with unsigned LEB128 followed by UTF-8 bytes.
+ */
+struct binary_format_t
+{
+    template <typename WriterT>
+    static void write_record(WriterT& writer, const structured_record& record)
+    {
+        writer.put(static_cast<char>(record.kind));
+        writer.put(static_cast<char>(record.negated ? 1 : 0));
+        write_field(writer,record.member);
+        write_field(writer,record.op);
+        write_field(writer,record.property);
+        write_field(writer,record.operand);
+        write_field(writer,record.phrase);
+    }
+
+    template <typename WriterT>
+    static void write_field(WriterT& writer, string_view value)
+    {
+        auto size=value.size();
+        while (size>=0x80)
+        {
+            writer.put(static_cast<char>((size&0x7F)|0x80));
+            size>>=7;
+        }
+        writer.put(static_cast<char>(size));
+        writer.write(value.data(),value.size());
+    }
+};
+constexpr binary_format_t binary_format{};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_STRUCTURED_FORMATS_HPP
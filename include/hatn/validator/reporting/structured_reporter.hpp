@@ -0,0 +1,528 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/reporting/structured_reporter.hpp
+*
+*  Defines reporter that writes failures as records of structured report.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_STRUCTURED_REPORTER_HPP
+#define HATN_VALIDATOR_STRUCTURED_REPORTER_HPP
+
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/to_string.hpp>
+#include <hatn/validator/operators/wrap_op.hpp>
+#include <hatn/validator/reporting/reporter.hpp>
+#include <hatn/validator/reporting/member_operand.hpp>
+#include <hatn/validator/reporting/buffered_writer.hpp>
+#include <hatn/validator/reporting/structured_formats.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+/**
+ * @brief Default helper to get ID of operator or property for structured report.
+ */
+template <typename T, typename =hana::when<true>>
+struct structured_id_t
+{
+    std::string operator() (const T& id) const
+    {
+        return to_string(id);
+    }
+};
+
+/**
+ * @brief Helper to get ID of wrapped operator with explicit string.
+ */
+template <typename T>
+struct structured_id_t<T,
+            hana::when<std::is_base_of<wrap_op_with_string_tag,T>::value>
+        >
+{
+    std::string operator() (const T& id) const
+    {
+        return std::string(id.str());
+    }
+};
+
+template <typename T>
+std::string structured_id(const T& id)
+{
+    return structured_id_t<T>{}(id);
+}
+
+/**
+ * @brief Default helper to format operand for structured report using operands formatter.
+ */
+template <typename T, typename =hana::when<true>>
+struct format_structured_operand_t
+{
+    template <typename FormatterT, typename T1>
+    void operator() (std::string& dst, const FormatterT& formatter, T1&& b) const
+    {
+        backend_formatter.append(dst,formatter._operands(std::forward<T1>(b)));
+    }
+};
+
+/**
+ * @brief Helper to format operand for structured report when other member is used as operand.
+ */
+template <typename T>
+struct format_structured_operand_t<T,
+            hana::when<hana::is_a<member_operand_tag,T>>
+        >
+{
+    template <typename FormatterT, typename T1>
+    void operator() (std::string& dst, const FormatterT&, T1&& b) const
+    {
+        dst=dotted_member_names(b.get());
+    }
+};
+
+template <typename FormatterT, typename T>
+void format_structured_operand(std::string& dst, const FormatterT& formatter, T&& b)
+{
+    dst.clear();
+    format_structured_operand_t<std::decay_t<T>>{}(dst,formatter,std::forward<T>(b));
+}
+
+}
+
+/**
+ * @brief Reporter that writes each failure as a record of structured report.
+ *
+ * Records contain member path, operator ID, property, operand and translated phrase,
+ * and are written by format object directly to destination container through buffered writer.
+ * Translated phrase is constructed with the same formatter that is used by text reporter.
+ *
+ * Records of aggregations that succeeded are discarded, so after validation the destination
+ * contains only records that explain the failure. If a check is under logical NOT then the record is marked as negated.
+ *
+ * Destination must be a contiguous resizable container, e.g. std::string or std::vector<uint8_t>.
+ */
+template <typename DstT, typename FormatT, typename FormatterT>
+class structured_reporter
+{
+    public:
+
+        using hana_tag=reporter_tag;
+
+        /**
+         * @brief Constructor.
+         * @param dst Destination container.
+         * @param format Format of records.
+         * @param formatter Formatter to use for phrases and operands formatting.
+         */
+        structured_reporter(
+                    DstT& dst,
+                    FormatT format,
+                    FormatterT&& formatter
+                ) : _writer(dst),
+                    _format(std::move(format)),
+                    _formatter(std::forward<FormatterT>(formatter)),
+                    _not_count(0),
+                    _explicit_reporting_count(0)
+        {}
+
+        void reset()
+        {
+            _not_count=0;
+            _explicit_reporting_count=0;
+            _stack.clear();
+        }
+
+        /**
+         * @brief Open validation step for aggregation operator.
+         * @param aggregation Descriptor of aggregation operator.
+         */
+        template <typename AggregationT>
+        void aggregate_open(AggregationT&& aggregation)
+        {
+            if (skip_aggregate_open() || skip_explicit_report())
+            {
+                return;
+            }
+            if (aggregation.id==aggregation_id::NOT)
+            {
+                ++_not_count;
+            }
+            _stack.push_back(level{aggregation.id,_writer.size(),0,0});
+        }
+
+        /**
+         * @brief Open validation step for aggregation operator with member.
+         * @param aggregation Descriptor of aggregation operator.
+         * @param member Member the validation operation is performed for.
+         */
+        template <typename AggregationT, typename MemberT>
+        void aggregate_open(AggregationT&& aggregation, MemberT&&)
+        {
+            aggregate_open(std::forward<AggregationT>(aggregation));
+        }
+
+        /**
+         * @brief Close validation step for aggregation operator.
+         * @param ok Validation status of the aggregation operator.
+         */
+        void aggregate_close(bool ok)
+        {
+            if (skip_explicit_report())
+            {
+                return;
+            }
+            if (!_stack.empty())
+            {
+                auto& back=_stack.back();
+                if (skip_part())
+                {
+                    --back.any_all_count;
+                    if (back.any_all_count!=0)
+                    {
+                        return;
+                    }
+                }
+
+                auto not_count=_not_count;
+                if (back.id==aggregation_id::NOT)
+                {
+                    --_not_count;
+                }
+
+                // records of succeeded aggregation are kept only if some parent NOT can fail because of that
+                auto keep=!ok || (back.id==aggregation_id::NOT ? not_count>1 : not_count!=0);
+                auto records=back.records;
+                if (!keep)
+                {
+                    _writer.truncate(back.position);
+                }
+                _stack.pop_back();
+                if (keep && !_stack.empty())
+                {
+                    _stack.back().records+=records;
+                }
+            }
+        }
+
+        /**
+         *  @brief Report validation of object at one level without member nesting.
+         *  @param op Operator for validation.
+         *  @param b Sample argument for validation.
+         */
+        template <typename T2, typename OpT>
+        void validate_operator(const OpT& op, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member.clear();
+            _property.clear();
+            detail::format_structured_operand(_operand,_formatter,prepare_operand_for_formatter(op,b));
+            format_phrase([&](auto& dst){_formatter.validate_operator(dst,op,b);});
+            write_check(op);
+        }
+
+        /**
+         *  @brief Report validation of object's property at one level without member nesting.
+         *  @param prop Property to validate.
+         *  @param op Operator for validation.
+         *  @param b Sample argument for validation.
+         */
+        template <typename T2, typename OpT, typename PropT>
+        void validate_property(const PropT& prop, const OpT& op, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member.clear();
+            _property=detail::structured_id(prop);
+            detail::format_structured_operand(_operand,_formatter,prepare_operand_for_formatter(op,b));
+            format_phrase([&](auto& dst){_formatter.validate_property(dst,prop,op,b);});
+            write_check(op);
+        }
+
+        /**
+         *  @brief Report validation of existance of a member.
+         *  @param member Member descriptor.
+         *  @param b Boolean flag, when true check if member exists, when false check if member does not exist.
+         */
+        template <typename T2, typename OpT, typename MemberT>
+        void validate_exists(const MemberT& member, const OpT& op, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member=dotted_member_names(member);
+            _property.clear();
+            _operand.clear();
+            format_phrase([&](auto& dst){_formatter.validate_exists(dst,member,op,b);});
+            write_check(std::string(op.str(b)));
+        }
+
+        /**
+         *  @brief Report normal validation of a member.
+         *  @param member Member descriptor.
+         *  @param prop Property to validate.
+         *  @param op Operator for validation.
+         *  @param b Sample argument for validation.
+         */
+        template <typename T2, typename OpT, typename PropT, typename MemberT>
+        void validate(const MemberT& member, const PropT& prop, const OpT& op, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member=dotted_member_names(member);
+            _property=detail::structured_id(prop);
+            detail::format_structured_operand(_operand,_formatter,prepare_operand_for_formatter(op,b));
+            format_phrase([&](auto& dst){_formatter.validate(dst,member,prop,op,b);});
+            write_check(op);
+        }
+
+        template <typename MemberT>
+        void member_ok(const MemberT&)
+        {
+        }
+
+        /**
+         *  @brief Report validation using other member of the same object as a reference argument for validation.
+         *  @param member Member descriptor.
+         *  @param prop Property to validate.
+         *  @param op Operator for validation.
+         *  @param b Descriptor of sample member of the same object.
+         */
+        template <typename T2, typename OpT, typename PropT, typename MemberT>
+        void validate_with_other_member(const MemberT& member, const PropT& prop, const OpT& op, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member=dotted_member_names(member);
+            _property=detail::structured_id(prop);
+            _operand=dotted_member_names(b);
+            format_phrase([&](auto& dst){_formatter.validate_with_other_member(dst,member,prop,op,b);});
+            write_check(op);
+        }
+
+        /**
+         *  @brief Report validation using the same member of a Sample object.
+         *  @param member Member.
+         *  @param prop Property to validate.
+         *  @param op Operator for validation.
+         *  @param member_sample Member of sample object.
+         *  @param b Sample object whose member must be used as argument passed to validation operator.
+         */
+        template <typename T2, typename OpT, typename PropT, typename MemberT, typename MemberSampleT>
+        void validate_with_master_sample(const MemberT& member, const PropT& prop, const OpT& op, const MemberSampleT& member_sample, const T2& b)
+        {
+            if (skip_part() || skip_explicit_report())
+            {
+                return;
+            }
+            _member=dotted_member_names(member);
+            _property=detail::structured_id(prop);
+            _operand=dotted_member_names(member_sample);
+            format_phrase([&](auto& dst){_formatter.validate_with_master_sample(dst,member,prop,op,member_sample,b);});
+            write_check(op);
+        }
+
+        /**
+         * @brief Check if current validation step is within NOT operator.
+         * @return True if NOT aggregation operator is opened at any parent level.
+         */
+        bool current_not() const
+        {
+            return _not_count!=0;
+        }
+
+        /**
+         * @brief Begin report that uses reporting hint and ignores reportings from all next levels.
+         */
+        void begin_explicit_report()
+        {
+            ++_explicit_reporting_count;
+        }
+
+        /**
+         * @brief End report that uses reporting hint and ignores reportings from all next levels.
+         * @param description Reporting hint that overrides report of the current level.
+         */
+        void end_explicit_report(const std::string& description)
+        {
+            --_explicit_reporting_count;
+            if (skip_part())
+            {
+                return;
+            }
+            if (_explicit_reporting_count==0)
+            {
+                write_record(structured_record_kind::hint,string_view(),string_view(),string_view(),string_view(),description);
+            }
+        }
+
+        /**
+         * @brief Get destination container.
+         * @return Destination container.
+         */
+        DstT& destination() noexcept
+        {
+            return _writer.destination();
+        }
+
+    private:
+
+        struct level
+        {
+            aggregation_id id;
+            size_t position;
+            size_t records;
+            size_t any_all_count;
+        };
+
+        template <typename HandlerT>
+        void format_phrase(HandlerT&& handler)
+        {
+            _phrase.clear();
+            auto wrapper=wrap_backend_formatter(_phrase);
+            handler(wrapper);
+        }
+
+        template <typename OpT>
+        void write_check(const OpT& op)
+        {
+            auto id=detail::structured_id(op);
+            write_record(structured_record_kind::check,_member,id,_property,_operand,_phrase);
+        }
+
+        void write_record(structured_record_kind kind,
+                          string_view member,
+                          string_view op,
+                          string_view property,
+                          string_view operand,
+                          string_view phrase)
+        {
+            _format.write_record(_writer,structured_record{kind,(_not_count%2)!=0,member,op,property,operand,phrase});
+            _writer.flush();
+            if (!_stack.empty())
+            {
+                ++_stack.back().records;
+            }
+        }
+
+        bool skip_explicit_report() const noexcept
+        {
+            return _explicit_reporting_count!=0;
+        }
+
+        bool skip_part() const noexcept
+        {
+            if (!_stack.empty())
+            {
+                const auto& back=_stack.back();
+                if (back.id==aggregation_id::ANY
+                        ||
+                    back.id==aggregation_id::ALL
+                    )
+                {
+                    return back.records!=0;
+                }
+            }
+            return false;
+        }
+
+        bool skip_aggregate_open()
+        {
+            if (skip_part())
+            {
+                ++_stack.back().any_all_count;
+                return true;
+            }
+            return false;
+        }
+
+        buffered_writer<DstT> _writer;
+        FormatT _format;
+        FormatterT _formatter;
+        std::vector<level> _stack;
+        size_t _not_count;
+        size_t _explicit_reporting_count;
+
+        std::string _member;
+        std::string _property;
+        std::string _operand;
+        std::string _phrase;
+};
+
+/**
+ * @brief Make reporter that writes failures as JSON records.
+ * @param dst Destination container.
+ * @param formatter Formatter to use for phrases and operands formatting.
+ * @return Reporter.
+ */
+template <typename DstT, typename FormatterT>
+auto make_json_reporter(DstT& dst, FormatterT&& formatter)
+{
+    return structured_reporter<DstT,json_format_t,FormatterT>(dst,json_format,std::forward<FormatterT>(formatter));
+}
+
+/**
+ * @brief Make reporter that writes failures as JSON records using default formatter.
+ * @param dst Destination container.
+ * @return Reporter.
+ */
+template <typename DstT>
+auto make_json_reporter(DstT& dst)
+{
+    return make_json_reporter(dst,get_default_formatter());
+}
+
+/**
+ * @brief Make reporter that writes failures as records of compact binary format.
+ * @param dst Destination container.
+ * @param formatter Formatter to use for phrases and operands formatting.
+ * @return Reporter.
+ */
+template <typename DstT, typename FormatterT>
+auto make_binary_reporter(DstT& dst, FormatterT&& formatter)
+{
+    return structured_reporter<DstT,binary_format_t,FormatterT>(dst,binary_format,std::forward<FormatterT>(formatter));
+}
+
+/**
+ * @brief Make reporter that writes failures as records of compact binary format using default formatter.
+ * @param dst Destination container.
+ * @return Reporter.
+ */
+template <typename DstT>
+auto make_binary_reporter(DstT& dst)
+{
+    return make_binary_reporter(dst,get_default_formatter());
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_STRUCTURED_REPORTER_HPP
@@ -19,13 +19,17 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef HATN_VALIDATOR_TRANSLATOR_REPOSITORY_HPP
 #define HATN_VALIDATOR_TRANSLATOR_REPOSITORY_HPP
 
+#include <atomic>
+#include <cstdint>
 #include <locale>
 #include <string>
 #include <set>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
 #include <hatn/validator/reporting/translator.hpp>
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
@@ -42,6 +46,12 @@ HATN_VALIDATOR_NAMESPACE_BEGIN
  *
  * A translator should be added to the repository with the full list of all forms of locale names
  * this translator is suitable for. See example below.
+ *
+ * Translators are kept in immutable snapshots. Updates copy the current snapshot and publish the modified copy atomically,
+ * so translators can be reloaded while other threads use the repository and lookups never wait for an update to complete.
+ * Each thread caches the latest resolved locale together with the version of the repository. Lookups that hit the cache
+ * only compare versions and do not lock. Otherwise, the snapshot is loaded with std::atomic_load() of std::shared_ptr
+ * that can use an internal lock of the standard library for the time of copying the pointer.
 
 @code{.cpp}
 
@@ -57,6 +67,21 @@ class translator_repository
 {
     public:
 
+        /**
+         * @brief Transparent comparator of locale names.
+         */
+        struct locale_less
+        {
+            using is_transparent=void;
+
+            bool operator() (string_view left, string_view right) const noexcept
+            {
+                return left<right;
+            }
+        };
+
+        using translators_map=std::map<std::string,std::shared_ptr<translator>,locale_less>;
+
         /**
          * @brief Full constructor.
          * @param default_translator Default translator to be used if requested locale is not found.
@@ -64,9 +89,9 @@ class translator_repository
          */
         translator_repository(
                 std::shared_ptr<translator> default_translator,
-                std::map<std::string,std::shared_ptr<translator>> translators
-            ) : _default_translator(std::move(default_translator)),
-                _translators(std::move(translators))
+                const std::map<std::string,std::shared_ptr<translator>>& translators
+            ) : _snapshot(std::make_shared<snapshot>(std::move(default_translator),translators_map(translators.begin(),translators.end()))),
+                _version(next_version())
         {}
 
         /**
@@ -75,7 +100,8 @@ class translator_repository
          */
         translator_repository(
                 std::shared_ptr<translator> default_translator
-            ) : _default_translator(std::move(default_translator))
+            ) : _snapshot(std::make_shared<snapshot>(std::move(default_translator))),
+                _version(next_version())
         {}
 
         /**
@@ -83,32 +109,103 @@ class translator_repository
          * @param translators Map of translators.
          */
         translator_repository(
-                std::map<std::string,std::shared_ptr<translator>> translators
-            ) : _default_translator(std::make_shared<translator>()),
-                _translators(std::move(translators))
+                const std::map<std::string,std::shared_ptr<translator>>& translators
+            ) : _snapshot(std::make_shared<snapshot>(std::make_shared<translator>(),translators_map(translators.begin(),translators.end()))),
+                _version(next_version())
         {}
 
         /**
          * @brief Default consturctor.
          */
         translator_repository(
-            ) : _default_translator(std::make_shared<translator>())
+            ) : _snapshot(std::make_shared<snapshot>(std::make_shared<translator>())),
+                _version(next_version())
+        {}
+
+        /**
+         * @brief Copy constructor.
+         * @param other Repository to copy from.
+         *
+         * Snapshots of repository are immutable, so the copy shares the current snapshot with the other repository.
+         */
+        translator_repository(
+                const translator_repository& other
+            ) : _snapshot(other.load()),
+                _version(next_version())
         {}
 
+        /**
+         * @brief Copy assignment operator.
+         * @param other Repository to copy from.
+         * @return Reference to this repository.
+         */
+        translator_repository& operator= (const translator_repository& other)
+        {
+            if (this!=&other)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                publish(other.load());
+            }
+            return *this;
+        }
+
+        ~translator_repository()=default;
+
         /**
          * @brief Add translator to repository.
          * @param tr Translator.
          * @param locales Names of locales this translator can be used for.
+         *
+         * Can be called concurrently with find_translator().
          */
         void add_translator(
                 const std::shared_ptr<translator>& tr,
                 const std::set<std::string>& locales
             )
         {
-            for (auto&& it:locales)
-            {
-                _translators[it]=tr;
-            }
+            update(
+                [&tr,&locales](translators_map& translators, std::shared_ptr<translator>&)
+                {
+                    for (auto&& it:locales)
+                    {
+                        translators[it]=tr;
+                    }
+                }
+            );
+        }
+
+        /**
+         * @brief Replace all translators of repository at once.
+         * @param translators New map of translators.
+         *
+         * Can be called concurrently with find_translator(), e.g. to reload translations without pausing validation.
+         * Readers see either old or new set of translators but never a mix of them.
+         */
+        void reload(const std::map<std::string,std::shared_ptr<translator>>& translators)
+        {
+            update(
+                [&translators](translators_map& current, std::shared_ptr<translator>&)
+                {
+                    current=translators_map(translators.begin(),translators.end());
+                }
+            );
+        }
+
+        /**
+         * @brief Update translators of repository.
+         * @param handler Handler invoked with copies of translators map and default translator that can be modified.
+         *
+         * Modified copies are published atomically when the handler returns. Updates are serialized with a mutex,
+         * lookups do not use that mutex.
+         */
+        template <typename HandlerT>
+        void update(HandlerT&& handler)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto current=load();
+            auto next=std::make_shared<snapshot>(current->default_translator,current->translators);
+            handler(next->translators,next->default_translator);
+            publish(std::move(next));
         }
 
         /**
@@ -119,30 +216,76 @@ class translator_repository
          * First, it tries to find the most specific name of the locale.
          * The the name is repeatedly truncated down to the name of language only.
          * If still no translator is found then the default translator is returned.
+         *
+         * The latest resolved locale name is cached per thread with the version of the repository.
+         * If the repository was not updated since then, the lookup of the same locale neither locks nor loads the snapshot.
+         * The cache does not keep snapshots and translators alive.
          */
-        std::shared_ptr<translator> find_translator(std::string loc=std::locale().name()) const
+        std::shared_ptr<translator> find_translator(string_view loc) const
         {
-            size_t i=0;
-            while(!loc.empty() && i<3)
+            thread_local resolution_cache cache;
+
+            auto version=_version.load(std::memory_order_acquire);
+            if (cache.version==version && string_view(cache.locale)==loc)
             {
-                auto it=_translators.find(loc);
-                if (it!=_translators.end())
+                auto tr=cache.result.lock();
+                if (tr)
                 {
-                    return it->second;
+                    return tr;
                 }
-                std::string delimiter=(i++==0)?".":"_";
-                loc=loc.substr(0,loc.find(delimiter));
             }
-            return _default_translator;
+
+            auto tr=load()->resolve(loc);
+            cache.version=version;
+            cache.locale.assign(loc.data(),loc.size());
+            cache.result=tr;
+            return tr;
+        }
+
+        /**
+         * @brief Find translator for name of global locale.
+         * @param Translator suitable of global locale.
+         *
+         * Name of global locale is cached per thread, see global_locale_name().
+         */
+        std::shared_ptr<translator> find_translator() const
+        {
+            return find_translator(global_locale_name());
+        }
+
+        /**
+         * @brief Get name of global locale.
+         * @return Name of global locale.
+         *
+         * The name is cached per thread together with the global locale it was taken from.
+         * The cached name is used while the global locale is the same, the name is rebuilt only after std::locale::global() replaces it.
+         */
+        static const std::string& global_locale_name()
+        {
+            thread_local std::locale cached_locale=std::locale::classic();
+            thread_local std::string cached_name=cached_locale.name();
+
+            std::locale current;
+            if (!(current==cached_locale))
+            {
+                cached_name=current.name();
+                cached_locale=current;
+            }
+            return cached_name;
         }
 
         /**
          * @brief Set default translator.
          * @param default_translator Default translator.
          */
-        void set_default_translator(std::shared_ptr<translator> default_translator) noexcept
+        void set_default_translator(std::shared_ptr<translator> default_translator)
         {
-            _default_translator=std::move(default_translator);
+            update(
+                [&default_translator](translators_map&, std::shared_ptr<translator>& tr)
+                {
+                    tr=std::move(default_translator);
+                }
+            );
         }
 
         /**
@@ -151,21 +294,111 @@ class translator_repository
          */
         std::shared_ptr<translator> default_translator() const noexcept
         {
-            return _default_translator;
+            return load()->default_translator;
         }
 
         /**
          * @brief Clear repository.
          */
-        void clear() noexcept
+        void clear()
+        {
+            update(
+                [](translators_map& translators, std::shared_ptr<translator>&)
+                {
+                    translators.clear();
+                }
+            );
+        }
+
+        /**
+         * @brief Release translators that were replaced or removed from the repository.
+         *
+         * Formatters constructed from repository keep references to translators but not the translators themselves.
+         * Thus, the repository keeps replaced translators alive until this method is called.
+         * Each retired translator is kept only once and is not retired any more when it is added back to the repository,
+         * so the number of retired translators is limited by the number of distinct translators that were replaced.
+         * Call it only when formatters constructed before the latest update are not used any more.
+         */
+        void release_retired()
         {
-            _translators.clear();
+            std::lock_guard<std::mutex> lock(_mutex);
+            _retired.clear();
         }
 
     private:
 
-        std::shared_ptr<translator> _default_translator;
-        std::map<std::string,std::shared_ptr<translator>> _translators;
+        struct snapshot
+        {
+            snapshot(
+                    std::shared_ptr<translator> default_translator,
+                    translators_map translators=translators_map()
+                ) : default_translator(std::move(default_translator)),
+                    translators(std::move(translators))
+            {}
+
+            std::shared_ptr<translator> resolve(string_view loc) const
+            {
+                size_t i=0;
+                while(!loc.empty() && i<3)
+                {
+                    auto it=translators.find(loc);
+                    if (it!=translators.end())
+                    {
+                        return it->second;
+                    }
+                    auto delimiter=(i++==0)?'.':'_';
+                    loc=loc.substr(0,loc.find(delimiter));
+                }
+                return default_translator;
+            }
+
+            std::shared_ptr<translator> default_translator;
+            translators_map translators;
+        };
+
+        struct resolution_cache
+        {
+            uint64_t version=0;
+            std::string locale;
+            std::weak_ptr<translator> result;
+        };
+
+        /**
+         * @brief Get version for the next update, versions are unique for all repositories.
+         */
+        static uint64_t next_version() noexcept
+        {
+            static std::atomic<uint64_t> counter{0};
+            return ++counter;
+        }
+
+        std::shared_ptr<const snapshot> load() const noexcept
+        {
+            return std::atomic_load_explicit(&_snapshot,std::memory_order_acquire);
+        }
+
+        void publish(std::shared_ptr<const snapshot> next)
+        {
+            auto prev=std::atomic_exchange_explicit(&_snapshot,next,std::memory_order_acq_rel);
+            _version.store(next_version(),std::memory_order_release);
+
+            // keep translators of previous snapshot alive unless they are still used by the next snapshot
+            _retired.insert(prev->default_translator);
+            for (auto&& it:prev->translators)
+            {
+                _retired.insert(it.second);
+            }
+            _retired.erase(next->default_translator);
+            for (auto&& it:next->translators)
+            {
+                _retired.erase(it.second);
+            }
+        }
+
+        std::shared_ptr<const snapshot> _snapshot;
+        std::atomic<uint64_t> _version;
+        std::mutex _mutex;
+        std::set<std::shared_ptr<translator>> _retired;
 };
 
 //-------------------------------------------------------------
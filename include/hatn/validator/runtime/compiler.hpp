@@ -0,0 +1,979 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/runtime/compiler.hpp
+*
+*  Defines compiler of text rules to bytecode plan.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_RUNTIME_COMPILER_HPP
+#define HATN_VALIDATOR_RUNTIME_COMPILER_HPP
+
+#include <cctype>
+#include <cstdlib>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/interval.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/runtime/plan.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace runtime
+{
+
+namespace detail
+{
+
+//-------------------------------------------------------------
+
+enum class token_kind : uint8_t
+{
+    end,
+    identifier,
+    integer,
+    floating,
+    string,
+    punct
+};
+
+struct token
+{
+    token_kind kind=token_kind::end;
+    std::string text;
+    int64_t integer=0;
+    double floating=0.0;
+    size_t pos=0;
+};
+
+/**
+ * @brief Tokenizer of text rules.
+ */
+class tokenizer
+{
+    public:
+
+        explicit tokenizer(string_view text) : _text(text),_pos(0)
+        {}
+
+        std::vector<token> tokenize()
+        {
+            std::vector<token> tokens;
+            for (;;)
+            {
+                skip_spaces();
+                token t;
+                t.pos=_pos;
+                if (_pos==_text.size())
+                {
+                    tokens.push_back(t);
+                    break;
+                }
+
+                char c=_text[_pos];
+                if (std::isalpha(static_cast<unsigned char>(c)) || c=='_')
+                {
+                    auto begin=_pos;
+                    while (_pos<_text.size() && (std::isalnum(static_cast<unsigned char>(_text[_pos])) || _text[_pos]=='_'))
+                    {
+                        ++_pos;
+                    }
+                    t.kind=token_kind::identifier;
+                    t.text=std::string(_text.data()+begin,_pos-begin);
+                }
+                else if (std::isdigit(static_cast<unsigned char>(c)) || c=='-' || c=='+')
+                {
+                    read_number(t);
+                }
+                else if (c=='"')
+                {
+                    read_string(t);
+                }
+                else if (std::string("()[]{},^.").find(c)!=std::string::npos)
+                {
+                    t.kind=token_kind::punct;
+                    t.text=std::string(1,c);
+                    ++_pos;
+                }
+                else
+                {
+                    error("unexpected character");
+                }
+                tokens.push_back(std::move(t));
+            }
+            return tokens;
+        }
+
+    private:
+
+        void skip_spaces()
+        {
+            while (_pos<_text.size() && std::isspace(static_cast<unsigned char>(_text[_pos])))
+            {
+                ++_pos;
+            }
+        }
+
+        void read_number(token& t)
+        {
+            auto begin=_pos;
+            if (_text[_pos]=='-' || _text[_pos]=='+')
+            {
+                ++_pos;
+            }
+            bool is_floating=false;
+            while (_pos<_text.size())
+            {
+                char c=_text[_pos];
+                if (c=='.' || c=='e' || c=='E')
+                {
+                    is_floating=true;
+                    if ((c=='e' || c=='E') && _pos+1<_text.size() && (_text[_pos+1]=='-' || _text[_pos+1]=='+'))
+                    {
+                        ++_pos;
+                    }
+                }
+                else if (!std::isdigit(static_cast<unsigned char>(c)))
+                {
+                    break;
+                }
+                ++_pos;
+            }
+
+            std::string str(_text.data()+begin,_pos-begin);
+            char* end=nullptr;
+            if (is_floating)
+            {
+                t.kind=token_kind::floating;
+                t.floating=std::strtod(str.c_str(),&end);
+            }
+            else
+            {
+                t.kind=token_kind::integer;
+                t.integer=std::strtoll(str.c_str(),&end,10);
+            }
+            if (end!=str.c_str()+str.size() || str=="-" || str=="+")
+            {
+                _pos=begin;
+                error("invalid number");
+            }
+        }
+
+        void read_string(token& t)
+        {
+            t.kind=token_kind::string;
+            ++_pos;
+            while (_pos<_text.size() && _text[_pos]!='"')
+            {
+                char c=_text[_pos++];
+                if (c=='\\')
+                {
+                    if (_pos==_text.size())
+                    {
+                        break;
+                    }
+                    c=_text[_pos++];
+                    switch (c)
+                    {
+                        case 'n': c='\n'; break;
+                        case 't': c='\t'; break;
+                        case 'r': c='\r'; break;
+                        default: break;
+                    }
+                }
+                t.text.push_back(c);
+            }
+            if (_pos==_text.size())
+            {
+                error("unterminated string");
+            }
+            ++_pos;
+        }
+
+        [[noreturn]] void error(const char* msg) const
+        {
+            throw rule_error(std::string(msg)+" at position "+std::to_string(_pos));
+        }
+
+        string_view _text;
+        size_t _pos;
+};
+
+//-------------------------------------------------------------
+
+struct rule_key
+{
+    enum class kind_t : uint8_t
+    {
+        name,
+        index,
+        all,
+        any
+    };
+
+    kind_t kind;
+    std::string name;
+    uint32_t index;
+};
+
+using rule_path=std::vector<rule_key>;
+
+struct rule_operand
+{
+    operand_kind kind=operand_kind::integer;
+    bool boolean=false;
+    int64_t integer=0;
+    double floating=0.0;
+    std::string string;
+    interval_mode mode=interval_mode::closed;
+    rule_path path;
+    std::vector<rule_operand> elements;
+};
+
+struct rule_node
+{
+    enum class kind_t : uint8_t
+    {
+        check,
+        logical_and,
+        logical_or,
+        logical_not,
+        member, //!< Children are applied to member at path.
+        all, //!< Children are applied to each element.
+        any //!< Children are applied to each element.
+    };
+
+    kind_t kind;
+
+    rule_path path;
+    property_code property=property_code::value;
+    operator_code op=operator_code::eq;
+    rule_operand operand;
+
+    std::vector<std::unique_ptr<rule_node>> children;
+};
+
+using rule_node_ptr=std::unique_ptr<rule_node>;
+
+struct operator_name
+{
+    const char* name;
+    operator_code code;
+};
+
+constexpr const operator_name operator_names[]={
+    {"eq",operator_code::eq},
+    {"ne",operator_code::ne},
+    {"lt",operator_code::lt},
+    {"lte",operator_code::lte},
+    {"gt",operator_code::gt},
+    {"gte",operator_code::gte},
+    {"flag",operator_code::eq},
+    {"in",operator_code::in},
+    {"nin",operator_code::nin},
+    {"regex_match",operator_code::regex_match},
+    {"regex_nmatch",operator_code::regex_nmatch},
+    {"regex_contains",operator_code::regex_contains},
+    {"regex_ncontains",operator_code::regex_ncontains},
+    {"lex_eq",operator_code::lex_eq},
+    {"lex_ne",operator_code::lex_ne},
+    {"lex_lt",operator_code::lex_lt},
+    {"lex_lte",operator_code::lex_lte},
+    {"lex_gt",operator_code::lex_gt},
+    {"lex_gte",operator_code::lex_gte},
+    {"ilex_eq",operator_code::ilex_eq},
+    {"ilex_ne",operator_code::ilex_ne},
+    {"ilex_lt",operator_code::ilex_lt},
+    {"ilex_lte",operator_code::ilex_lte},
+    {"ilex_gt",operator_code::ilex_gt},
+    {"ilex_gte",operator_code::ilex_gte},
+    {"lex_contains",operator_code::lex_contains},
+    {"ilex_contains",operator_code::ilex_contains},
+    {"lex_starts_with",operator_code::lex_starts_with},
+    {"ilex_starts_with",operator_code::ilex_starts_with},
+    {"lex_ends_with",operator_code::lex_ends_with},
+    {"ilex_ends_with",operator_code::ilex_ends_with}
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Parser of text rules.
+ *
+ * Syntax of rules follows syntax of validators in C++ code:
+ * @code
+ *  _["field1"](gte,10),
+ *  _["field2"](value(lex_starts_with,"a") ^OR^ size(gte,5)),
+ *  _["field3"][ALL](in,interval(1,100,interval.open())),
+ *  _["field4"](eq,_["field1"])
+ * @endcode
+ */
+class parser
+{
+    public:
+
+        explicit parser(std::vector<token> tokens) : _tokens(std::move(tokens)),_pos(0),_depth(0)
+        {}
+
+        rule_node_ptr parse()
+        {
+            auto node=parse_list();
+            if (current().kind!=token_kind::end)
+            {
+                error("unexpected token");
+            }
+            return node;
+        }
+
+    private:
+
+        const token& current() const
+        {
+            return _tokens[_pos];
+        }
+
+        const token& peek(size_t offset=1) const
+        {
+            auto idx=_pos+offset;
+            return idx<_tokens.size()?_tokens[idx]:_tokens.back();
+        }
+
+        bool is_punct(const char* p) const
+        {
+            return current().kind==token_kind::punct && current().text==p;
+        }
+
+        bool is_identifier(const char* id) const
+        {
+            return current().kind==token_kind::identifier && current().text==id;
+        }
+
+        void expect(const char* p)
+        {
+            if (!is_punct(p))
+            {
+                error((std::string("expected \"")+p+"\"").c_str());
+            }
+            ++_pos;
+        }
+
+        [[noreturn]] void error(const char* msg) const
+        {
+            throw rule_error(std::string(msg)+" at position "+std::to_string(current().pos));
+        }
+
+        static rule_node_ptr make_node(rule_node::kind_t kind)
+        {
+            auto node=std::make_unique<rule_node>();
+            node->kind=kind;
+            return node;
+        }
+
+        static bool find_operator(const std::string& name, operator_code& code)
+        {
+            for (auto&& it:operator_names)
+            {
+                if (name==it.name)
+                {
+                    code=it.code;
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        bool is_operator_call() const
+        {
+            operator_code code;
+            return current().kind==token_kind::identifier && find_operator(current().text,code)
+                    && peek().kind==token_kind::punct && peek().text==",";
+        }
+
+        rule_node_ptr parse_list()
+        {
+            auto first=parse_expression();
+            if (!is_punct(","))
+            {
+                return first;
+            }
+            auto node=make_node(rule_node::kind_t::logical_and);
+            node->children.push_back(std::move(first));
+            while (is_punct(","))
+            {
+                ++_pos;
+                node->children.push_back(parse_expression());
+            }
+            return node;
+        }
+
+        rule_node_ptr parse_expression()
+        {
+            auto node=parse_term();
+            bool infix=false;
+            while (is_punct("^"))
+            {
+                ++_pos;
+                rule_node::kind_t kind;
+                if (is_identifier("AND"))
+                {
+                    kind=rule_node::kind_t::logical_and;
+                }
+                else if (is_identifier("OR"))
+                {
+                    kind=rule_node::kind_t::logical_or;
+                }
+                else
+                {
+                    error("expected AND or OR");
+                }
+                ++_pos;
+                expect("^");
+
+                auto right=parse_term();
+                if (infix && node->kind==kind)
+                {
+                    node->children.push_back(std::move(right));
+                }
+                else
+                {
+                    auto parent=make_node(kind);
+                    parent->children.push_back(std::move(node));
+                    parent->children.push_back(std::move(right));
+                    node=std::move(parent);
+                    infix=true;
+                }
+            }
+            return node;
+        }
+
+        rule_node_ptr parse_body()
+        {
+            expect("(");
+            auto node=is_operator_call()?parse_check(property_code::value):parse_list();
+            expect(")");
+            return node;
+        }
+
+        struct depth_guard
+        {
+            explicit depth_guard(parser* p) : self(p)
+            {
+                if (++self->_depth>plan_max_depth)
+                {
+                    self->error("too deep nesting of rules");
+                }
+            }
+
+            ~depth_guard()
+            {
+                --self->_depth;
+            }
+
+            parser* self;
+        };
+
+        rule_node_ptr parse_term()
+        {
+            depth_guard guard(this);
+            if (is_punct("("))
+            {
+                return parse_body();
+            }
+            if (current().kind!=token_kind::identifier)
+            {
+                error("expected rule");
+            }
+
+            const auto& id=current().text;
+            if (id=="_")
+            {
+                return parse_member();
+            }
+            if (id=="AND" || id=="OR" || id=="validator")
+            {
+                ++_pos;
+                auto node=make_node(id=="OR"?rule_node::kind_t::logical_or:rule_node::kind_t::logical_and);
+                expect("(");
+                node->children.push_back(parse_expression());
+                while (is_punct(","))
+                {
+                    ++_pos;
+                    node->children.push_back(parse_expression());
+                }
+                expect(")");
+                return node;
+            }
+            if (id=="NOT")
+            {
+                ++_pos;
+                auto node=make_node(rule_node::kind_t::logical_not);
+                node->children.push_back(parse_body());
+                return node;
+            }
+            if (id=="ALL" || id=="ANY")
+            {
+                ++_pos;
+                auto node=make_node(id=="ALL"?rule_node::kind_t::all:rule_node::kind_t::any);
+                node->children.push_back(parse_body());
+                return node;
+            }
+            if (id=="value" || id=="size" || id=="length" || id=="empty")
+            {
+                auto property=id=="value"?property_code::value
+                             :(id=="size"?property_code::size
+                             :(id=="length"?property_code::length:property_code::empty));
+                ++_pos;
+                expect("(");
+                auto node=parse_check(property);
+                expect(")");
+                return node;
+            }
+            if (is_operator_call())
+            {
+                return parse_check(property_code::value);
+            }
+            error("unknown rule");
+        }
+
+        rule_path parse_path(bool allow_aggregation)
+        {
+            ++_pos;
+            rule_path path;
+            while (is_punct("["))
+            {
+                ++_pos;
+                rule_key key;
+                key.index=0;
+                if (current().kind==token_kind::string)
+                {
+                    key.kind=rule_key::kind_t::name;
+                    key.name=current().text;
+                }
+                else if (current().kind==token_kind::integer && current().integer>=0 && current().integer<=UINT32_MAX)
+                {
+                    key.kind=rule_key::kind_t::index;
+                    key.index=static_cast<uint32_t>(current().integer);
+                }
+                else if (allow_aggregation && (is_identifier("ALL") || is_identifier("ANY")))
+                {
+                    key.kind=is_identifier("ALL")?rule_key::kind_t::all:rule_key::kind_t::any;
+                }
+                else
+                {
+                    error("invalid member key");
+                }
+                ++_pos;
+                expect("]");
+                path.push_back(std::move(key));
+            }
+            if (path.empty())
+            {
+                error("expected member key");
+            }
+            return path;
+        }
+
+        rule_node_ptr parse_member()
+        {
+            auto node=make_node(rule_node::kind_t::member);
+            node->path=parse_path(true);
+            node->children.push_back(parse_body());
+            return node;
+        }
+
+        rule_node_ptr parse_check(property_code property)
+        {
+            auto node=make_node(rule_node::kind_t::check);
+            node->property=property;
+            if (current().kind!=token_kind::identifier || !find_operator(current().text,node->op))
+            {
+                error("unknown operator");
+            }
+            ++_pos;
+            expect(",");
+            node->operand=parse_operand();
+            if (is_regex_operator(node->op))
+            {
+                if (node->operand.kind!=operand_kind::string)
+                {
+                    error("operand of regular expression must be a string");
+                }
+                node->operand.kind=operand_kind::regex;
+            }
+            if (!operand_fits(node->op,node->operand.kind))
+            {
+                error(node->op==operator_code::in || node->op==operator_code::nin
+                      ? "operand of in/nin must be an interval or a range"
+                      : "operand must be a scalar or a member");
+            }
+            return node;
+        }
+
+        rule_operand parse_operand()
+        {
+            rule_operand operand;
+            const auto& t=current();
+            switch (t.kind)
+            {
+                case token_kind::integer:
+                    operand.kind=operand_kind::integer;
+                    operand.integer=t.integer;
+                    ++_pos;
+                    return operand;
+
+                case token_kind::floating:
+                    operand.kind=operand_kind::floating;
+                    operand.floating=t.floating;
+                    ++_pos;
+                    return operand;
+
+                case token_kind::string:
+                    operand.kind=operand_kind::string;
+                    operand.string=t.text;
+                    ++_pos;
+                    return operand;
+
+                default:
+                    break;
+            }
+
+            if (is_identifier("true") || is_identifier("false"))
+            {
+                operand.kind=operand_kind::boolean;
+                operand.boolean=is_identifier("true");
+                ++_pos;
+                return operand;
+            }
+            if (is_identifier("_"))
+            {
+                operand.kind=operand_kind::member;
+                operand.path=parse_path(false);
+                return operand;
+            }
+            if (is_identifier("interval"))
+            {
+                ++_pos;
+                operand.kind=operand_kind::interval;
+                expect("(");
+                operand.elements.push_back(parse_scalar_operand());
+                expect(",");
+                operand.elements.push_back(parse_scalar_operand());
+                if (is_punct(","))
+                {
+                    ++_pos;
+                    operand.mode=parse_interval_mode();
+                }
+                expect(")");
+                return operand;
+            }
+            if (is_identifier("range"))
+            {
+                ++_pos;
+                operand.kind=operand_kind::set;
+                expect("(");
+                expect("{");
+                if (!is_punct("}"))
+                {
+                    operand.elements.push_back(parse_scalar_operand());
+                    while (is_punct(","))
+                    {
+                        ++_pos;
+                        operand.elements.push_back(parse_scalar_operand());
+                    }
+                }
+                expect("}");
+                expect(")");
+                return operand;
+            }
+            error("invalid operand");
+        }
+
+        rule_operand parse_scalar_operand()
+        {
+            auto operand=parse_operand();
+            if (operand.kind==operand_kind::interval || operand.kind==operand_kind::set)
+            {
+                error("operand must be a scalar or a member");
+            }
+            return operand;
+        }
+
+        interval_mode parse_interval_mode()
+        {
+            if (!is_identifier("interval"))
+            {
+                error("expected interval mode");
+            }
+            ++_pos;
+            expect(".");
+            if (current().kind!=token_kind::identifier)
+            {
+                error("expected interval mode");
+            }
+            auto name=current().text;
+            interval_mode mode;
+            if (name=="closed")
+            {
+                mode=interval_mode::closed;
+            }
+            else if (name=="open")
+            {
+                mode=interval_mode::open;
+            }
+            else if (name=="open_from")
+            {
+                mode=interval_mode::open_from;
+            }
+            else if (name=="open_to")
+            {
+                mode=interval_mode::open_to;
+            }
+            else
+            {
+                error("unknown interval mode");
+            }
+            ++_pos;
+            expect("(");
+            expect(")");
+            return mode;
+        }
+
+        std::vector<token> _tokens;
+        size_t _pos;
+        uint32_t _depth;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Generator of bytecode from parsed rules.
+ */
+class code_generator
+{
+    public:
+
+        explicit code_generator(plan& p) : _plan(p),_depth(0)
+        {}
+
+        void generate(const rule_node& root)
+        {
+            emit(root,rule_path());
+            _plan.add_instruction(opcode::end);
+        }
+
+    private:
+
+        void emit(const rule_node& node, const rule_path& prefix)
+        {
+            switch (node.kind)
+            {
+                case rule_node::kind_t::check:
+                {
+                    auto operand=add_operand(node.operand);
+                    auto path=add_path(prefix);
+                    _plan.add_instruction(opcode::check,path,operand,
+                                          static_cast<uint8_t>(node.op),static_cast<uint8_t>(node.property));
+                }
+                break;
+
+                case rule_node::kind_t::logical_and:
+                case rule_node::kind_t::logical_or:
+                {
+                    auto jump=node.kind==rule_node::kind_t::logical_and?opcode::jump_if_false:opcode::jump_if_true;
+                    std::vector<uint32_t> jumps;
+                    for (size_t i=0;i<node.children.size();i++)
+                    {
+                        emit(*node.children[i],prefix);
+                        if (i+1<node.children.size())
+                        {
+                            jumps.push_back(_plan.add_instruction(jump));
+                        }
+                    }
+                    auto target=static_cast<uint32_t>(_plan.instructions.size());
+                    for (auto&& idx:jumps)
+                    {
+                        _plan.instructions[idx].a=target;
+                    }
+                }
+                break;
+
+                case rule_node::kind_t::logical_not:
+                    emit(*node.children.front(),prefix);
+                    _plan.add_instruction(opcode::negate);
+                    break;
+
+                case rule_node::kind_t::all:
+                case rule_node::kind_t::any:
+                    emit_enter(node.kind==rule_node::kind_t::all?enter_mode::all:enter_mode::any,prefix,
+                               [&]{ emit(*node.children.front(),rule_path()); });
+                    break;
+
+                case rule_node::kind_t::member:
+                    emit_member(prefix,node.path.begin(),node.path.end(),*node.children.front());
+                    break;
+            }
+        }
+
+        void emit_member(const rule_path& prefix, rule_path::const_iterator begin, rule_path::const_iterator end, const rule_node& body)
+        {
+            // split path by ALL/ANY keys, each of them enters elements of preceding member
+            rule_path path=prefix;
+            for (auto it=begin;it!=end;++it)
+            {
+                if (it->kind==rule_key::kind_t::all || it->kind==rule_key::kind_t::any)
+                {
+                    emit_enter(it->kind==rule_key::kind_t::all?enter_mode::all:enter_mode::any,path,
+                               [&]{ emit_member(rule_path(),std::next(it),end,body); });
+                    return;
+                }
+                path.push_back(*it);
+            }
+
+            if (path.empty() || body.kind==rule_node::kind_t::check)
+            {
+                // single check is applied directly to the member
+                emit(body,path);
+            }
+            else
+            {
+                emit_enter(enter_mode::member,path,[&]{ emit(body,rule_path()); });
+            }
+        }
+
+        template <typename BodyT>
+        void emit_enter(enter_mode mode, const rule_path& path, BodyT&& body)
+        {
+            if (_depth==plan_max_depth)
+            {
+                throw rule_error("too deep nesting of members");
+            }
+            auto enter=_plan.add_instruction(opcode::enter,add_path(path),0,0,0,static_cast<uint8_t>(mode));
+            ++_depth;
+            body();
+            --_depth;
+            _plan.add_instruction(opcode::end);
+            _plan.instructions[enter].b=static_cast<uint32_t>(_plan.instructions.size());
+        }
+
+        uint32_t add_path(const rule_path& path)
+        {
+            std::vector<key_entry> keys;
+            keys.reserve(path.size());
+            for (auto&& key:path)
+            {
+                if (key.kind==rule_key::kind_t::name)
+                {
+                    auto offset=_plan.add_string(key.name);
+                    keys.push_back(key_entry{static_cast<uint32_t>(key_kind::name),offset,static_cast<uint32_t>(key.name.size())});
+                }
+                else
+                {
+                    keys.push_back(key_entry{static_cast<uint32_t>(key_kind::index),0,key.index});
+                }
+            }
+            return _plan.add_path(keys);
+        }
+
+        uint32_t add_operand(const rule_operand& operand)
+        {
+            operand_entry entry{static_cast<uint32_t>(operand.kind),0,0,0,0,0.0};
+            switch (operand.kind)
+            {
+                case operand_kind::boolean:
+                    entry.integer=operand.boolean?1:0;
+                    break;
+
+                case operand_kind::integer:
+                    entry.integer=operand.integer;
+                    break;
+
+                case operand_kind::floating:
+                    entry.floating=operand.floating;
+                    break;
+
+                case operand_kind::string:
+                    entry.a=_plan.add_string(operand.string);
+                    entry.b=static_cast<uint32_t>(operand.string.size());
+                    break;
+
+                case operand_kind::regex:
+                    entry.a=_plan.add_string(operand.string);
+                    entry.b=static_cast<uint32_t>(operand.string.size());
+                    entry.integer=_plan.regex_count++;
+                    break;
+
+                case operand_kind::member:
+                    entry.a=add_path(operand.path);
+                    break;
+
+                case operand_kind::interval:
+                    entry.a=add_operand(operand.elements[0]);
+                    entry.b=add_operand(operand.elements[1]);
+                    entry.flags=static_cast<uint32_t>(operand.mode);
+                    break;
+
+                case operand_kind::set:
+                {
+                    std::vector<operand_entry> elements;
+                    for (auto&& element:operand.elements)
+                    {
+                        // elements of set are kept contiguously, so nested operands are added before them
+                        auto idx=add_operand(element);
+                        elements.push_back(_plan.operands[idx]);
+                        _plan.operands.pop_back();
+                    }
+                    entry.a=static_cast<uint32_t>(_plan.operands.size());
+                    entry.b=static_cast<uint32_t>(elements.size());
+                    _plan.operands.insert(_plan.operands.end(),elements.begin(),elements.end());
+                }
+                break;
+            }
+            return _plan.add_operand(entry);
+        }
+
+        plan& _plan;
+        uint32_t _depth;
+};
+
+//-------------------------------------------------------------
+
+}
+
+/**
+ * @brief Compile text rules to plan.
+ * @param text Text of rules.
+ * @return Compiled plan.
+ *
+ * @throws rule_error if rules can not be parsed.
+ */
+inline plan compile(string_view text)
+{
+    detail::tokenizer tokenizer(text);
+    detail::parser parser(tokenizer.tokenize());
+    auto root=parser.parse();
+
+    plan p;
+    detail::code_generator generator(p);
+    generator.generate(*root);
+    return p;
+}
+
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_RUNTIME_COMPILER_HPP
@@ -0,0 +1,384 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/runtime/interpreter.hpp
+*
+*  Defines interpreter of bytecode plan of runtime rules.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_RUNTIME_INTERPRETER_HPP
+#define HATN_VALIDATOR_RUNTIME_INTERPRETER_HPP
+
+#include <regex>
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/interval.hpp>
+#include <hatn/validator/operators/comparison.hpp>
+#include <hatn/validator/operators/regex.hpp>
+#include <hatn/validator/operators/lexicographical.hpp>
+#include <hatn/validator/runtime/plan.hpp>
+#include <hatn/validator/runtime/object_view.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace runtime
+{
+
+namespace detail
+{
+
+//-------------------------------------------------------------
+
+template <typename OpT>
+bool compare_scalars(const OpT& op, const scalar& a, const scalar& b)
+{
+    if (a.kind==value_kind::integer && b.kind==value_kind::integer)
+    {
+        return op(a.integer,b.integer);
+    }
+    if ((a.kind==value_kind::integer || a.kind==value_kind::floating)
+        && (b.kind==value_kind::integer || b.kind==value_kind::floating))
+    {
+        auto x=a.kind==value_kind::integer?static_cast<double>(a.integer):a.floating;
+        auto y=b.kind==value_kind::integer?static_cast<double>(b.integer):b.floating;
+        return op(x,y);
+    }
+    if (a.kind==value_kind::string && b.kind==value_kind::string)
+    {
+        return op(a.string,b.string);
+    }
+    if (a.kind==value_kind::boolean && b.kind==value_kind::boolean)
+    {
+        return op(a.boolean,b.boolean);
+    }
+    return false;
+}
+
+template <typename OpT>
+bool compare_strings(const OpT& op, const scalar& a, const scalar& b)
+{
+    if (a.kind==value_kind::string && b.kind==value_kind::string)
+    {
+        return op(a.string,b.string);
+    }
+    return false;
+}
+
+template <typename OpT>
+bool match_regex(const OpT& op, const scalar& a, const std::regex& re)
+{
+    if (a.kind==value_kind::string)
+    {
+        return op(std::string(a.string.data(),a.string.size()),re);
+    }
+    return false;
+}
+
+/**
+ * @brief Interpreter of plan.
+ *
+ * All jumps of a valid plan go forward, so interpretation always terminates.
+ */
+class interpreter
+{
+    public:
+
+        interpreter(const plan_view& p, const std::vector<std::regex>& regexes, const object_view& root) noexcept
+            : _plan(p),_regexes(regexes),_root(root)
+        {}
+
+        bool run()
+        {
+            uint32_t pc=0;
+            return run_body(_root,pc);
+        }
+
+    private:
+
+        struct element_context
+        {
+            interpreter* self;
+            uint32_t body;
+            bool all;
+            bool result;
+        };
+
+        static bool run_element(void* ctx, const object_view& element)
+        {
+            auto context=static_cast<element_context*>(ctx);
+            uint32_t pc=context->body;
+            bool ok=context->self->run_body(element,pc);
+            if (context->all)
+            {
+                context->result=ok;
+                return ok;
+            }
+            context->result=ok;
+            return !ok;
+        }
+
+        bool run_body(const object_view& obj, uint32_t& pc)
+        {
+            bool acc=true;
+            while (pc<_plan.instruction_count)
+            {
+                const auto& ins=_plan.instructions[pc];
+                switch (static_cast<opcode>(ins.code))
+                {
+                    case opcode::check:
+                        acc=check(obj,ins);
+                        ++pc;
+                        break;
+
+                    case opcode::jump_if_false:
+                        pc=acc?pc+1:ins.a;
+                        break;
+
+                    case opcode::jump_if_true:
+                        pc=acc?ins.a:pc+1;
+                        break;
+
+                    case opcode::negate:
+                        acc=!acc;
+                        ++pc;
+                        break;
+
+                    case opcode::enter:
+                        acc=enter(obj,ins,pc+1);
+                        pc=ins.b;
+                        break;
+
+                    case opcode::end:
+                        ++pc;
+                        return acc;
+                }
+            }
+            return acc;
+        }
+
+        bool enter(const object_view& obj, const instruction& ins, uint32_t body)
+        {
+            object_view member;
+            if (!resolve(obj,ins.a,member))
+            {
+                return false;
+            }
+
+            auto mode=static_cast<enter_mode>(ins.mode);
+            if (mode==enter_mode::member)
+            {
+                return run_body(member,body);
+            }
+
+            // ALL of empty container is true, ANY of empty container is false
+            element_context ctx{this,body,mode==enter_mode::all,mode==enter_mode::all};
+            if (!member.for_each(&ctx,&run_element))
+            {
+                return false;
+            }
+            return ctx.result;
+        }
+
+        bool resolve(const object_view& obj, uint32_t path_index, object_view& out) const
+        {
+            const auto& path=_plan.paths[path_index];
+            out=obj;
+            for (uint32_t i=0;i<path.key_count;i++)
+            {
+                const auto& key=_plan.keys[path.first_key+i];
+                object_view next;
+                bool found=key.kind==static_cast<uint32_t>(key_kind::name)
+                            ? out.member(_plan.string(key.offset,key.length),next)
+                            : out.element(key.length,next);
+                if (!found)
+                {
+                    return false;
+                }
+                out=next;
+            }
+            return true;
+        }
+
+        bool property(const object_view& obj, property_code code, scalar& out) const
+        {
+            if (code==property_code::value)
+            {
+                out=obj.value();
+                return out.kind!=value_kind::none;
+            }
+
+            size_t size=0;
+            if (!obj.size(size))
+            {
+                return false;
+            }
+            out=code==property_code::empty?scalar::make_boolean(size==0):scalar::make_integer(static_cast<int64_t>(size));
+            return true;
+        }
+
+        bool operand(const operand_entry& entry, scalar& out) const
+        {
+            switch (static_cast<operand_kind>(entry.kind))
+            {
+                case operand_kind::boolean:
+                    out=scalar::make_boolean(entry.integer!=0);
+                    return true;
+
+                case operand_kind::integer:
+                    out=scalar::make_integer(entry.integer);
+                    return true;
+
+                case operand_kind::floating:
+                    out=scalar::make_floating(entry.floating);
+                    return true;
+
+                case operand_kind::string:
+                    out=scalar::make_string(_plan.string(entry.a,entry.b));
+                    return true;
+
+                case operand_kind::member:
+                {
+                    object_view member;
+                    if (!resolve(_root,entry.a,member))
+                    {
+                        return false;
+                    }
+                    out=member.value();
+                    return out.kind!=value_kind::none;
+                }
+
+                default:
+                    return false;
+            }
+        }
+
+        bool in(const scalar& a, const operand_entry& entry) const
+        {
+            scalar from,to;
+            switch (static_cast<operand_kind>(entry.kind))
+            {
+                case operand_kind::interval:
+                    if (!operand(_plan.operands[entry.a],from) || !operand(_plan.operands[entry.b],to))
+                    {
+                        return false;
+                    }
+                    switch (static_cast<interval_mode>(entry.flags))
+                    {
+                        case interval_mode::closed:
+                            return compare_scalars(gte,a,from) && compare_scalars(lte,a,to);
+                        case interval_mode::open:
+                            return compare_scalars(gt,a,from) && compare_scalars(lt,a,to);
+                        case interval_mode::open_from:
+                            return compare_scalars(gt,a,from) && compare_scalars(lte,a,to);
+                        case interval_mode::open_to:
+                            return compare_scalars(gte,a,from) && compare_scalars(lt,a,to);
+                    }
+                    return false;
+
+                case operand_kind::set:
+                    for (uint32_t i=0;i<entry.b;i++)
+                    {
+                        if (operand(_plan.operands[entry.a+i],from) && compare_scalars(eq,a,from))
+                        {
+                            return true;
+                        }
+                    }
+                    return false;
+
+                default:
+                    return false;
+            }
+        }
+
+        bool check(const object_view& obj, const instruction& ins) const
+        {
+            object_view member;
+            scalar a;
+            if (!resolve(obj,ins.a,member) || !property(member,static_cast<property_code>(ins.property),a))
+            {
+                return false;
+            }
+
+            const auto& entry=_plan.operands[ins.b];
+            auto op=static_cast<operator_code>(ins.op);
+            switch (op)
+            {
+                case operator_code::in:
+                    return in(a,entry);
+                case operator_code::nin:
+                    return !in(a,entry);
+
+                case operator_code::regex_match:
+                    return match_regex(regex_match,a,_regexes[entry.integer]);
+                case operator_code::regex_nmatch:
+                    return match_regex(regex_nmatch,a,_regexes[entry.integer]);
+                case operator_code::regex_contains:
+                    return match_regex(regex_contains,a,_regexes[entry.integer]);
+                case operator_code::regex_ncontains:
+                    return match_regex(regex_ncontains,a,_regexes[entry.integer]);
+
+                default:
+                    break;
+            }
+
+            scalar b;
+            if (!operand(entry,b))
+            {
+                return false;
+            }
+            switch (op)
+            {
+                case operator_code::eq: return compare_scalars(eq,a,b);
+                case operator_code::ne: return compare_scalars(ne,a,b);
+                case operator_code::lt: return compare_scalars(lt,a,b);
+                case operator_code::lte: return compare_scalars(lte,a,b);
+                case operator_code::gt: return compare_scalars(gt,a,b);
+                case operator_code::gte: return compare_scalars(gte,a,b);
+                case operator_code::lex_eq: return compare_strings(lex_eq,a,b);
+                case operator_code::lex_ne: return compare_strings(lex_ne,a,b);
+                case operator_code::lex_lt: return compare_strings(lex_lt,a,b);
+                case operator_code::lex_lte: return compare_strings(lex_lte,a,b);
+                case operator_code::lex_gt: return compare_strings(lex_gt,a,b);
+                case operator_code::lex_gte: return compare_strings(lex_gte,a,b);
+                case operator_code::ilex_eq: return compare_strings(ilex_eq,a,b);
+                case operator_code::ilex_ne: return compare_strings(ilex_ne,a,b);
+                case operator_code::ilex_lt: return compare_strings(ilex_lt,a,b);
+                case operator_code::ilex_lte: return compare_strings(ilex_lte,a,b);
+                case operator_code::ilex_gt: return compare_strings(ilex_gt,a,b);
+                case operator_code::ilex_gte: return compare_strings(ilex_gte,a,b);
+                case operator_code::lex_contains: return compare_strings(lex_contains,a,b);
+                case operator_code::ilex_contains: return compare_strings(ilex_contains,a,b);
+                case operator_code::lex_starts_with: return compare_strings(lex_starts_with,a,b);
+                case operator_code::ilex_starts_with: return compare_strings(ilex_starts_with,a,b);
+                case operator_code::lex_ends_with: return compare_strings(lex_ends_with,a,b);
+                case operator_code::ilex_ends_with: return compare_strings(ilex_ends_with,a,b);
+                default: return false;
+            }
+        }
+
+        const plan_view& _plan;
+        const std::vector<std::regex>& _regexes;
+        object_view _root;
+};
+
+//-------------------------------------------------------------
+
+}
+
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_RUNTIME_INTERPRETER_HPP
@@ -0,0 +1,399 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/runtime/object_view.hpp
+*
+*  Defines type-erased view of objects validated by runtime rules.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_RUNTIME_OBJECT_VIEW_HPP
+#define HATN_VALIDATOR_RUNTIME_OBJECT_VIEW_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/get.hpp>
+#include <hatn/validator/check_contains.hpp>
+#include <hatn/validator/can_get.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+#include <hatn/validator/utils/is_container.hpp>
+#include <hatn/validator/utils/is_pair.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace runtime
+{
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Kind of scalar value.
+ */
+enum class value_kind : uint8_t
+{
+    none,
+    boolean,
+    integer,
+    floating,
+    string
+};
+
+/**
+ * @brief Scalar value of object or of operand.
+ */
+struct scalar
+{
+    value_kind kind=value_kind::none;
+    bool boolean=false;
+    int64_t integer=0;
+    double floating=0.0;
+    string_view string;
+
+    static scalar make_boolean(bool v) noexcept
+    {
+        scalar s;
+        s.kind=value_kind::boolean;
+        s.boolean=v;
+        return s;
+    }
+
+    static scalar make_integer(int64_t v) noexcept
+    {
+        scalar s;
+        s.kind=value_kind::integer;
+        s.integer=v;
+        return s;
+    }
+
+    static scalar make_floating(double v) noexcept
+    {
+        scalar s;
+        s.kind=value_kind::floating;
+        s.floating=v;
+        return s;
+    }
+
+    static scalar make_string(string_view v) noexcept
+    {
+        scalar s;
+        s.kind=value_kind::string;
+        s.string=v;
+        return s;
+    }
+};
+
+class object_view;
+
+/**
+ * @brief Callback invoked for each element of container, returns false to stop iterating.
+ */
+using element_handler=bool (*)(void* ctx, const object_view& element);
+
+/**
+ * @brief Table of operations of type-erased object view.
+ */
+struct object_view_vtable
+{
+    scalar (*value)(const void* obj);
+    bool (*member)(const void* obj, string_view key, object_view& out);
+    bool (*element)(const void* obj, size_t index, object_view& out);
+    bool (*size)(const void* obj, size_t& out);
+    bool (*for_each)(const void* obj, void* ctx, element_handler handler);
+};
+
+template <typename T>
+struct object_view_traits;
+
+/**
+ * @brief Type-erased view of object validated by runtime rules.
+ *
+ * Members are looked up by names or indexes known only at runtime using the same get() and check_contains()
+ * helpers as the default adapter does. Members that are returned by value, e.g. properties, can not be viewed.
+ */
+class object_view
+{
+    public:
+
+        /**
+         * @brief Default constructor of invalid view.
+         */
+        object_view() noexcept : _obj(nullptr),_vtable(nullptr)
+        {}
+
+        /**
+         * @brief Constructor.
+         * @param obj Object to view.
+         */
+        template <typename T>
+        explicit object_view(const T& obj) noexcept
+            : _obj(&obj),
+              _vtable(&object_view_traits<T>::vtable)
+        {}
+
+        /**
+         * @brief Check if view is valid.
+         */
+        explicit operator bool() const noexcept
+        {
+            return _vtable!=nullptr;
+        }
+
+        /**
+         * @brief Get scalar value of the object.
+         * @return Scalar value, its kind is none if the object is not scalar.
+         */
+        scalar value() const
+        {
+            return _vtable->value(_obj);
+        }
+
+        /**
+         * @brief Find member by name.
+         * @param key Name of the member.
+         * @param out View of found member.
+         * @return True if member was found.
+         */
+        bool member(string_view key, object_view& out) const
+        {
+            return _vtable->member(_obj,key,out);
+        }
+
+        /**
+         * @brief Find element by index.
+         * @param index Index of the element.
+         * @param out View of found element.
+         * @return True if element was found.
+         */
+        bool element(size_t index, object_view& out) const
+        {
+            return _vtable->element(_obj,index,out);
+        }
+
+        /**
+         * @brief Get size of container or string.
+         * @param out Size.
+         * @return True if the object has size.
+         */
+        bool size(size_t& out) const
+        {
+            return _vtable->size(_obj,out);
+        }
+
+        /**
+         * @brief Iterate over elements of container.
+         * @param ctx Context to pass to handler.
+         * @param handler Handler to invoke for each element.
+         * @return True if the object is a container.
+         */
+        bool for_each(void* ctx, element_handler handler) const
+        {
+            return _vtable->for_each(_obj,ctx,handler);
+        }
+
+    private:
+
+        const void* _obj;
+        const object_view_vtable* _vtable;
+};
+
+//-------------------------------------------------------------
+
+namespace detail
+{
+
+template <typename T>
+using is_string_like=std::integral_constant<bool,
+        std::is_convertible<const T&,string_view>::value
+    >;
+
+template <typename T, typename KeyT, typename=hana::when<true>>
+struct can_view_member : public std::false_type
+{
+};
+
+template <typename T, typename KeyT>
+struct can_view_member<T,KeyT,
+            hana::when<
+                can_get<const T&,KeyT>()
+                &&
+                !is_string_like<T>::value
+            >
+        > : public std::is_lvalue_reference<decltype(get(std::declval<const T&>(),std::declval<KeyT>()))>
+{
+};
+
+template <typename T>
+scalar view_value(const T&, std::false_type) noexcept
+{
+    return scalar();
+}
+
+template <typename T>
+scalar view_value(const T& obj, std::true_type) noexcept
+{
+    return hana::eval_if(
+        std::is_same<T,bool>{},
+        [&](auto&& _) { return scalar::make_boolean(_(obj)); },
+        [&](auto&&)
+        {
+            return hana::eval_if(
+                std::is_integral<T>{},
+                [&](auto&& _) { return scalar::make_integer(static_cast<int64_t>(_(obj))); },
+                [&](auto&&)
+                {
+                    return hana::eval_if(
+                        std::is_floating_point<T>{},
+                        [&](auto&& _) { return scalar::make_floating(static_cast<double>(_(obj))); },
+                        [&](auto&& _) { return scalar::make_string(string_view(_(obj))); }
+                    );
+                }
+            );
+        }
+    );
+}
+
+template <typename T>
+bool view_member(const T&, string_view, object_view&, std::false_type) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool view_member(const T& obj, string_view key, object_view& out, std::true_type)
+{
+    std::string k(key.data(),key.size());
+    if (!check_contains(obj,k))
+    {
+        return false;
+    }
+    out=object_view(get(obj,k));
+    return true;
+}
+
+template <typename T>
+bool view_element(const T&, size_t, object_view&, std::false_type) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool view_element(const T& obj, size_t index, object_view& out, std::true_type)
+{
+    if (!check_contains(obj,index))
+    {
+        return false;
+    }
+    out=object_view(get(obj,index));
+    return true;
+}
+
+template <typename T>
+bool view_size(const T&, size_t&, std::false_type) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool view_size(const T& obj, size_t& out, std::true_type)
+{
+    out=hana::eval_if(
+        is_string_like<T>{},
+        [&](auto&& _) { return string_view(_(obj)).size(); },
+        [&](auto&& _) { return static_cast<size_t>(_(obj).size()); }
+    );
+    return true;
+}
+
+template <typename T>
+bool view_for_each(const T&, void*, element_handler, std::false_type) noexcept
+{
+    return false;
+}
+
+template <typename T>
+bool view_for_each(const T& obj, void* ctx, element_handler handler, std::true_type)
+{
+    for (auto&& it:obj)
+    {
+        // elements of maps are values of pairs
+        const auto& element=hana::if_(
+            hana::bool_c<is_pair_t<std::decay_t<decltype(it)>>::value>,
+            [](const auto& v) -> decltype(auto) { return v.second; },
+            [](const auto& v) -> decltype(auto) { return v; }
+        )(it);
+        if (!handler(ctx,object_view(element)))
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+}
+
+/**
+ * @brief Traits of type-erased view of objects of given type.
+ */
+template <typename T>
+struct object_view_traits
+{
+    using is_scalar=std::integral_constant<bool,
+            std::is_arithmetic<T>::value || detail::is_string_like<T>::value
+        >;
+    using is_container=std::integral_constant<bool,
+            is_container_t<T>::value && !detail::is_string_like<T>::value
+        >;
+    using has_size=std::integral_constant<bool,
+            is_container::value || detail::is_string_like<T>::value
+        >;
+
+    static scalar value(const void* obj)
+    {
+        return detail::view_value(*static_cast<const T*>(obj),is_scalar{});
+    }
+
+    static bool member(const void* obj, string_view key, object_view& out)
+    {
+        return detail::view_member(*static_cast<const T*>(obj),key,out,detail::can_view_member<T,const std::string&>{});
+    }
+
+    static bool element(const void* obj, size_t index, object_view& out)
+    {
+        return detail::view_element(*static_cast<const T*>(obj),index,out,detail::can_view_member<T,const size_t&>{});
+    }
+
+    static bool size(const void* obj, size_t& out)
+    {
+        return detail::view_size(*static_cast<const T*>(obj),out,has_size{});
+    }
+
+    static bool for_each(const void* obj, void* ctx, element_handler handler)
+    {
+        return detail::view_for_each(*static_cast<const T*>(obj),ctx,handler,is_container{});
+    }
+
+    constexpr static const object_view_vtable vtable{&value,&member,&element,&size,&for_each};
+};
+template <typename T>
+constexpr const object_view_vtable object_view_traits<T>::vtable;
+
+//-------------------------------------------------------------
+
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_RUNTIME_OBJECT_VIEW_HPP
@@ -0,0 +1,659 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/runtime/plan.hpp
+*
+*  Defines bytecode plan of runtime rules and its binary representation.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_RUNTIME_PLAN_HPP
+#define HATN_VALIDATOR_RUNTIME_PLAN_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/utils/string_view.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+namespace runtime
+{
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Error of compiling or loading runtime rules.
+ */
+class rule_error : public std::runtime_error
+{
+    public:
+
+        using std::runtime_error::runtime_error;
+};
+
+/**
+ * @brief Codes of instructions.
+ */
+enum class opcode : uint8_t
+{
+    check, //!< Check property of member at path a with operator against operand b.
+    jump_if_false, //!< Jump to instruction a if result is false.
+    jump_if_true, //!< Jump to instruction a if result is true.
+    negate, //!< Negate result.
+    enter, //!< Run body following this instruction for member at path a and continue at instruction b.
+    end //!< End of plan or of body.
+};
+
+/**
+ * @brief Codes of operators.
+ */
+enum class operator_code : uint8_t
+{
+    eq,
+    ne,
+    lt,
+    lte,
+    gt,
+    gte,
+    in,
+    nin,
+    regex_match,
+    regex_nmatch,
+    regex_contains,
+    regex_ncontains,
+    lex_eq,
+    lex_ne,
+    lex_lt,
+    lex_lte,
+    lex_gt,
+    lex_gte,
+    ilex_eq,
+    ilex_ne,
+    ilex_lt,
+    ilex_lte,
+    ilex_gt,
+    ilex_gte,
+    lex_contains,
+    ilex_contains,
+    lex_starts_with,
+    ilex_starts_with,
+    lex_ends_with,
+    ilex_ends_with,
+
+    count
+};
+
+/**
+ * @brief Codes of properties.
+ */
+enum class property_code : uint8_t
+{
+    value,
+    size,
+    length,
+    empty,
+
+    count
+};
+
+/**
+ * @brief Modes of entering member.
+ */
+enum class enter_mode : uint8_t
+{
+    member, //!< Run body for the member.
+    all, //!< Run body for each element of the member, all must pass.
+    any, //!< Run body for each element of the member, at least one must pass.
+
+    count
+};
+
+/**
+ * @brief Kinds of keys of member paths.
+ */
+enum class key_kind : uint32_t
+{
+    name, //!< Key is a string.
+    index //!< Key is an index.
+};
+
+/**
+ * @brief Kinds of operands.
+ */
+enum class operand_kind : uint32_t
+{
+    boolean,
+    integer,
+    floating,
+    string,
+    interval, //!< Operands a and b are endpoints, flags keep interval_mode.
+    set, //!< Operands from a to a+b are elements of the set.
+    member, //!< Member of the object at path a.
+    regex //!< String of regular expression, integer keeps index of regular expression in the plan.
+};
+
+/**
+ * @brief Instruction of plan.
+ */
+struct instruction
+{
+    uint8_t code;
+    uint8_t op;
+    uint8_t property;
+    uint8_t mode;
+    uint32_t a;
+    uint32_t b;
+};
+
+/**
+ * @brief Member path in plan, keys from first_key to first_key+key_count.
+ */
+struct path_entry
+{
+    uint32_t first_key;
+    uint32_t key_count;
+};
+
+/**
+ * @brief Key of member path, names are kept in string table.
+ */
+struct key_entry
+{
+    uint32_t kind;
+    uint32_t offset;
+    uint32_t length;
+};
+
+/**
+ * @brief Operand in plan, strings are kept in string table.
+ */
+struct operand_entry
+{
+    uint32_t kind;
+    uint32_t flags;
+    uint32_t a;
+    uint32_t b;
+    int64_t integer;
+    double floating;
+};
+
+/**
+ * @brief Header of binary representation of plan.
+ *
+ * Header is followed by sections of operands, instructions, paths, keys and strings, each section is aligned by 8 bytes.
+ */
+struct plan_header
+{
+    char magic[4];
+    uint32_t version;
+    uint32_t instruction_count;
+    uint32_t path_count;
+    uint32_t key_count;
+    uint32_t operand_count;
+    uint32_t strings_size;
+    uint32_t regex_count;
+};
+
+constexpr const char plan_magic[4]={'H','V','R','P'};
+constexpr const uint32_t plan_version=1;
+
+/**
+ * @brief Maximum depth of nested rules and of nested enter instructions.
+ */
+constexpr const uint32_t plan_max_depth=64;
+
+/**
+ * @brief Check if operand is a scalar or a member.
+ * @param kind Kind of operand.
+ * @return True if operand can be compared with a value.
+ */
+inline bool is_scalar_operand(operand_kind kind) noexcept
+{
+    return kind==operand_kind::boolean || kind==operand_kind::integer || kind==operand_kind::floating
+            || kind==operand_kind::string || kind==operand_kind::member;
+}
+
+/**
+ * @brief Check if operator is a regular expression operator.
+ * @param op Operator.
+ * @return True if operator uses regular expression.
+ */
+inline bool is_regex_operator(operator_code op) noexcept
+{
+    return op==operator_code::regex_match || op==operator_code::regex_nmatch
+            || op==operator_code::regex_contains || op==operator_code::regex_ncontains;
+}
+
+/**
+ * @brief Check if kind of operand fits operator.
+ * @param op Operator.
+ * @param kind Kind of operand.
+ * @return True if regular expression operator has regular expression operand, in/nin operator has interval or set operand
+ * and any other operator has scalar or member operand.
+ */
+inline bool operand_fits(operator_code op, operand_kind kind) noexcept
+{
+    if (is_regex_operator(op))
+    {
+        return kind==operand_kind::regex;
+    }
+    if (op==operator_code::in || op==operator_code::nin)
+    {
+        return kind==operand_kind::interval || kind==operand_kind::set;
+    }
+    return is_scalar_operand(kind);
+}
+
+namespace detail
+{
+
+inline size_t plan_align(size_t size) noexcept
+{
+    return (size+7)&~static_cast<size_t>(7);
+}
+
+}
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Non-owning view of plan, e.g. of binary blob mapped to memory.
+ */
+class plan_view
+{
+    public:
+
+        plan_view() noexcept
+            : instructions(nullptr),
+              paths(nullptr),
+              keys(nullptr),
+              operands(nullptr),
+              strings(nullptr),
+              instruction_count(0),
+              path_count(0),
+              key_count(0),
+              operand_count(0),
+              strings_size(0),
+              regex_count(0)
+        {}
+
+        /**
+         * @brief Get string from string table.
+         * @param offset Offset of string.
+         * @param length Length of string.
+         * @return String.
+         */
+        string_view string(uint32_t offset, uint32_t length) const noexcept
+        {
+            return string_view(strings+offset,length);
+        }
+
+        /**
+         * @brief Make view of binary representation of plan.
+         * @param data Pointer to data, must be aligned by 8 bytes.
+         * @param size Size of data.
+         * @return View of plan.
+         *
+         * @throws rule_error if data is not a valid plan.
+         */
+        static plan_view from_buffer(const void* data, size_t size)
+        {
+            auto ptr=static_cast<const char*>(data);
+            if (reinterpret_cast<uintptr_t>(ptr)%8!=0)
+            {
+                throw rule_error("buffer of runtime plan must be aligned by 8 bytes");
+            }
+            if (size<sizeof(plan_header))
+            {
+                throw rule_error("buffer is too small for runtime plan");
+            }
+            auto header=reinterpret_cast<const plan_header*>(ptr);
+            if (std::memcmp(header->magic,plan_magic,sizeof(plan_magic))!=0 || header->version!=plan_version)
+            {
+                throw rule_error("unsupported format of runtime plan");
+            }
+
+            plan_view view;
+            size_t offset=detail::plan_align(sizeof(plan_header));
+            auto section=[&](size_t count, size_t element_size)
+            {
+                auto begin=offset;
+                if (count>(size-offset)/(element_size==0?1:element_size))
+                {
+                    throw rule_error("runtime plan is truncated");
+                }
+                offset=detail::plan_align(offset+count*element_size);
+                if (offset>size)
+                {
+                    offset=size;
+                }
+                return ptr+begin;
+            };
+            view.operand_count=header->operand_count;
+            view.operands=reinterpret_cast<const operand_entry*>(section(header->operand_count,sizeof(operand_entry)));
+            view.instruction_count=header->instruction_count;
+            view.instructions=reinterpret_cast<const instruction*>(section(header->instruction_count,sizeof(instruction)));
+            view.path_count=header->path_count;
+            view.paths=reinterpret_cast<const path_entry*>(section(header->path_count,sizeof(path_entry)));
+            view.key_count=header->key_count;
+            view.keys=reinterpret_cast<const key_entry*>(section(header->key_count,sizeof(key_entry)));
+            view.strings_size=header->strings_size;
+            view.strings=section(header->strings_size,1);
+            view.regex_count=header->regex_count;
+
+            view.check();
+            return view;
+        }
+
+        /**
+         * @brief Check consistency of plan.
+         *
+         * All references must be in bounds and all jumps must go forward, so that running the plan always terminates.
+         * Operands must fit operators, bodies of enter instructions must be nested within each other
+         * and their depth must not exceed plan_max_depth, so that running the plan never overflows the stack.
+         *
+         * @throws rule_error if plan is not consistent.
+         */
+        void check() const
+        {
+            auto fail=[](const char* msg)
+            {
+                throw rule_error(std::string("invalid runtime plan: ")+msg);
+            };
+
+            if (instruction_count==0 || static_cast<opcode>(instructions[instruction_count-1].code)!=opcode::end)
+            {
+                fail("plan must end with end instruction");
+            }
+            for (uint32_t i=0;i<key_count;i++)
+            {
+                const auto& key=keys[i];
+                if (key.kind==static_cast<uint32_t>(key_kind::name) && (key.offset>strings_size || key.length>strings_size-key.offset))
+                {
+                    fail("key out of string table");
+                }
+                if (key.kind>static_cast<uint32_t>(key_kind::index))
+                {
+                    fail("unknown kind of key");
+                }
+            }
+            for (uint32_t i=0;i<path_count;i++)
+            {
+                const auto& path=paths[i];
+                if (path.first_key>key_count || path.key_count>key_count-path.first_key)
+                {
+                    fail("path out of keys");
+                }
+            }
+            auto scalar_operand=[this](uint32_t idx)
+            {
+                return is_scalar_operand(static_cast<operand_kind>(operands[idx].kind));
+            };
+            uint32_t regex_operands=0;
+            for (uint32_t i=0;i<operand_count;i++)
+            {
+                const auto& operand=operands[i];
+                switch (static_cast<operand_kind>(operand.kind))
+                {
+                    case operand_kind::boolean:
+                    case operand_kind::integer:
+                    case operand_kind::floating:
+                        break;
+
+                    case operand_kind::string:
+                        if (operand.a>strings_size || operand.b>strings_size-operand.a)
+                        {
+                            fail("string operand out of string table");
+                        }
+                        break;
+
+                    case operand_kind::regex:
+                        if (operand.a>strings_size || operand.b>strings_size-operand.a
+                            || operand.integer<0 || static_cast<uint64_t>(operand.integer)>=regex_count)
+                        {
+                            fail("invalid regular expression operand");
+                        }
+                        ++regex_operands;
+                        break;
+
+                    case operand_kind::interval:
+                        if (operand.a>=i || operand.b>=i || operand.flags>3
+                            || !scalar_operand(operand.a) || !scalar_operand(operand.b))
+                        {
+                            fail("invalid interval operand");
+                        }
+                        break;
+
+                    case operand_kind::set:
+                        if (operand.a>i || operand.b>i-operand.a)
+                        {
+                            fail("invalid set operand");
+                        }
+                        for (uint32_t j=operand.a;j<operand.a+operand.b;j++)
+                        {
+                            if (!scalar_operand(j))
+                            {
+                                fail("invalid set operand");
+                            }
+                        }
+                        break;
+
+                    case operand_kind::member:
+                        if (operand.a>=path_count)
+                        {
+                            fail("member operand out of paths");
+                        }
+                        break;
+
+                    default:
+                        fail("unknown kind of operand");
+                }
+            }
+            if (regex_count>regex_operands)
+            {
+                fail("too many regular expressions");
+            }
+
+            // ends of bodies of enclosing enter instructions
+            std::vector<uint32_t> bodies;
+            for (uint32_t i=0;i<instruction_count;i++)
+            {
+                while (!bodies.empty() && i>=bodies.back())
+                {
+                    bodies.pop_back();
+                }
+                uint32_t body_end=bodies.empty()?instruction_count:bodies.back();
+
+                const auto& ins=instructions[i];
+                switch (static_cast<opcode>(ins.code))
+                {
+                    case opcode::check:
+                        if (ins.op>=static_cast<uint8_t>(operator_code::count)
+                            || ins.property>=static_cast<uint8_t>(property_code::count)
+                            || ins.a>=path_count || ins.b>=operand_count
+                            || !operand_fits(static_cast<operator_code>(ins.op),static_cast<operand_kind>(operands[ins.b].kind)))
+                        {
+                            fail("invalid check instruction");
+                        }
+                        break;
+
+                    case opcode::jump_if_false:
+                    case opcode::jump_if_true:
+                        if (ins.a<=i || ins.a>=body_end)
+                        {
+                            fail("invalid jump");
+                        }
+                        break;
+
+                    case opcode::enter:
+                        if (ins.mode>=static_cast<uint8_t>(enter_mode::count)
+                            || ins.a>=path_count || ins.b<=i+1 || ins.b>=body_end
+                            || static_cast<opcode>(instructions[ins.b-1].code)!=opcode::end)
+                        {
+                            fail("invalid enter instruction");
+                        }
+                        bodies.push_back(ins.b);
+                        if (bodies.size()>plan_max_depth)
+                        {
+                            fail("too deep nesting of enter instructions");
+                        }
+                        break;
+
+                    case opcode::negate:
+                    case opcode::end:
+                        break;
+
+                    default:
+                        fail("unknown instruction");
+                }
+            }
+        }
+
+        const instruction* instructions;
+        const path_entry* paths;
+        const key_entry* keys;
+        const operand_entry* operands;
+        const char* strings;
+
+        uint32_t instruction_count;
+        uint32_t path_count;
+        uint32_t key_count;
+        uint32_t operand_count;
+        uint32_t strings_size;
+        uint32_t regex_count;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Plan of runtime rules owning its data.
+ */
+class plan
+{
+    public:
+
+        /**
+         * @brief Add instruction.
+         * @return Index of instruction.
+         */
+        uint32_t add_instruction(opcode code, uint32_t a=0, uint32_t b=0, uint8_t op=0, uint8_t property=0, uint8_t mode=0)
+        {
+            instructions.push_back(instruction{static_cast<uint8_t>(code),op,property,mode,a,b});
+            return static_cast<uint32_t>(instructions.size()-1);
+        }
+
+        /**
+         * @brief Add string to string table.
+         * @return Offset of string.
+         */
+        uint32_t add_string(string_view str)
+        {
+            auto offset=static_cast<uint32_t>(strings.size());
+            strings.append(str.data(),str.size());
+            return offset;
+        }
+
+        /**
+         * @brief Add operand.
+         * @return Index of operand.
+         */
+        uint32_t add_operand(const operand_entry& operand)
+        {
+            operands.push_back(operand);
+            return static_cast<uint32_t>(operands.size()-1);
+        }
+
+        /**
+         * @brief Add path.
+         * @param path_keys Keys of path.
+         * @return Index of path.
+         */
+        uint32_t add_path(const std::vector<key_entry>& path_keys)
+        {
+            paths.push_back(path_entry{static_cast<uint32_t>(keys.size()),static_cast<uint32_t>(path_keys.size())});
+            keys.insert(keys.end(),path_keys.begin(),path_keys.end());
+            return static_cast<uint32_t>(paths.size()-1);
+        }
+
+        /**
+         * @brief Get view of the plan.
+         * @return View that is valid while the plan is not modified.
+         */
+        plan_view view() const noexcept
+        {
+            plan_view v;
+            v.instructions=instructions.data();
+            v.instruction_count=static_cast<uint32_t>(instructions.size());
+            v.paths=paths.data();
+            v.path_count=static_cast<uint32_t>(paths.size());
+            v.keys=keys.data();
+            v.key_count=static_cast<uint32_t>(keys.size());
+            v.operands=operands.data();
+            v.operand_count=static_cast<uint32_t>(operands.size());
+            v.strings=strings.data();
+            v.strings_size=static_cast<uint32_t>(strings.size());
+            v.regex_count=regex_count;
+            return v;
+        }
+
+        /**
+         * @brief Serialize plan to binary representation.
+         * @return Binary blob that can be saved to file and later mapped to memory and loaded with plan_view::from_buffer().
+         */
+        std::string serialize() const
+        {
+            plan_header header;
+            std::memcpy(header.magic,plan_magic,sizeof(plan_magic));
+            header.version=plan_version;
+            header.instruction_count=static_cast<uint32_t>(instructions.size());
+            header.path_count=static_cast<uint32_t>(paths.size());
+            header.key_count=static_cast<uint32_t>(keys.size());
+            header.operand_count=static_cast<uint32_t>(operands.size());
+            header.strings_size=static_cast<uint32_t>(strings.size());
+            header.regex_count=regex_count;
+
+            std::string blob;
+            auto append=[&blob](const void* data, size_t size)
+            {
+                blob.append(static_cast<const char*>(data),size);
+                blob.resize(detail::plan_align(blob.size()),'\0');
+            };
+            append(&header,sizeof(header));
+            append(operands.data(),operands.size()*sizeof(operand_entry));
+            append(instructions.data(),instructions.size()*sizeof(instruction));
+            append(paths.data(),paths.size()*sizeof(path_entry));
+            append(keys.data(),keys.size()*sizeof(key_entry));
+            append(strings.data(),strings.size());
+            return blob;
+        }
+
+        std::vector<instruction> instructions;
+        std::vector<path_entry> paths;
+        std::vector<key_entry> keys;
+        std::vector<operand_entry> operands;
+        std::string strings;
+        uint32_t regex_count=0;
+};
+
+//-------------------------------------------------------------
+
+}
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_RUNTIME_PLAN_HPP
@@ -0,0 +1,176 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/runtime_validator.hpp
+*
+*  Defines validator with rules loaded at runtime.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_RUNTIME_VALIDATOR_HPP
+#define HATN_VALIDATOR_RUNTIME_VALIDATOR_HPP
+
+#include <memory>
+#include <regex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/adapter.hpp>
+#include <hatn/validator/runtime/object_view.hpp>
+#include <hatn/validator/runtime/plan.hpp>
+#include <hatn/validator/runtime/compiler.hpp>
+#include <hatn/validator/runtime/interpreter.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+using runtime::rule_error;
+
+/**
+ * @brief Validator whose rules are loaded at runtime.
+ *
+ * Rules are written as text using the same syntax as validators in C++ code and compiled to compact bytecode.
+ * Compiled rules can be serialized to a binary blob and later loaded without parsing, e.g. from a file mapped to memory.
+ *
+ * Objects are validated through type-erased views, members are looked up with get() and check_contains() using
+ * names and indexes known only at runtime. Missing members and mismatching types fail validation.
+ * Runtime validator does not construct reports, only validation status is returned.
+ */
+class runtime_validator
+{
+    public:
+
+        /**
+         * @brief Compile validator from text rules.
+         * @param text Text of rules.
+         * @return Validator.
+         *
+         * @throws rule_error if rules are invalid.
+         */
+        static runtime_validator compile(string_view text)
+        {
+            auto owned=std::make_shared<runtime::plan>(runtime::compile(text));
+            owned->view().check();
+            runtime_validator v(owned->view());
+            v._owned=std::move(owned);
+            return v;
+        }
+
+        /**
+         * @brief Load validator from binary blob.
+         * @param data Pointer to blob, must be aligned by 8 bytes.
+         * @param size Size of blob.
+         * @return Validator.
+         *
+         * The blob is not copied and must outlive the validator.
+         *
+         * @throws rule_error if blob is invalid.
+         */
+        static runtime_validator load(const void* data, size_t size)
+        {
+            return runtime_validator(runtime::plan_view::from_buffer(data,size));
+        }
+
+        /**
+         * @brief Serialize compiled rules to binary blob.
+         * @return Blob that can be loaded with load().
+         */
+        std::string serialize() const
+        {
+            if (_owned)
+            {
+                return _owned->serialize();
+            }
+
+            runtime::plan p;
+            p.instructions.assign(_view.instructions,_view.instructions+_view.instruction_count);
+            p.paths.assign(_view.paths,_view.paths+_view.path_count);
+            p.keys.assign(_view.keys,_view.keys+_view.key_count);
+            p.operands.assign(_view.operands,_view.operands+_view.operand_count);
+            p.strings.assign(_view.strings,_view.strings_size);
+            p.regex_count=_view.regex_count;
+            return p.serialize();
+        }
+
+        /**
+         * @brief Get plan of compiled rules.
+         * @return View of the plan.
+         */
+        const runtime::plan_view& plan() const noexcept
+        {
+            return _view;
+        }
+
+        /**
+         * @brief Apply validator to object.
+         * @param obj Object to validate.
+         * @return Validation status.
+         */
+        template <typename T>
+        status apply(const T& obj,
+                     std::enable_if_t<!hana::is_a<adapter_tag,T>,void*> =nullptr
+                ) const
+        {
+            runtime::detail::interpreter interpreter(_view,_regexes,runtime::object_view(obj));
+            return interpreter.run();
+        }
+
+        /**
+         * @brief Apply validator to object wrapped into adapter.
+         * @param adapter Adapter.
+         * @return Validation status.
+         */
+        template <typename AdapterT>
+        status apply(AdapterT&& adapter,
+                     std::enable_if_t<hana::is_a<adapter_tag,AdapterT>,void*> =nullptr
+                ) const
+        {
+            return apply(adapter.traits().get());
+        }
+
+    private:
+
+        explicit runtime_validator(const runtime::plan_view& view) : _view(view)
+        {
+            _regexes.resize(_view.regex_count);
+            for (uint32_t i=0;i<_view.operand_count;i++)
+            {
+                const auto& operand=_view.operands[i];
+                if (operand.kind==static_cast<uint32_t>(runtime::operand_kind::regex))
+                {
+                    auto pattern=_view.string(operand.a,operand.b);
+                    try
+                    {
+                        _regexes[static_cast<size_t>(operand.integer)]=std::regex(pattern.begin(),pattern.end());
+                    }
+                    catch (const std::regex_error& e)
+                    {
+                        throw rule_error(std::string("invalid regular expression: ")+e.what());
+                    }
+                }
+            }
+        }
+
+        std::shared_ptr<const runtime::plan> _owned;
+        runtime::plan_view _view;
+        std::vector<std::regex> _regexes;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_RUNTIME_VALIDATOR_HPP
@@ -0,0 +1,454 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/sample_diff.hpp
+*
+*  Defines helpers for comparing containers with master samples in a single merge walk.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_SAMPLE_DIFF_HPP
+#define HATN_VALIDATOR_SAMPLE_DIFF_HPP
+
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/check_exists.hpp>
+#include <hatn/validator/operators/exists.hpp>
+#include <hatn/validator/operators/comparison.hpp>
+#include <hatn/validator/utils/unwrap_object.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Kind of difference between element of object and element of sample.
+ */
+enum class sample_diff_kind : int
+{
+    added, //!< Element exists in object but not in sample.
+    missing, //!< Element exists in sample but not in object.
+    changed //!< Element exists in both but the values do not match.
+};
+
+/**
+ * @brief Difference of a single element.
+ */
+template <typename KeyT>
+struct sample_diff_entry
+{
+    sample_diff_kind kind;
+    KeyT key;
+};
+
+/**
+ * @brief Differences between object and sample.
+ */
+template <typename KeyT>
+class sample_diff
+{
+    public:
+
+        using key_type=KeyT;
+        using entry_type=sample_diff_entry<KeyT>;
+
+        /**
+         * @brief Add difference.
+         * @param kind Kind of difference.
+         * @param key Key of element.
+         */
+        void add(sample_diff_kind kind, const KeyT& key)
+        {
+            _entries.push_back(entry_type{kind,key});
+        }
+
+        /**
+         * @brief Get differences in the order they were found.
+         * @return Differences.
+         */
+        const std::vector<entry_type>& entries() const noexcept
+        {
+            return _entries;
+        }
+
+        /**
+         * @brief Check if there are no differences.
+         * @return Operation result.
+         */
+        bool empty() const noexcept
+        {
+            return _entries.empty();
+        }
+
+        /**
+         * @brief Count differences of given kind.
+         * @param kind Kind of difference.
+         * @return Number of differences.
+         */
+        size_t count(sample_diff_kind kind) const noexcept
+        {
+            size_t n=0;
+            for (const auto& entry:_entries)
+            {
+                if (entry.kind==kind)
+                {
+                    ++n;
+                }
+            }
+            return n;
+        }
+
+        /**
+         * @brief Get keys of elements with differences of given kind.
+         * @param kind Kind of difference.
+         * @return Keys.
+         */
+        std::vector<KeyT> keys(sample_diff_kind kind) const
+        {
+            std::vector<KeyT> result;
+            for (const auto& entry:_entries)
+            {
+                if (entry.kind==kind)
+                {
+                    result.push_back(entry.key);
+                }
+            }
+            return result;
+        }
+
+        /**
+         * @brief Clear differences.
+         */
+        void clear() noexcept
+        {
+            _entries.clear();
+        }
+
+    private:
+
+        std::vector<entry_type> _entries;
+};
+
+namespace detail
+{
+
+/**
+ * @brief Check if container is ordered by keys.
+ */
+template <typename T, typename =hana::when<true>>
+struct is_ordered_container : public std::false_type
+{
+};
+
+template <typename T>
+struct is_ordered_container<T,
+            hana::when_valid<decltype(std::declval<const T&>().key_comp())>
+        > : public std::true_type
+{
+};
+
+/**
+ * @brief Check if object and sample are ordered by keys in the same way.
+ */
+template <typename ObjectT, typename SampleT, typename =hana::when<true>>
+struct is_same_order : public std::false_type
+{
+};
+
+template <typename ObjectT, typename SampleT>
+struct is_same_order<ObjectT,SampleT,
+            hana::when<is_ordered_container<ObjectT>::value && is_ordered_container<SampleT>::value>
+        > : public std::is_same<typename ObjectT::key_compare,typename SampleT::key_compare>
+{
+};
+
+/**
+ * @brief Walk ordered containers together in key order.
+ */
+template <typename ObjectT, typename SampleT, typename HandlerT>
+void walk_with_sample(const ObjectT& obj, const SampleT& sample, HandlerT& handler, std::true_type)
+{
+    using value_type=typename ObjectT::mapped_type;
+    using sample_value_type=typename SampleT::mapped_type;
+
+    auto comp=obj.key_comp();
+    auto it1=obj.begin();
+    auto it2=sample.begin();
+    while (it1!=obj.end() && it2!=sample.end())
+    {
+        bool next=true;
+        if (comp(it1->first,it2->first))
+        {
+            next=handler(it1->first,&it1->second,static_cast<const sample_value_type*>(nullptr));
+            ++it1;
+        }
+        else if (comp(it2->first,it1->first))
+        {
+            next=handler(it2->first,static_cast<const value_type*>(nullptr),&it2->second);
+            ++it2;
+        }
+        else
+        {
+            next=handler(it1->first,&it1->second,&it2->second);
+            ++it1;
+            ++it2;
+        }
+        if (!next)
+        {
+            return;
+        }
+    }
+    for (;it1!=obj.end();++it1)
+    {
+        if (!handler(it1->first,&it1->second,static_cast<const sample_value_type*>(nullptr)))
+        {
+            return;
+        }
+    }
+    for (;it2!=sample.end();++it2)
+    {
+        if (!handler(it2->first,static_cast<const value_type*>(nullptr),&it2->second))
+        {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Walk unordered containers: elements of object first, then elements that exist only in sample.
+ */
+template <typename ObjectT, typename SampleT, typename HandlerT>
+void walk_with_sample(const ObjectT& obj, const SampleT& sample, HandlerT& handler, std::false_type)
+{
+    using value_type=typename ObjectT::mapped_type;
+    using sample_value_type=typename SampleT::mapped_type;
+
+    for (const auto& it:obj)
+    {
+        auto found=sample.find(it.first);
+        if (!handler(it.first,&it.second,found==sample.end()?static_cast<const sample_value_type*>(nullptr):&found->second))
+        {
+            return;
+        }
+    }
+    for (const auto& it:sample)
+    {
+        if (obj.find(it.first)==obj.end())
+        {
+            if (!handler(it.first,static_cast<const value_type*>(nullptr),&it.second))
+            {
+                return;
+            }
+        }
+    }
+}
+
+template <typename ObjectT, typename SampleT, typename OpT>
+struct sample_diff_handler
+{
+    using key_type=typename ObjectT::key_type;
+
+    template <typename ValueT, typename SampleValueT>
+    bool operator() (const key_type& key, const ValueT* val, const SampleValueT* sample_val)
+    {
+        if (sample_val==nullptr)
+        {
+            kind=sample_diff_kind::added;
+        }
+        else if (val==nullptr)
+        {
+            kind=sample_diff_kind::missing;
+        }
+        else if (!op(*val,*sample_val))
+        {
+            kind=sample_diff_kind::changed;
+        }
+        else
+        {
+            return true;
+        }
+
+        if (diff!=nullptr)
+        {
+            diff->add(kind,key);
+            return true;
+        }
+        first_key=&key;
+        return false;
+    }
+
+    const OpT& op;
+    sample_diff<key_type>* diff;
+    const key_type* first_key;
+    sample_diff_kind kind;
+};
+
+}
+
+/**
+ * @brief Walk object and sample together invoking handler for each key.
+ * @param obj Object, a map-like container.
+ * @param sample Sample, a map-like container with the same key type.
+ * @param handler Handler invoked as handler(key,value_ptr,sample_value_ptr), where pointer is nullptr if element is absent.
+ *
+ * If both containers are ordered with the same type of key comparator then they are walked together in key order in a single pass,
+ * so the keys are compared only once and no lookups are performed.
+ * Otherwise, each element is looked up in the other container.
+ * The walk stops when handler returns false.
+ */
+template <typename ObjectT, typename SampleT, typename HandlerT>
+void walk_with_master_sample(const ObjectT& obj, const SampleT& sample, HandlerT&& handler)
+{
+    using ordered=std::integral_constant<bool,detail::is_same_order<ObjectT,SampleT>::value>;
+    detail::walk_with_sample(obj,sample,handler,ordered{});
+}
+
+/**
+ * @brief Find all differences between object and sample.
+ * @param obj Object, a map-like container.
+ * @param sample Sample, a map-like container with the same key type.
+ * @param op Operator to compare values of elements that exist in both containers.
+ * @return Differences.
+ */
+template <typename ObjectT, typename SampleT, typename OpT>
+auto diff_with_master_sample(const ObjectT& obj, const SampleT& sample, const OpT& op)
+{
+    sample_diff<typename ObjectT::key_type> diff;
+    detail::sample_diff_handler<ObjectT,SampleT,OpT> handler{op,&diff,nullptr,sample_diff_kind::added};
+    walk_with_master_sample(obj,sample,handler);
+    return diff;
+}
+
+/**
+ * @brief Find all differences between object and sample comparing values with eq operator.
+ * @param obj Object, a map-like container.
+ * @param sample Sample, a map-like container with the same key type.
+ * @return Differences.
+ */
+template <typename ObjectT, typename SampleT>
+auto diff_with_master_sample(const ObjectT& obj, const SampleT& sample)
+{
+    return diff_with_master_sample(obj,sample,eq);
+}
+
+/**
+ * @brief Validate that object does not differ from sample and put validation result to the last argument.
+ * @param obj Object, a map-like container.
+ * @param sample Sample, a map-like container with the same key type.
+ * @param op Operator to compare values of elements that exist in both containers.
+ * @param err Validation result.
+ *
+ * Walk stops at the first difference which is reported as if it was found by the following validators:
+ * - added element: _[key](exists,false);
+ * - missing element: _[key](exists,true);
+ * - changed element: _[key](op,_(sample)).
+ */
+template <typename ObjectT, typename SampleT, typename OpT>
+void validate_diff(const ObjectT& obj, const SampleT& sample, const OpT& op, error_report& err)
+{
+    err.reset();
+    detail::sample_diff_handler<ObjectT,SampleT,OpT> handler{op,nullptr,nullptr,sample_diff_kind::added};
+    walk_with_master_sample(obj,sample,handler);
+    if (handler.first_key==nullptr)
+    {
+        return;
+    }
+
+    const auto& key=*handler.first_key;
+    switch (handler.kind)
+    {
+        case (sample_diff_kind::added):
+            validate(obj,HATN_VALIDATOR_NAMESPACE::validator(_[key](exists,false)),err);
+            break;
+
+        case (sample_diff_kind::missing):
+            validate(obj,HATN_VALIDATOR_NAMESPACE::validator(_[key](exists,true)),err);
+            break;
+
+        case (sample_diff_kind::changed):
+            validate(obj,HATN_VALIDATOR_NAMESPACE::validator(_[key](op,_(sample))),err);
+            break;
+    }
+}
+
+/**
+ * @brief Validate that object does not differ from sample comparing values with eq operator and put validation result to the last argument.
+ * @param obj Object, a map-like container.
+ * @param sample Sample, a map-like container with the same key type.
+ * @param err Validation result.
+ */
+template <typename ObjectT, typename SampleT>
+void validate_diff(const ObjectT& obj, const SampleT& sample, error_report& err)
+{
+    validate_diff(obj,sample,eq,err);
+}
+
+/**
+ * @brief Validate that immutable members of object are unchanged comparing to previous version and put validation result to the last argument.
+ * @param obj Object, new version.
+ * @param sample Sample, previous version of the object.
+ * @param members Hana sequence of immutable members.
+ * @param err Validation result.
+ *
+ * A member must exist in object if and only if it exists in sample and it must be equal to the same member of sample.
+ * Validation stops at the first changed member.
+ */
+template <typename ObjectT, typename SampleT, typename MembersT>
+void validate_unchanged(const ObjectT& obj, const SampleT& sample, const MembersT& members, error_report& err)
+{
+    err.reset();
+    hana::for_each(
+        members,
+        [&](const auto& m)
+        {
+            if (!err)
+            {
+                const auto& member=unwrap_object(m);
+                validate(obj,
+                         HATN_VALIDATOR_NAMESPACE::validator(
+                            member(exists,check_exists(sample,member.path())),
+                            member(eq,_(sample))
+                         ),
+                         err
+                    );
+            }
+        }
+    );
+}
+
+/**
+ * @brief Validate that immutable members of object are unchanged comparing to previous version with exception if validation fails.
+ * @param obj Object, new version.
+ * @param sample Sample, previous version of the object.
+ * @param members Hana sequence of immutable members.
+ *
+ * @throws validation_error if validation fails.
+ */
+template <typename ObjectT, typename SampleT, typename MembersT>
+void validate_unchanged(const ObjectT& obj, const SampleT& sample, const MembersT& members)
+{
+    error_report err;
+    validate_unchanged(obj,sample,members,err);
+    if (err)
+    {
+        throw validation_error(err);
+    }
+}
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_SAMPLE_DIFF_HPP
@@ -0,0 +1,398 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/tracing/trace_adapter_impl.hpp
+*
+*  Defines implementation of trace adapter.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_TRACE_ADAPTER_IMPL_HPP
+#define HATN_VALIDATOR_TRACE_ADAPTER_IMPL_HPP
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/adapters/impl/default_adapter_impl.hpp>
+#include <hatn/validator/reporting/reporter.hpp>
+#include <hatn/validator/utils/has_reset.hpp>
+#include <hatn/validator/aggregation/aggregation.ipp>
+#include <hatn/validator/tracing/trace_recorder.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+struct trace_adapter_tag{};
+
+/**
+ * @brief Implementation of trace adapter.
+ *
+ * Each call is forwarded to the next adapter implementation and its result is appended to the trace recorder.
+ * Aggregations including element aggregations ALL/ANY are recorded as pairs of opening and closing records enclosing records of nested checks.
+ * Nodes of validator are identified by addresses of their operands and element aggregations by addresses of their keys in member paths,
+ * thus the validator must not be moved while the recorder is in use.
+ * Nodes evaluated within element aggregations are described once, positions of the elements are kept in records
+ * and appended to descriptions by trace_recorder::description() and trace_recorder::dump(), e.g. "each element of field2 must be equal to 0 [1]".
+ *
+ * Records are appended only if HATN_VALIDATOR_TRACE is defined, otherwise each call is just forwarded to the next adapter implementation.
+ */
+template <typename NextAdapterImplT>
+class trace_adapter_impl : public trace_adapter_tag
+{
+    public:
+
+        using base_tag=trace_adapter_tag;
+
+        template <typename ...Args>
+        trace_adapter_impl(
+            trace_recorder& recorder,
+            Args&&... args
+        ) : _recorder(&recorder),
+            _next_adapter_impl(std::forward<Args>(args)...)
+        {}
+
+        const auto& next_adapter_impl() const
+        {
+            return _next_adapter_impl;
+        }
+
+        auto& next_adapter_impl()
+        {
+            return _next_adapter_impl;
+        }
+
+        void reset()
+        {
+            auto self=this;
+            hana::eval_if(
+                has_reset(hana::template type_c<NextAdapterImplT>),
+                [&](auto _)
+                {
+                    _(self)->_next_adapter_impl.reset();
+                },
+                [](auto)
+                {}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT>
+        status validate_operator(AdapterT&& adpt, OpT&& op, T2&& b)
+        {
+            return trace(std::addressof(b),trace_event::validate_operator,
+                [&](){return _next_adapter_impl.validate_operator(adpt,op,b);},
+                [&](auto& r){r.validate_operator(op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT>
+        status validate_property(AdapterT&& adpt, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return trace(std::addressof(b),trace_event::validate_property,
+                [&](){return _next_adapter_impl.validate_property(adpt,prop,op,b);},
+                [&](auto& r){r.validate_property(prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename MemberT>
+        status validate_exists(AdapterT&& adpt, MemberT&& member, OpT&& op, T2&& b, bool from_check_member=false, bool already_failed=false)
+        {
+            if (from_check_member)
+            {
+                // implicit check of member existence is a part of checking the member
+                return _next_adapter_impl.validate_exists(adpt,member,op,b,from_check_member,already_failed);
+            }
+            return trace(std::addressof(b),trace_event::validate_exists,
+                [&](){return _next_adapter_impl.validate_exists(adpt,member,op,b,from_check_member,already_failed);},
+                [&](auto& r){r.validate_exists(member,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return trace(std::addressof(b),trace_event::validate,
+                [&](){return _next_adapter_impl.validate(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate(member,prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate_with_other_member(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return trace(std::addressof(b),trace_event::validate_with_other_member,
+                [&](){return _next_adapter_impl.validate_with_other_member(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate_with_other_member(member,prop,op,b);}
+            );
+        }
+
+        template <typename AdapterT, typename T2, typename OpT, typename PropT, typename MemberT>
+        status validate_with_master_sample(AdapterT&& adpt, MemberT&& member, PropT&& prop, OpT&& op, T2&& b)
+        {
+            return trace(std::addressof(b),trace_event::validate_with_master_sample,
+                [&](){return _next_adapter_impl.validate_with_master_sample(adpt,member,prop,op,b);},
+                [&](auto& r){r.validate_with_master_sample(member,prop,op,member,b);}
+            );
+        }
+
+        template <typename AdapterT, typename OpsT>
+        status validate_and(AdapterT&& adpt, OpsT&& ops)
+        {
+            return trace_aggregation(std::addressof(ops),"AND",
+                [&](){return _next_adapter_impl.validate_and(std::forward<AdapterT>(adpt),std::forward<OpsT>(ops));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpsT>
+        status validate_and(AdapterT&& adpt, MemberT&& member, OpsT&& ops)
+        {
+            return trace_aggregation(std::addressof(ops),"AND",
+                [&](){return _next_adapter_impl.validate_and(std::forward<AdapterT>(adpt),member,std::forward<OpsT>(ops));},
+                member
+            );
+        }
+
+        template <typename AdapterT, typename OpsT>
+        status validate_or(AdapterT&& adpt, OpsT&& ops)
+        {
+            return trace_aggregation(std::addressof(ops),"OR",
+                [&](){return _next_adapter_impl.validate_or(std::forward<AdapterT>(adpt),std::forward<OpsT>(ops));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpsT>
+        status validate_or(AdapterT&& adpt, MemberT&& member, OpsT&& ops)
+        {
+            return trace_aggregation(std::addressof(ops),"OR",
+                [&](){return _next_adapter_impl.validate_or(std::forward<AdapterT>(adpt),member,std::forward<OpsT>(ops));},
+                member
+            );
+        }
+
+        template <typename AdapterT, typename OpT>
+        status validate_not(AdapterT&& adpt, OpT&& op)
+        {
+            return trace_aggregation(std::addressof(op),"NOT",
+                [&](){return _next_adapter_impl.validate_not(std::forward<AdapterT>(adpt),std::forward<OpT>(op));}
+            );
+        }
+
+        template <typename AdapterT, typename MemberT, typename OpT>
+        status validate_not(AdapterT&& adpt, MemberT&& member, OpT&& op)
+        {
+            return trace_aggregation(std::addressof(op),"NOT",
+                [&](){return _next_adapter_impl.validate_not(std::forward<AdapterT>(adpt),member,std::forward<OpT>(op));},
+                member
+            );
+        }
+
+        /**
+         * @brief Record opening of element aggregation.
+         * @param id Address identifying the aggregation within validator.
+         * @param aggregation Aggregation string descriptor.
+         * @param path Path of member whose elements are aggregated.
+         */
+        template <typename AggregationT, typename PathT>
+        void element_aggregation_open(const void* id, const AggregationT& aggregation, const PathT& path)
+        {
+#ifdef HATN_VALIDATOR_TRACE
+            auto make_label=[&]()
+            {
+                return hana::eval_if(
+                    hana::is_empty(path),
+                    [&](auto&&)
+                    {
+                        return aggregation_label(aggregation.name);
+                    },
+                    [&](auto&& _)
+                    {
+                        return aggregation_label(aggregation.name,make_member(_(path)));
+                    }
+                );
+            };
+            _frames.push_back(element_frame{
+                _recorder->record(id,position(),trace_event::aggregation_open,status::code::success,make_label),
+                0,
+                false
+            });
+#else
+            std::ignore=id;
+            std::ignore=aggregation;
+            std::ignore=path;
+#endif
+        }
+
+        /**
+         * @brief Mark start of validation of next element of element aggregation.
+         * @param index Position of the element.
+         */
+        void element_aggregation_element(size_t index)
+        {
+#ifdef HATN_VALIDATOR_TRACE
+            if (!_frames.empty())
+            {
+                _frames.back().element=static_cast<uint32_t>(index);
+                _frames.back().indexed=true;
+            }
+#else
+            std::ignore=index;
+#endif
+        }
+
+        /**
+         * @brief Record closing of element aggregation.
+         * @param result Result of the aggregation.
+         */
+        void element_aggregation_close(status result)
+        {
+#ifdef HATN_VALIDATOR_TRACE
+            if (!_frames.empty())
+            {
+                auto node=_frames.back().node;
+                _frames.pop_back();
+                _recorder->record(node,position(),trace_event::aggregation_close,result.value());
+            }
+#else
+            std::ignore=result;
+#endif
+        }
+
+        trace_recorder& recorder() noexcept
+        {
+            return *_recorder;
+        }
+
+    private:
+
+        struct element_frame
+        {
+            uint32_t node;
+            uint32_t element;
+            bool indexed;
+        };
+
+        template <typename HandlerT, typename ReportT>
+        status trace(const void* id, trace_event event, HandlerT&& handler, ReportT&& report)
+        {
+#ifdef HATN_VALIDATOR_TRACE
+            auto st=status(handler());
+            _recorder->record(id,position(),event,st.value(),
+                [&]()
+                {
+                    std::string label;
+                    auto r=make_reporter(label);
+                    report(r);
+                    return label;
+                }
+            );
+            return st;
+#else
+            std::ignore=id;
+            std::ignore=event;
+            std::ignore=report;
+            return status(handler());
+#endif
+        }
+
+        template <typename HandlerT, typename ...Args>
+        status trace_aggregation(const void* id, const char* name, HandlerT&& handler, Args&&... member)
+        {
+#ifdef HATN_VALIDATOR_TRACE
+            auto make_label=[&]()
+            {
+                return aggregation_label(name,member...);
+            };
+            auto pos=position();
+            auto node=_recorder->record(id,pos,trace_event::aggregation_open,status::code::success,make_label);
+            auto st=status(handler());
+            _recorder->record(node,pos,trace_event::aggregation_close,st.value());
+            return st;
+#else
+            std::ignore=id;
+            std::ignore=name;
+            std::ignore=std::make_tuple(std::cref(member)...);
+            return status(handler());
+#endif
+        }
+
+        /**
+         * @brief Get position within enclosing element aggregations.
+         * @return Position of element of the innermost element aggregation and number of element aggregations.
+         */
+        trace_position position() const noexcept
+        {
+            trace_position pos;
+            for (const auto& frame:_frames)
+            {
+                if (frame.indexed)
+                {
+                    pos.element=frame.element;
+                    ++pos.level;
+                }
+            }
+            return pos;
+        }
+
+        static std::string aggregation_label(const char* name)
+        {
+            return name;
+        }
+
+        template <typename MemberT>
+        static std::string aggregation_label(const char* name, const MemberT& member)
+        {
+            return std::string(name)+" of "+get_default_formatter().member_to_string(member);
+        }
+
+        trace_recorder* _recorder;
+        NextAdapterImplT _next_adapter_impl;
+        std::vector<element_frame> _frames;
+};
+
+/**
+ * @brief Helper for recording element aggregations with trace adapter.
+ */
+template <typename AdapterT>
+struct aggregate_report<AdapterT,
+        hana::when<
+            std::is_base_of<trace_adapter_tag,typename std::decay_t<AdapterT>::type>::value
+        >>
+{
+    template <typename AdapterT1, typename AggregationT, typename PathT>
+    static void open(AdapterT1&& adapter, const void* id, AggregationT&& str, PathT&& path)
+    {
+        traits_of(adapter).element_aggregation_open(id,str,path);
+    }
+
+    template <typename AdapterT1>
+    static void element(AdapterT1&& adapter, size_t index)
+    {
+        traits_of(adapter).element_aggregation_element(index);
+    }
+
+    template <typename AdapterT1>
+    static void close(AdapterT1&& adapter, status ret)
+    {
+        traits_of(adapter).element_aggregation_close(ret);
+    }
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_TRACE_ADAPTER_IMPL_HPP
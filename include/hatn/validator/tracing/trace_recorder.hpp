@@ -0,0 +1,385 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/tracing/trace_recorder.hpp
+*
+*  Defines recorder of validation traces.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_TRACE_RECORDER_HPP
+#define HATN_VALIDATOR_TRACE_RECORDER_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Events of validation trace.
+ */
+enum class trace_event : uint8_t
+{
+    validate_operator,
+    validate_property,
+    validate_exists,
+    validate,
+    validate_with_other_member,
+    validate_with_master_sample,
+    aggregation_open,
+    aggregation_close
+};
+
+/**
+ * @brief Position of record within element aggregations ALL/ANY.
+ */
+struct trace_position
+{
+    constexpr static const uint32_t no_element=0xFFFFFFFF;
+
+    uint32_t element=no_element; //!< Position of element of the innermost enclosing element aggregation.
+    uint16_t level=0; //!< Number of enclosing element aggregations.
+};
+
+/**
+ * @brief Record of validation trace.
+ */
+struct trace_record
+{
+    uint64_t timestamp; //!< Nanoseconds since construction of recorder.
+    uint32_t node; //!< Index of node description.
+    uint32_t element; //!< Position of element of the innermost enclosing element aggregation or trace_position::no_element.
+    uint16_t level; //!< Number of enclosing element aggregations.
+    uint16_t depth; //!< Depth of nesting of aggregations.
+    trace_event event;
+    status::code result; //!< Result of check or of closed aggregation.
+};
+
+/**
+ * @brief Recorder of validation traces.
+ *
+ * Records are kept in preallocated ring buffer, when the buffer is full the oldest records are overwritten.
+ * Descriptions of validator nodes are constructed only once when a node is met for the first time and are kept in
+ * preallocated table, thus recording does not allocate memory once all nodes of validator were visited.
+ * Nodes evaluated within element aggregations ALL/ANY are described once, positions of elements are kept in records.
+ *
+ * Recorder must not be used by multiple threads at the same time.
+ */
+class trace_recorder
+{
+    public:
+
+        constexpr static const size_t default_capacity=4096;
+        constexpr static const size_t default_node_capacity=1024;
+
+        /**
+         * @brief Constructor.
+         * @param capacity Maximum number of records in ring buffer.
+         * @param sample_rate Record each sample_rate-th validation in apply_sampled(), 0 disables sampling.
+         * @param node_capacity Maximum number of described nodes.
+         */
+        explicit trace_recorder(
+                size_t capacity=default_capacity,
+                size_t sample_rate=1,
+                size_t node_capacity=default_node_capacity
+            ) : _records(capacity==0?1:capacity),
+                _count(0),
+                _nodes(node_capacity==0?1:node_capacity),
+                _depth(0),
+                _sample_rate(sample_rate),
+                _sample_counter(0),
+                _start(std::chrono::steady_clock::now())
+        {}
+
+        /**
+         * @brief Check if next validation must be traced.
+         * @return True for each sample_rate-th call.
+         */
+        bool sample() noexcept
+        {
+            if (_sample_rate==0)
+            {
+                return false;
+            }
+            return (_sample_counter++%_sample_rate)==0;
+        }
+
+        /**
+         * @brief Set sample rate.
+         * @param rate Record each rate-th validation, 0 disables sampling.
+         */
+        void set_sample_rate(size_t rate) noexcept
+        {
+            _sample_rate=rate;
+            _sample_counter=0;
+        }
+
+        /**
+         * @brief Record event of node identified by address.
+         * @param id Address identifying node within validator.
+         * @param position Position within enclosing element aggregations.
+         * @param event Event.
+         * @param result Result of check or of aggregation.
+         * @param make_label Callable returning description of the node, invoked only once for each node.
+         * @return Index of node.
+         */
+        template <typename MakeLabelT>
+        uint32_t record(const void* id, trace_position position, trace_event event, status::code result, MakeLabelT&& make_label)
+        {
+            auto idx=node(id,event==trace_event::aggregation_close?trace_event::aggregation_open:event,make_label);
+            record(idx,position,event,result);
+            return idx;
+        }
+
+        /**
+         * @brief Record event of known node.
+         * @param node Index of node returned by other record().
+         * @param position Position within enclosing element aggregations.
+         * @param event Event.
+         * @param result Result of check or of aggregation.
+         */
+        void record(uint32_t node, trace_position position, trace_event event, status::code result)
+        {
+            if (event==trace_event::aggregation_close && _depth!=0)
+            {
+                --_depth;
+            }
+
+            auto& rec=_records[_count%_records.size()];
+            rec.timestamp=static_cast<uint64_t>(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-_start).count()
+                    );
+            rec.node=node;
+            rec.element=position.element;
+            rec.level=position.level;
+            rec.depth=static_cast<uint16_t>(_depth);
+            rec.event=event;
+            rec.result=result;
+            ++_count;
+
+            if (event==trace_event::aggregation_open)
+            {
+                ++_depth;
+            }
+        }
+
+        /**
+         * @brief Get number of records kept in buffer.
+         */
+        size_t size() const noexcept
+        {
+            return _count<_records.size()?static_cast<size_t>(_count):_records.size();
+        }
+
+        /**
+         * @brief Get total number of recorded events including overwritten ones.
+         */
+        uint64_t total() const noexcept
+        {
+            return _count;
+        }
+
+        /**
+         * @brief Get record.
+         * @param index Index of record, 0 is the oldest record kept in buffer.
+         * @return Record.
+         */
+        const trace_record& at(size_t index) const
+        {
+            auto first=_count-size();
+            return _records[(first+index)%_records.size()];
+        }
+
+        /**
+         * @brief Get description of node.
+         * @param index Index of node.
+         * @return Description.
+         */
+        const std::string& label(uint32_t index) const
+        {
+            static const std::string unknown("<unknown>");
+            if (index>=_nodes.size())
+            {
+                return unknown;
+            }
+            return _nodes[index].label;
+        }
+
+        /**
+         * @brief Get description of node of record including positions of elements of enclosing element aggregations.
+         * @param index Index of record, 0 is the oldest record kept in buffer.
+         * @return Description, e.g. "each element of field2 must be equal to 0 [1]".
+         *
+         * Positions of elements of outer element aggregations are taken from preceding records,
+         * positions that were overwritten in ring buffer are replaced with "?".
+         */
+        std::string description(size_t index) const
+        {
+            const auto& rec=at(index);
+            std::vector<uint32_t> positions(rec.level,trace_position::no_element);
+            if (rec.level!=0)
+            {
+                positions.back()=rec.element;
+            }
+            size_t unknown=rec.level==0?0:rec.level-1;
+            for (size_t i=index;i>0 && unknown!=0;i--)
+            {
+                const auto& prev=at(i-1);
+                if (prev.level!=0 && prev.level<=unknown)
+                {
+                    positions[prev.level-1]=prev.element;
+                    unknown=prev.level-1;
+                }
+            }
+            return describe(rec,positions);
+        }
+
+        /**
+         * @brief Clear records.
+         */
+        void clear() noexcept
+        {
+            _count=0;
+            _depth=0;
+        }
+
+        /**
+         * @brief Dump records as a tree.
+         * @return Text with a line per record, nested records are indented.
+         */
+        std::string dump() const
+        {
+            std::ostringstream os;
+            if (_count>_records.size())
+            {
+                os<<"... "<<(_count-_records.size())<<" records overwritten\n";
+            }
+            std::vector<uint32_t> positions;
+            for (size_t i=0;i<size();i++)
+            {
+                const auto& rec=at(i);
+                os<<'['<<rec.timestamp<<" ns] "<<std::string(rec.depth*2,' ');
+                positions.resize(rec.level,trace_position::no_element);
+                if (rec.level!=0)
+                {
+                    positions.back()=rec.element;
+                }
+                auto name=describe(rec,positions);
+                switch (rec.event)
+                {
+                    case trace_event::aggregation_open:
+                        os<<name<<" {";
+                        break;
+
+                    case trace_event::aggregation_close:
+                        os<<"} "<<result_name(rec.result);
+                        break;
+
+                    default:
+                        os<<name<<": "<<result_name(rec.result);
+                        break;
+                }
+                os<<'\n';
+            }
+            return os.str();
+        }
+
+    private:
+
+        struct node_t
+        {
+            bool used=false;
+            const void* id=nullptr;
+            trace_event event=trace_event::validate;
+            std::string label;
+        };
+
+        std::string describe(const trace_record& rec, const std::vector<uint32_t>& positions) const
+        {
+            auto result=label(rec.node);
+            if (!positions.empty())
+            {
+                result+=" ";
+                for (auto pos:positions)
+                {
+                    result+=pos==trace_position::no_element?std::string("[?]"):"["+std::to_string(pos)+"]";
+                }
+            }
+            return result;
+        }
+
+        static const char* result_name(status::code result) noexcept
+        {
+            switch (result)
+            {
+                case status::code::success: return "success";
+                case status::code::fail: return "fail";
+                case status::code::ignore: return "ignore";
+            }
+            return "unknown";
+        }
+
+        template <typename MakeLabelT>
+        uint32_t node(const void* id, trace_event event, const MakeLabelT& make_label)
+        {
+            auto h=std::hash<const void*>()(id)^(static_cast<size_t>(event)*0xc2b2ae3d27d4eb4full);
+            auto size=_nodes.size();
+            for (size_t i=0;i<size;i++)
+            {
+                auto idx=(h+i)%size;
+                auto& n=_nodes[idx];
+                if (!n.used)
+                {
+                    n.used=true;
+                    n.id=id;
+                    n.event=event;
+                    n.label=make_label();
+                    return static_cast<uint32_t>(idx);
+                }
+                if (n.id==id && n.event==event)
+                {
+                    return static_cast<uint32_t>(idx);
+                }
+            }
+
+            // table is full
+            return static_cast<uint32_t>(-1);
+        }
+
+        std::vector<trace_record> _records;
+        uint64_t _count;
+
+        std::vector<node_t> _nodes;
+
+        size_t _depth;
+
+        size_t _sample_rate;
+        size_t _sample_counter;
+
+        std::chrono::steady_clock::time_point _start;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_TRACE_RECORDER_HPP
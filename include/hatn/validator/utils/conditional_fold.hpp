@@ -19,6 +19,8 @@ Distributed under the Boost Software License, Version 1.0.
 #ifndef HATN_VALIDATOR_CONDITIONAL_FOLD_HPP
 #define HATN_VALIDATOR_CONDITIONAL_FOLD_HPP
 
+#include <utility>
+
 #include <hatn/validator/config.hpp>
 #include <hatn/validator/ignore_compiler_warnings.hpp>
 
@@ -34,69 +36,79 @@ namespace detail {
 template <typename FoldableT>
 struct conditional_fold_t
 {
-    template <typename HandlerT, typename PredicateT>
-    static auto each(const FoldableT& foldable, const PredicateT& pred, const HandlerT& fn)
+    /*
+     * Elements are accessed by index instead of dropping the front of the foldable,
+     * so that the tail of the foldable is not copied on each step and handlers get references to elements
+     * kept in the foldable itself.
+     */
+
+    template <typename IndexT>
+    constexpr static auto is_last(IndexT)
+    {
+        using size_type=decltype(hana::size(std::declval<const FoldableT&>()));
+        return hana::bool_c<IndexT::value+1==size_type::value>;
+    }
+
+    template <typename HandlerT, typename PredicateT, typename IndexT=hana::size_t<0>>
+    static auto each(const FoldableT& foldable, const PredicateT& pred, const HandlerT& fn, IndexT index=IndexT{})
     {
-        auto res=fn(hana::front(foldable));
+        auto res=fn(hana::at(foldable,index));
         if (!pred(res))
         {
             return res;
         }
-        auto next=hana::drop_front(foldable);
         return hana::eval_if(
-            hana::is_empty(next),
+            is_last(index),
             [&](auto&&)
             {
                 return res;
             },
             [&](auto&& _)
             {
-                return conditional_fold_t<decltype(_(next))>::each(_(next),pred,fn);
+                return each(foldable,pred,fn,hana::plus(_(index),hana::size_c<1>));
             }
         );
     }
 
-    template <typename PredicateT, typename StateT, typename HandlerT>
-    static auto each_with_state(const FoldableT& foldable, const PredicateT& pred, StateT&& state, const HandlerT& fn)
+    template <typename PredicateT, typename StateT, typename HandlerT, typename IndexT=hana::size_t<0>>
+    static auto each_with_state(const FoldableT& foldable, const PredicateT& pred, StateT&& state, const HandlerT& fn, IndexT index=IndexT{})
     {
-        auto res=fn(state,hana::front(foldable));
+        auto res=fn(state,hana::at(foldable,index));
         if (!pred(res))
         {
             return res;
         }
-        auto next=hana::drop_front(foldable);
         return hana::eval_if(
-            hana::is_empty(next),
+            is_last(index),
             [&](auto&& _)
             {
                 return _(res);
             },
             [&](auto&& _)
             {
-                return conditional_fold_t<decltype(_(next))>::each_with_state(_(next),pred,_(res),fn);
+                return each_with_state(foldable,pred,_(res),fn,hana::plus(_(index),hana::size_c<1>));
             }
         );
     }
 
 HATN_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-    template <typename PredicateT, typename StateT, typename RetT, typename HandlerT>
-    static auto each_with_state_and_ret(const FoldableT& foldable, const PredicateT& pred, StateT&& state, RetT&& ret, const HandlerT& fn)
+    template <typename PredicateT, typename StateT, typename RetT, typename HandlerT, typename IndexT=hana::size_t<0>>
+    static auto each_with_state_and_ret(const FoldableT& foldable, const PredicateT& pred, StateT&& state, RetT&& ret, const HandlerT& fn, IndexT index=IndexT{})
     {
-        auto res=fn(state,hana::front(foldable));
+        auto res=fn(state,hana::at(foldable,index));
         if (!pred(res))
         {
             return ret;
         }
-        auto next=hana::drop_front(foldable);
         return hana::eval_if(
-            hana::is_empty(next),
+            is_last(index),
             [&](auto&& _)
             {
                 return _(res);
             },
             [&](auto&& _)
             {
-                return conditional_fold_t<decltype(_(next))>::each_with_state_and_ret(_(next),pred,_(res),_(ret),fn);
+                return each_with_state_and_ret(foldable,pred,_(res),_(ret),fn,hana::plus(_(index),hana::size_c<1>));
             }
         );
     }
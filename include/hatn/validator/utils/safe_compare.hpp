@@ -631,7 +631,7 @@ template <typename LeftT, typename RightT>
 constexpr bool safe_compare_less_equal(const LeftT& a, const RightT& b)
 {
     return detail::safe_compare<unwrap_object_t<LeftT>,unwrap_object_t<RightT>>
-            ::less(unwrap_object(a),unwrap_object(b));
+            ::less_equal(unwrap_object(a),unwrap_object(b));
 }
 
 /**
@@ -0,0 +1,210 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/validate_incremental.hpp
+*
+*  Defines validate_incremental() helper.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_VALIDATE_INCREMENTAL_HPP
+#define HATN_VALIDATOR_VALIDATE_INCREMENTAL_HPP
+
+#include <vector>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/dependency_index.hpp>
+#include <hatn/validator/detail/incremental_node.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Result of incremental validation.
+ *
+ * Besides the overall status the result keeps statuses of all nodes of the validator
+ * so that it can be used as previous result for the next incremental validation.
+ * Nodes skipped by short-circuiting of logical aggregations are marked as not evaluated.
+ */
+class incremental_result
+{
+    public:
+
+        /**
+         * @brief Default constructor of empty result.
+         */
+        incremental_result()=default;
+
+        /**
+         * @brief Constructor.
+         * @param statuses Statuses of validator nodes.
+         * @param evaluated Flags of evaluated validator nodes.
+         */
+        incremental_result(std::vector<status> statuses, std::vector<bool> evaluated)
+            : _statuses(std::move(statuses)),
+              _evaluated(std::move(evaluated))
+        {}
+
+        /**
+         * @brief Get overall status of validation.
+         * @return Status of the root node.
+         */
+        status value() const noexcept
+        {
+            if (_statuses.empty())
+            {
+                return status(status::code::ignore);
+            }
+            return _statuses.front();
+        }
+
+        /**
+         * @brief Check if validation succeeded.
+         */
+        explicit operator bool() const noexcept
+        {
+            return static_cast<bool>(value());
+        }
+
+        /**
+         * @brief Get statuses of validator nodes.
+         * @return Statuses of nodes in order of depth-first traversal of the validator.
+         */
+        const std::vector<status>& node_statuses() const noexcept
+        {
+            return _statuses;
+        }
+
+        /**
+         * @brief Get flags of evaluated validator nodes.
+         * @return Flags in the same order as node_statuses(), status of a node that was not evaluated is meaningless.
+         */
+        const std::vector<bool>& node_evaluated() const noexcept
+        {
+            return _evaluated;
+        }
+
+        /**
+         * @brief Check if result is empty.
+         * @return True if validation was not performed yet.
+         */
+        bool empty() const noexcept
+        {
+            return _statuses.empty();
+        }
+
+    private:
+
+        std::vector<status> _statuses;
+        std::vector<bool> _evaluated;
+};
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Implementation of a helper to validate objects incrementally.
+ *
+ * Validator is split into nodes at logical aggregations AND/OR/NOT. Statuses of all nodes are cached in the result.
+ * When some members of the object change only the nodes that depend on the changed members are re-evaluated,
+ * statuses of the rest nodes are taken from the previous result and the aggregations are recombined.
+ *
+ * A node depends on the member it is applied to and on the members used as its operands. Nodes whose dependencies
+ * can not be figured out, e.g. validators with lazy operands or validators applied to the whole object,
+ * are re-evaluated on every change.
+ */
+struct validate_incremental_t
+{
+    /**
+     * @brief Validate object and cache statuses of validator nodes.
+     * @param obj Object to validate.
+     * @param validator Validator.
+     * @return Result of validation.
+     */
+    template <typename ObjectT, typename ValidatorT>
+    incremental_result operator() (
+            const ObjectT& obj,
+            const ValidatorT& validator
+        ) const
+    {
+        using node=detail::incremental_node<std::decay_t<ValidatorT>>;
+        std::vector<status> statuses(node::slots);
+        std::vector<bool> evaluated(node::slots,false);
+        std::vector<bool> affected;
+        detail::incremental_state state{affected,nullptr,nullptr,statuses,evaluated};
+        node::evaluate(validator,obj,0,state);
+        return incremental_result(std::move(statuses),std::move(evaluated));
+    }
+
+    /**
+     * @brief Re-validate object after some members changed.
+     * @param obj Object to validate.
+     * @param validator Validator, must be the same as used for previous result.
+     * @param changed_paths Foldable container of changed members or member paths, e.g. hana::make_tuple(_["field"]).
+     * @param previous_result Result of previous validation of the object.
+     * @return Result of validation.
+     */
+    template <typename ObjectT, typename ValidatorT, typename ChangedPathsT>
+    incremental_result operator() (
+            const ObjectT& obj,
+            const ValidatorT& validator,
+            const ChangedPathsT& changed_paths,
+            const incremental_result& previous_result
+        ) const
+    {
+        auto index=make_dependency_index(validator);
+        return (*this)(obj,validator,index,changed_paths,previous_result);
+    }
+
+    /**
+     * @brief Re-validate object after some members changed using prebuilt dependency index.
+     * @param obj Object to validate.
+     * @param validator Validator, must be the same as used for previous result.
+     * @param index Dependency index built for the validator with make_dependency_index().
+     * @param changed_paths Foldable container of changed members or member paths.
+     * @param previous_result Result of previous validation of the object.
+     * @return Result of validation.
+     */
+    template <typename ObjectT, typename ValidatorT, typename EntriesT, typename ChangedPathsT>
+    incremental_result operator() (
+            const ObjectT& obj,
+            const ValidatorT& validator,
+            const dependency_index<EntriesT>& index,
+            const ChangedPathsT& changed_paths,
+            const incremental_result& previous_result
+        ) const
+    {
+        using node=detail::incremental_node<std::decay_t<ValidatorT>>;
+        if (previous_result.node_statuses().size()!=node::slots)
+        {
+            return (*this)(obj,validator);
+        }
+
+        std::vector<status> statuses(node::slots);
+        std::vector<bool> evaluated(node::slots,false);
+        auto affected=index.affected(changed_paths);
+        detail::incremental_state state{affected,&previous_result.node_statuses(),&previous_result.node_evaluated(),statuses,evaluated};
+        node::evaluate(validator,obj,0,state);
+        return incremental_result(std::move(statuses),std::move(evaluated));
+    }
+};
+/**
+  @brief Callable for incremental validation.
+  */
+constexpr validate_incremental_t validate_incremental{};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_VALIDATE_INCREMENTAL_HPP
@@ -0,0 +1,342 @@
+/**
+@copyright Evgeny Sidorov 2020
+
+Distributed under the Boost Software License, Version 1.0.
+(See accompanying file LICENSE.md or copy at http://boost.org/LICENSE_1_0.txt)
+
+*/
+
+/****************************************************************************/
+
+/** @file validator/validation_cache.hpp
+*
+*  Defines cache of validation results.
+*
+*/
+
+/****************************************************************************/
+
+#ifndef HATN_VALIDATOR_VALIDATION_CACHE_HPP
+#define HATN_VALIDATOR_VALIDATION_CACHE_HPP
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <hatn/validator/config.hpp>
+#include <hatn/validator/status.hpp>
+#include <hatn/validator/error.hpp>
+#include <hatn/validator/validate.hpp>
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+//-------------------------------------------------------------
+
+/**
+ * @brief Cache of validation results keyed by validator and content of validated object.
+ *
+ * Results are looked up by the identity of the validator and the hash of the object, so that repeated objects
+ * cost one hash and one lookup instead of full validation. On hash match the cached copy of the object is compared
+ * with the validated object, thus hash collisions never lead to wrong results.
+ *
+ * Cache stores validation status and, if the object was validated with report, the report message.
+ * Cache has bounded size and the least recently used results are evicted when the size is exceeded.
+ * Cache can be shared between threads. Validation itself runs outside of the cache lock.
+ *
+ * Validators are identified by their types and ids supplied by the caller. Validators of the same type
+ * that are not equivalent, e.g. with different operands, must be given different ids.
+ * Addresses of validators are never used, so results can not be mixed up if a validator is destroyed
+ * and other one is constructed at the same address.
+ *
+ * @tparam ObjectT Type of objects to validate, must be copy constructible.
+ * @tparam HashT Hash function of objects.
+ * @tparam KeyEqualT Comparator of objects.
+ */
+template <typename ObjectT, typename HashT=std::hash<ObjectT>, typename KeyEqualT=std::equal_to<ObjectT>>
+class validation_cache
+{
+    public:
+
+        using object_type=ObjectT;
+        using hasher=HashT;
+        using key_equal=KeyEqualT;
+
+        constexpr static const size_t default_capacity=1024;
+
+        /**
+         * @brief Constructor.
+         * @param capacity Maximum number of cached results.
+         * @param hash Hash function of objects.
+         * @param equal Comparator of objects.
+         */
+        explicit validation_cache(
+                size_t capacity=default_capacity,
+                HashT hash=HashT(),
+                KeyEqualT equal=KeyEqualT()
+            ) : _capacity(capacity),
+                _hash(std::move(hash)),
+                _equal(std::move(equal)),
+                _hits(0),
+                _misses(0)
+        {}
+
+        /**
+         * @brief Apply validator to object or get cached result.
+         * @param validator Validator.
+         * @param validator_id Id of the validator among validators of the same type.
+         * @param obj Object to validate.
+         * @return Validation status.
+         */
+        template <typename ValidatorT>
+        status apply(const ValidatorT& validator, size_t validator_id, const ObjectT& obj)
+        {
+            auto id=make_identity<ValidatorT>(validator_id);
+            auto key=make_key(id,obj);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it=find(key,id,obj);
+                if (it!=_entries.end())
+                {
+                    ++_hits;
+                    return it->result;
+                }
+                ++_misses;
+            }
+
+            auto result=validator.apply(obj);
+            store(key,id,obj,result,std::string(),false);
+            return result;
+        }
+
+        /**
+         * @brief Validate object and put result to the last argument.
+         * @param obj Object to validate.
+         * @param validator Validator.
+         * @param validator_id Id of the validator among validators of the same type.
+         * @param err Error to put validation result to.
+         */
+        template <typename ValidatorT>
+        void validate(const ObjectT& obj, const ValidatorT& validator, size_t validator_id, error& err)
+        {
+            err.set_value(apply(validator,validator_id,obj));
+        }
+
+        /**
+         * @brief Validate object and put validation result with error description to the last argument.
+         * @param obj Object to validate.
+         * @param validator Validator.
+         * @param validator_id Id of the validator among validators of the same type.
+         * @param err Error to put validation result to.
+         *
+         * If the cached result of failed validation has no report then the object is validated once more with report.
+         */
+        template <typename ValidatorT>
+        void validate(const ObjectT& obj, const ValidatorT& validator, size_t validator_id, error_report& err)
+        {
+            auto id=make_identity<ValidatorT>(validator_id);
+            auto key=make_key(id,obj);
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it=find(key,id,obj);
+                if (it!=_entries.end() && (it->with_report || static_cast<bool>(it->result)))
+                {
+                    ++_hits;
+                    err=error_report(it->result,it->report);
+                    return;
+                }
+                ++_misses;
+            }
+
+            HATN_VALIDATOR_NAMESPACE::validate(obj,validator,err);
+            store(key,id,obj,err.value(),err.message(),true);
+        }
+
+        /**
+         * @brief Validate object and throw validation_error if validation fails.
+         * @param obj Object to validate.
+         * @param validator Validator.
+         * @param validator_id Id of the validator among validators of the same type.
+         *
+         * @throws validation_error if validation fails.
+         */
+        template <typename ValidatorT>
+        void validate(const ObjectT& obj, const ValidatorT& validator, size_t validator_id)
+        {
+            error_report err;
+            validate(obj,validator,validator_id,err);
+            if (err)
+            {
+                throw validation_error(err);
+            }
+        }
+
+        /**
+         * @brief Get number of cached results.
+         * @return Number of results.
+         */
+        size_t size() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _entries.size();
+        }
+
+        /**
+         * @brief Get maximum number of cached results.
+         * @return Capacity of the cache.
+         */
+        size_t capacity() const noexcept
+        {
+            return _capacity;
+        }
+
+        /**
+         * @brief Get number of lookups that found cached results.
+         * @return Number of hits.
+         */
+        size_t hits() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _hits;
+        }
+
+        /**
+         * @brief Get number of lookups that required validation.
+         * @return Number of misses.
+         */
+        size_t misses() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _misses;
+        }
+
+        /**
+         * @brief Remove all cached results.
+         */
+        void clear()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _index.clear();
+            _entries.clear();
+        }
+
+    private:
+
+        /**
+         * @brief Identity of validator.
+         */
+        struct identity
+        {
+            const void* type;
+            size_t id;
+
+            bool operator == (const identity& other) const noexcept
+            {
+                return type==other.type && id==other.id;
+            }
+        };
+
+        struct entry
+        {
+            size_t key;
+            identity validator;
+            ObjectT object;
+            status result;
+            std::string report;
+            bool with_report;
+        };
+
+        using entries_type=std::list<entry>;
+        using iterator=typename entries_type::iterator;
+
+        template <typename ValidatorT>
+        static identity make_identity(size_t validator_id) noexcept
+        {
+            // address of the token identifies the type of validators
+            static const char type_token=0;
+            return identity{&type_token,validator_id};
+        }
+
+        size_t make_key(const identity& validator, const ObjectT& obj) const
+        {
+            auto h=_hash(obj);
+            auto v=std::hash<const void*>()(validator.type);
+            h^=v+0x9e3779b9+(h<<6)+(h>>2);
+            return h^(std::hash<size_t>()(validator.id)+0x9e3779b9+(h<<6)+(h>>2));
+        }
+
+        iterator find(size_t key, const identity& validator, const ObjectT& obj)
+        {
+            auto range=_index.equal_range(key);
+            for (auto it=range.first;it!=range.second;++it)
+            {
+                auto entry_it=it->second;
+                if (entry_it->validator==validator && _equal(entry_it->object,obj))
+                {
+                    // move to the front as the most recently used
+                    _entries.splice(_entries.begin(),_entries,entry_it);
+                    return entry_it;
+                }
+            }
+            return _entries.end();
+        }
+
+        void store(size_t key, const identity& validator, const ObjectT& obj, status result, std::string report, bool with_report)
+        {
+            if (_capacity==0)
+            {
+                return;
+            }
+
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it=find(key,validator,obj);
+            if (it!=_entries.end())
+            {
+                // result could be stored by other thread or report was missing
+                it->result=result;
+                if (with_report)
+                {
+                    it->report=std::move(report);
+                    it->with_report=true;
+                }
+                return;
+            }
+
+            if (_entries.size()>=_capacity)
+            {
+                auto& last=_entries.back();
+                auto range=_index.equal_range(last.key);
+                for (auto idx=range.first;idx!=range.second;++idx)
+                {
+                    if (idx->second==std::prev(_entries.end()))
+                    {
+                        _index.erase(idx);
+                        break;
+                    }
+                }
+                _entries.pop_back();
+            }
+
+            _entries.push_front(entry{key,validator,obj,result,std::move(report),with_report});
+            _index.emplace(key,_entries.begin());
+        }
+
+        size_t _capacity;
+        HashT _hash;
+        KeyEqualT _equal;
+
+        mutable std::mutex _mutex;
+        entries_type _entries;
+        std::unordered_multimap<size_t,iterator> _index;
+        size_t _hits;
+        size_t _misses;
+};
+
+//-------------------------------------------------------------
+
+HATN_VALIDATOR_NAMESPACE_END
+
+#endif // HATN_VALIDATOR_VALIDATION_CACHE_HPP
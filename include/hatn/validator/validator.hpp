@@ -303,22 +303,91 @@ constexpr wrap_validator_on_heap new_validator{};
 
 /**
  * @brief Helper for wrapping validators in shared pointer.
+ *
+ * New validators are allocated together with control block of shared pointer.
  */
 struct shared_validator_t
 {
     template <typename ... Args>
     auto operator () (Args&& ...args) const
+    {
+        return allocate(std::allocator<char>(),std::forward<Args>(args)...);
+    }
+
+    /**
+     * @brief Create validator in shared pointer using allocator.
+     * @param alloc Allocator to use for allocation of validator together with control block of shared pointer.
+     * @param args Arguments to forward to validator().
+     * @return Shared pointer to validator.
+     */
+    template <typename AllocatorT, typename ... Args>
+    static auto allocate(const AllocatorT& alloc, Args&& ...args)
     {
         using pointer_type=decltype(new_validator(std::forward<Args>(args)...));
         using element_type=typename std::pointer_traits<pointer_type>::element_type;
-        return std::shared_ptr<element_type>(new_validator(std::forward<Args>(args)...));
+        using way=std::integral_constant<int,
+                std::is_same<std::decay_t<decltype(validator(std::forward<Args>(args)...))>,element_type>::value
+                    ? 0
+                    : (is_single_validator<Args...>::value ? 1 : 2)
+            >;
+        return allocate_impl<element_type>(way{},alloc,std::forward<Args>(args)...);
     }
+
+    private:
+
+        template <typename ... Args>
+        struct is_single_validator : public std::false_type
+        {
+        };
+
+        template <typename T>
+        struct is_single_validator<T> : public std::integral_constant<bool,hana::is_a<validator_tag,T>>
+        {
+        };
+
+        template <typename ElementT, typename AllocatorT, typename ... Args>
+        static std::shared_ptr<ElementT> allocate_impl(std::integral_constant<int,0>, const AllocatorT& alloc, Args&& ...args)
+        {
+            using allocator_type=typename std::allocator_traits<AllocatorT>::template rebind_alloc<ElementT>;
+            return std::allocate_shared<ElementT>(allocator_type(alloc),validator(std::forward<Args>(args)...));
+        }
+
+        template <typename ElementT, typename AllocatorT, typename ... Args>
+        static std::shared_ptr<ElementT> allocate_impl(std::integral_constant<int,1>, const AllocatorT& alloc, Args&& ...args)
+        {
+            // single validator is wrapped into AND the same way as new_validator() does
+            using allocator_type=typename std::allocator_traits<AllocatorT>::template rebind_alloc<ElementT>;
+            return std::allocate_shared<ElementT>(allocator_type(alloc),AND(std::forward<Args>(args)...));
+        }
+
+        template <typename ElementT, typename AllocatorT, typename ... Args>
+        static std::shared_ptr<ElementT> allocate_impl(std::integral_constant<int,2>, const AllocatorT&, Args&& ...args)
+        {
+            // argument is already a pointer to validator
+            return std::shared_ptr<ElementT>(new_validator(std::forward<Args>(args)...));
+        }
 };
 /**
   @brief Callable object for wrapping validator in shared pointer.
 */
 constexpr shared_validator_t shared_validator{};
 
+/**
+ * @brief Helper for wrapping validators in shared pointer using allocator.
+ */
+struct allocate_shared_validator_t
+{
+    template <typename AllocatorT, typename ... Args>
+    auto operator () (const AllocatorT& alloc, Args&& ...args) const
+    {
+        return shared_validator_t::allocate(alloc,std::forward<Args>(args)...);
+    }
+};
+/**
+  @brief Callable object for wrapping validator in shared pointer using allocator, e.g. std::pmr::polymorphic_allocator.
+*/
+constexpr allocate_shared_validator_t allocate_shared_validator{};
+
 //-------------------------------------------------------------
 
 HATN_VALIDATOR_NAMESPACE_END
@@ -25,6 +25,7 @@ Distributed under the Boost Software License, Version 1.0.
 #include <hatn/validator/adapters/default_adapter.hpp>
 #include <hatn/validator/adapters/make_intermediate_adapter.hpp>
 #include <hatn/validator/prepend_super_member.hpp>
+#include <hatn/validator/lazy_once.hpp>
 
 HATN_VALIDATOR_NAMESPACE_BEGIN
 
@@ -130,7 +131,21 @@ class validator_t
         template <typename AdapterT, typename ... Args>
         auto apply(AdapterT&& adpt, Args&&... args) const
         {
-            return _fn(ensure_adapter(std::forward<AdapterT>(adpt)),std::forward<Args>(args)...);
+            return with_lazy_once_scope_of<validator_t>(
+                [&]()
+                {
+                    return _fn(ensure_adapter(std::forward<AdapterT>(adpt)),std::forward<Args>(args)...);
+                }
+            );
+        }
+
+        /**
+         * @brief Get embedded validation handler.
+         * @return Validation handler.
+         */
+        const HandlerT& handler() const noexcept
+        {
+            return _fn;
         }
 
         /**
@@ -214,7 +229,12 @@ class validator_with_member_t
         template <typename AdapterT>
         auto apply(AdapterT&& adpt) const
         {
-            return apply_member(ensure_adapter(std::forward<AdapterT>(adpt)),_prepared_validator,_member);
+            return with_lazy_once_scope_of<validator_with_member_t>(
+                [&]()
+                {
+                    return apply_member(ensure_adapter(std::forward<AdapterT>(adpt)),_prepared_validator,_member);
+                }
+            );
         }
 
         template <typename AdapterT, typename SuperMemberT>
@@ -229,6 +249,24 @@ class validator_with_member_t
                     );
         }
 
+        /**
+         * @brief Get member the validator is bound to.
+         * @return Member.
+         */
+        const MemberT& member() const noexcept
+        {
+            return _member;
+        }
+
+        /**
+         * @brief Get validator to be applied to the member.
+         * @return Prepared validator.
+         */
+        const ValidatorT& prepared_validator() const noexcept
+        {
+            return _prepared_validator;
+        }
+
         /**
          * @brief Create validator with hint.
          * @param h Hint.
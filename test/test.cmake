@@ -21,6 +21,8 @@ SET (VALIDATOR_TEST_SOURCES
     ${VALIDATOR_TEST_SRC}/testprevalidation.cpp
     ${VALIDATOR_TEST_SRC}/testvalidate.cpp
     ${VALIDATOR_TEST_SRC}/testsetvalidated.cpp
+    ${VALIDATOR_TEST_SRC}/testapplyvalidated.cpp
+    ${VALIDATOR_TEST_SRC}/testinsertvalidated.cpp
     ${VALIDATOR_TEST_SRC}/testunsetvalidated.cpp
     ${VALIDATOR_TEST_SRC}/testresizevalidated.cpp
     ${VALIDATOR_TEST_SRC}/testclearvalidated.cpp
@@ -33,6 +35,25 @@ SET (VALIDATOR_TEST_SOURCES
     ${VALIDATOR_TEST_SRC}/testvaluetransformer.cpp
     ${VALIDATOR_TEST_SRC}/testtree.cpp
     ${VALIDATOR_TEST_SRC}/testpointers.cpp
+    ${VALIDATOR_TEST_SRC}/testvectorizedaggregation.cpp
+    ${VALIDATOR_TEST_SRC}/testbatch.cpp
+    ${VALIDATOR_TEST_SRC}/testvalidateincremental.cpp
+    ${VALIDATOR_TEST_SRC}/testvalidationcache.cpp
+    ${VALIDATOR_TEST_SRC}/testanyvalidator.cpp
+    ${VALIDATOR_TEST_SRC}/testruntimevalidator.cpp
+    ${VALIDATOR_TEST_SRC}/testdeclarevalidator.cpp
+    ${VALIDATOR_TEST_SRC}/testdeclarevalidator_impl.cpp
+    ${VALIDATOR_TEST_SRC}/testprofilingadapter.cpp
+    ${VALIDATOR_TEST_SRC}/testtraceadapter.cpp
+    ${VALIDATOR_TEST_SRC}/testadaptiveaggregation.cpp
+    ${VALIDATOR_TEST_SRC}/testcostmodel.cpp
+    ${VALIDATOR_TEST_SRC}/teststructuredreport.cpp
+    ${VALIDATOR_TEST_SRC}/testreportsinks.cpp
+    ${VALIDATOR_TEST_SRC}/testmotranslator.cpp
+    ${VALIDATOR_TEST_SRC}/testmemberpathbuilder.cpp
+    ${VALIDATOR_TEST_SRC}/testlazyonce.cpp
+    ${VALIDATOR_TEST_SRC}/testsamplediff.cpp
+    ${VALIDATOR_TEST_SRC}/testasyncvalidate.cpp
 )
 
 IF (BUILD_VALIDATOR_HABR_EXAMPLES)
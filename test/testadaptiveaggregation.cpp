@@ -0,0 +1,119 @@
+#include <map>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/aggregation/adaptive.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+namespace {
+
+struct counted_sample
+{
+    int sample;
+    size_t* calls;
+};
+
+struct counted_gte_t : public op<counted_gte_t>
+{
+    template <typename T1>
+    bool operator() (const T1& a, const counted_sample& b) const
+    {
+        ++(*b.calls);
+        return a>=b.sample;
+    }
+
+    constexpr static const char* description="must be greater than or equal to";
+    constexpr static const char* n_description="must be less than";
+};
+constexpr counted_gte_t counted_gte{};
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestAdaptiveAggregation)
+
+BOOST_AUTO_TEST_CASE(CheckAdaptiveAnd)
+{
+    size_t calls1=0;
+    size_t calls2=0;
+    auto v=validator(
+        ADAPTIVE_AND(
+            _["field1"](counted_gte,counted_sample{0,&calls1}),
+            _["field2"](counted_gte,counted_sample{10,&calls2})
+        )
+    );
+
+    std::map<std::string,int> m1{{"field1",5},{"field2",5}};
+    for (size_t i=0;i<HATN_VALIDATOR_ADAPTIVE_EPOCH;i++)
+    {
+        BOOST_CHECK(!v.apply(m1));
+    }
+    BOOST_CHECK_EQUAL(calls1,HATN_VALIDATOR_ADAPTIVE_EPOCH);
+    BOOST_CHECK_EQUAL(calls2,HATN_VALIDATOR_ADAPTIVE_EPOCH);
+
+    // field2 always fails, so it is evaluated first in the next epoch
+    for (size_t i=0;i<HATN_VALIDATOR_ADAPTIVE_EPOCH;i++)
+    {
+        BOOST_CHECK(!v.apply(m1));
+    }
+    BOOST_CHECK_EQUAL(calls1,HATN_VALIDATOR_ADAPTIVE_EPOCH);
+    BOOST_CHECK_EQUAL(calls2,2*HATN_VALIDATOR_ADAPTIVE_EPOCH);
+
+    // result does not depend on order
+    std::map<std::string,int> m2{{"field1",5},{"field2",15}};
+    BOOST_CHECK(v.apply(m2));
+    std::map<std::string,int> m3{{"field1",-5},{"field2",15}};
+    BOOST_CHECK(!v.apply(m3));
+}
+
+BOOST_AUTO_TEST_CASE(CheckAdaptiveOr)
+{
+    size_t calls1=0;
+    size_t calls2=0;
+    auto v=validator(
+        _["field1"](
+            value(counted_gte,counted_sample{10,&calls1})
+            ^ADAPTIVE_OR^
+            value(counted_gte,counted_sample{0,&calls2})
+        )
+    );
+
+    std::map<std::string,int> m1{{"field1",5}};
+    for (size_t i=0;i<2*HATN_VALIDATOR_ADAPTIVE_EPOCH;i++)
+    {
+        BOOST_CHECK(v.apply(m1));
+    }
+    BOOST_CHECK_EQUAL(calls1,HATN_VALIDATOR_ADAPTIVE_EPOCH);
+    BOOST_CHECK_EQUAL(calls2,2*HATN_VALIDATOR_ADAPTIVE_EPOCH);
+
+    std::map<std::string,int> m2{{"field1",-5}};
+    BOOST_CHECK(!v.apply(m2));
+}
+
+BOOST_AUTO_TEST_CASE(CheckAdaptiveReport)
+{
+    auto v=validator(
+        ADAPTIVE_AND(
+            _["field1"](size(gte,10)),
+            _["field2"](size(gte,2))
+        )
+    );
+
+    std::map<std::string,std::string> m1{{"field1","0123456789"},{"field2","a"}};
+    for (size_t i=0;i<HATN_VALIDATOR_ADAPTIVE_EPOCH;i++)
+    {
+        BOOST_CHECK(!v.apply(m1));
+    }
+
+    // reports are constructed in declared order
+    std::map<std::string,std::string> m2{{"field1","1"},{"field2","a"}};
+    error_report err;
+    validate(m2,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field1 must be greater than or equal to 10"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -227,4 +227,12 @@ BOOST_AUTO_TEST_CASE(CheckAggregationAllReport)
     rep1.clear();
 }
 
+BOOST_AUTO_TEST_CASE(CheckAggregationDescriptions)
+{
+    BOOST_CHECK_EQUAL(std::string(ALL),"each element");
+    BOOST_CHECK_EQUAL(std::string(ANY),"at least one element");
+    BOOST_CHECK_EQUAL(std::string(ALL(keys)),"each key");
+    BOOST_CHECK_EQUAL(std::string(ANY(keys)),"at least one key");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,186 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#if __cplusplus >= 201703L && __has_include(<memory_resource>)
+#include <memory_resource>
+#define HATN_VALIDATOR_TEST_PMR
+#endif
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/any_validator.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestAnyValidator)
+
+namespace {
+
+using map_type=std::map<std::string,int>;
+
+template <typename T>
+struct counting_allocator
+{
+    using value_type=T;
+
+    counting_allocator(size_t* count) noexcept : count(count)
+    {}
+
+    template <typename T1>
+    counting_allocator(const counting_allocator<T1>& other) noexcept : count(other.count)
+    {}
+
+    T* allocate(size_t n)
+    {
+        ++(*count);
+        return std::allocator<T>().allocate(n);
+    }
+
+    void deallocate(T* p, size_t n) noexcept
+    {
+        --(*count);
+        std::allocator<T>().deallocate(p,n);
+    }
+
+    template <typename T1>
+    bool operator== (const counting_allocator<T1>& other) const noexcept
+    {
+        return count==other.count;
+    }
+
+    template <typename T1>
+    bool operator!= (const counting_allocator<T1>& other) const noexcept
+    {
+        return count!=other.count;
+    }
+
+    size_t* count;
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(CheckApply)
+{
+    map_type m1{{"field1",20},{"field2",50}};
+    map_type m2{{"field1",5},{"field2",50}};
+
+    any_validator<map_type> empty;
+    BOOST_CHECK(!empty);
+
+    auto v1=make_any_validator<map_type>(validator(
+                _["field1"](gte,10),
+                _["field2"](lt,100)
+            ));
+    BOOST_REQUIRE(v1);
+    BOOST_CHECK(v1.apply(m1));
+    BOOST_CHECK(!v1.apply(m2));
+
+    std::vector<any_validator<map_type>> validators;
+    validators.emplace_back(std::move(v1));
+    BOOST_CHECK(!v1);
+    validators.emplace_back(validator(_["field1"](lt,10)));
+    validators.emplace_back(shared_validator(_["field2"](eq,50)));
+    for (size_t i=0;i<20;i++)
+    {
+        validators.emplace_back(validator(_["field1"](gte,static_cast<int>(i))));
+    }
+
+    BOOST_CHECK(validators[0].apply(m1));
+    BOOST_CHECK(!validators[1].apply(m1));
+    BOOST_CHECK(validators[1].apply(m2));
+    BOOST_CHECK(validators[2].apply(m1));
+    BOOST_CHECK(validators[2].apply(m2));
+    BOOST_CHECK(validators[2+6].apply(m2));
+    BOOST_CHECK(!validators[2+7].apply(m2));
+
+    any_validator<map_type> v2;
+    v2=std::move(validators[1]);
+    BOOST_CHECK(v2.apply(m2));
+    v2.reset();
+    BOOST_CHECK(!v2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckReport)
+{
+    map_type m1{{"field1",5}};
+
+    auto v1=make_any_validator<map_type>(validator(
+                _["field1"](gte,10)
+            ));
+
+    error_report err;
+    validate(m1,v1,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field1 must be greater than or equal to 10"));
+
+    const map_type& m2=m1;
+    validate(m2,v1,err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field1 must be greater than or equal to 10"));
+
+    validate(map_type{{"field1",20}},v1,err);
+    BOOST_CHECK(!err);
+
+    BOOST_CHECK_THROW(validate(m1,v1),validation_error);
+}
+
+BOOST_AUTO_TEST_CASE(CheckAllocator)
+{
+    map_type m1{{"field1",20},{"field2",50}};
+    size_t count=0;
+    counting_allocator<char> alloc(&count);
+
+    {
+        // small validator is embedded
+        auto v1=make_any_validator<map_type>(alloc,shared_validator(_["field1"](gte,10)));
+        BOOST_CHECK_EQUAL(count,0);
+        BOOST_CHECK(v1.apply(m1));
+
+        // big validator is allocated
+        auto v2=make_any_validator<map_type>(alloc,validator(
+                    _["field1"](gte,10),
+                    _["field2"](lt,100),
+                    _["field2"](gt,_["field1"])
+                ));
+        BOOST_CHECK_EQUAL(count,1);
+        BOOST_CHECK(v2.apply(m1));
+
+        auto v3=std::move(v2);
+        BOOST_CHECK_EQUAL(count,1);
+        BOOST_CHECK(v3.apply(m1));
+
+        error_report err;
+        validate(map_type{{"field1",20},{"field2",10}},v3,err);
+        BOOST_CHECK_EQUAL(err.message(),std::string("field2 must be greater than field1"));
+    }
+    BOOST_CHECK_EQUAL(count,0);
+
+    {
+        // validator and control block of shared pointer are allocated at once
+        auto v=allocate_shared_validator(alloc,_["field1"](gte,10));
+        BOOST_CHECK_EQUAL(count,1);
+        BOOST_CHECK(v->apply(m1));
+    }
+    BOOST_CHECK_EQUAL(count,0);
+
+#ifdef HATN_VALIDATOR_TEST_PMR
+    std::pmr::monotonic_buffer_resource resource;
+    std::pmr::polymorphic_allocator<char> pmr_alloc(&resource);
+    std::pmr::vector<any_validator<map_type>> validators(pmr_alloc);
+    for (int i=0;i<10;i++)
+    {
+        validators.emplace_back(make_any_validator<map_type>(pmr_alloc,validator(
+                    _["field1"](gte,static_cast<int>(i)),
+                    _["field2"](lt,100),
+                    _["field2"](gt,_["field1"])
+                )));
+    }
+    BOOST_CHECK(validators[5].apply(m1));
+    auto v=allocate_shared_validator(pmr_alloc,_["field1"](gte,10));
+    BOOST_CHECK(v->apply(m1));
+#endif
+}
+
+BOOST_AUTO_TEST_SUITE_END()
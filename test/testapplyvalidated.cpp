@@ -0,0 +1,266 @@
+#include <map>
+#include <string>
+#include <stdexcept>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/prevalidation/apply_validated.hpp>
+
+namespace hana=boost::hana;
+
+HATN_VALIDATOR_PROPERTY(field1)
+HATN_VALIDATOR_PROPERTY(field2)
+
+namespace {
+
+struct TestApplyValidatedStruct
+{
+    size_t field1=0;
+    size_t field2=0;
+};
+
+struct ThrowingValue
+{
+    ThrowingValue(int val=0) : val(val)
+    {}
+
+    ThrowingValue(const ThrowingValue&)=default;
+
+    ThrowingValue& operator= (const ThrowingValue& other)
+    {
+        if (other.val<0)
+        {
+            throw std::runtime_error("negative value");
+        }
+        val=other.val;
+        return *this;
+    }
+
+    bool operator < (int other) const
+    {
+        return val<other;
+    }
+    bool operator >= (int other) const
+    {
+        return val>=other;
+    }
+
+    int val;
+};
+
+struct TestApplyValidatedMap : public std::map<std::string,int>
+{
+    using std::map<std::string,int>::map;
+};
+
+}
+
+HATN_VALIDATOR_NAMESPACE_BEGIN
+
+template <>
+struct set_member_t<TestApplyValidatedStruct,HATN_VALIDATOR_PROPERTY_TYPE(field1)>
+{
+    template <typename ObjectT, typename MemberT, typename ValueT>
+    void operator() (
+            ObjectT& obj,
+            MemberT&&,
+            ValueT&& val
+        ) const
+    {
+        obj.field1=val;
+    }
+};
+
+template <>
+struct set_member_t<TestApplyValidatedStruct,HATN_VALIDATOR_PROPERTY_TYPE(field2)>
+{
+    template <typename ObjectT, typename MemberT, typename ValueT>
+    void operator() (
+            ObjectT& obj,
+            MemberT&&,
+            ValueT&& val
+        ) const
+    {
+        obj.field2=val;
+    }
+};
+
+template <typename MemberT>
+struct set_member_t<TestApplyValidatedMap,MemberT>
+{
+    template <typename ObjectT, typename MemberT1, typename ValueT>
+    void operator() (
+            ObjectT& obj,
+            MemberT1&& member,
+            ValueT&& val
+        ) const
+    {
+        if (val<0)
+        {
+            throw std::runtime_error("negative value");
+        }
+        obj[member.key()]=val;
+    }
+};
+
+HATN_VALIDATOR_NAMESPACE_END
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestApplyValidated)
+
+BOOST_AUTO_TEST_CASE(CheckApplyValidatedContainer)
+{
+    auto v=validator(
+        _["field1"](gte,100),
+        _["field2"](lt,10)
+    );
+
+    error_report err;
+    std::map<std::string,int> m1;
+
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"],200),hana::make_pair(_["field2"],5)),v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"],200);
+    BOOST_CHECK_EQUAL(m1["field2"],5);
+
+    // second update fails, nothing is modified
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"],300),hana::make_pair(_["field2"],50)),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must be less than 10"));
+    BOOST_CHECK_EQUAL(m1["field1"],200);
+    BOOST_CHECK_EQUAL(m1["field2"],5);
+
+    // first update fails, nothing is modified
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"],10),hana::make_pair(_["field2"],1)),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field1 must be greater than or equal to 100"));
+    BOOST_CHECK_EQUAL(m1["field1"],200);
+    BOOST_CHECK_EQUAL(m1["field2"],5);
+
+    // exception on validation failure
+    BOOST_CHECK_THROW(apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"],10)),v),validation_error);
+    BOOST_CHECK_NO_THROW(apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"],1000)),v));
+    BOOST_CHECK_EQUAL(m1["field1"],1000);
+}
+
+BOOST_AUTO_TEST_CASE(CheckApplyValidatedNested)
+{
+    auto v=validator(
+        _["field1"]["subfield1"](gte,100),
+        _["field1"]["subfield2"](lt,10)
+    );
+
+    error_report err;
+    std::map<std::string,std::map<std::string,int>> m1{
+        {"field1",{{"subfield1",150}}}
+    };
+
+    // members share parent element
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"]["subfield1"],200),hana::make_pair(_["field1"]["subfield2"],5)),v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"]["subfield1"],200);
+    BOOST_CHECK_EQUAL(m1["field1"]["subfield2"],5);
+
+    // parent element does not exist
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field1"]["subfield1"],300),hana::make_pair(_["field2"]["subfield2"],1)),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must exist"));
+    BOOST_CHECK_EQUAL(m1["field1"]["subfield1"],200);
+    BOOST_CHECK(m1.find("field2")==m1.end());
+
+    // parent element can not be created in the same transaction
+    apply_validated(m1,hana::make_tuple(hana::make_pair(_["field3"],std::map<std::string,int>{}),hana::make_pair(_["field3"]["subfield1"],1)),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field3 must exist"));
+    BOOST_CHECK(m1.find("field3")==m1.end());
+}
+
+BOOST_AUTO_TEST_CASE(CheckApplyValidatedRollback)
+{
+    auto v=validator(
+        _["field1"](lt,100),
+        _["field2"](lt,100),
+        _["field3"](lt,100)
+    );
+
+    error_report err;
+    std::map<std::string,ThrowingValue> m1{
+        {"field1",ThrowingValue{1}}
+    };
+
+    // assignment of the last value throws, field1 is restored and field2 is removed
+    BOOST_CHECK_THROW(
+        apply_validated(m1,hana::make_tuple(
+                                hana::make_pair(_["field1"],ThrowingValue{10}),
+                                hana::make_pair(_["field2"],ThrowingValue{20}),
+                                hana::make_pair(_["field3"],ThrowingValue{-1})
+                            ),v,err),
+        std::runtime_error
+    );
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1.size(),1);
+    BOOST_CHECK_EQUAL(m1["field1"].val,1);
+
+    apply_validated(m1,hana::make_tuple(
+                            hana::make_pair(_["field1"],ThrowingValue{10}),
+                            hana::make_pair(_["field2"],ThrowingValue{20})
+                        ),v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1.size(),2);
+    BOOST_CHECK_EQUAL(m1["field1"].val,10);
+    BOOST_CHECK_EQUAL(m1["field2"].val,20);
+}
+
+BOOST_AUTO_TEST_CASE(CheckApplyValidatedCustomRollback)
+{
+    auto v=validator(
+        _["field1"](lt,100),
+        _["field2"](lt,100),
+        _["field3"](lt,100)
+    );
+
+    error_report err;
+    TestApplyValidatedMap m1{
+        {"field1",1}
+    };
+
+    // custom setter of the last value throws, field1 is restored and field2 is removed
+    BOOST_CHECK_THROW(
+        apply_validated(m1,hana::make_tuple(
+                                hana::make_pair(_["field1"],10),
+                                hana::make_pair(_["field2"],20),
+                                hana::make_pair(_["field3"],-1)
+                            ),v,err),
+        std::runtime_error
+    );
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1.size(),1);
+    BOOST_CHECK_EQUAL(m1["field1"],1);
+    BOOST_CHECK(m1.find("field2")==m1.end());
+}
+
+BOOST_AUTO_TEST_CASE(CheckApplyValidatedProperty)
+{
+    auto v=validator(
+        _[field1](gte,100),
+        _[field2](lt,10)
+    );
+
+    error_report err;
+    TestApplyValidatedStruct o1;
+
+    apply_validated(o1,hana::make_tuple(hana::make_pair(_[field1],200),hana::make_pair(_[field2],5)),v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(o1.field1,200);
+    BOOST_CHECK_EQUAL(o1.field2,5);
+
+    apply_validated(o1,hana::make_tuple(hana::make_pair(_[field1],300),hana::make_pair(_[field2],50)),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must be less than 10"));
+    BOOST_CHECK_EQUAL(o1.field1,200);
+    BOOST_CHECK_EQUAL(o1.field2,5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,276 @@
+#include <map>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/async/async_operator.hpp>
+#include <hatn/validator/async/async_validate.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+namespace {
+
+using lookup_request=std::pair<std::string,std::string>;
+
+/**
+ * Value must not be registered in collection given as operand.
+ */
+struct unique_t : public async_op<unique_t,lookup_request,bool>
+{
+    template <typename T1, typename T2>
+    lookup_request make_request(const T1& a, const T2& b) const
+    {
+        return lookup_request{b,a};
+    }
+
+    template <typename T1, typename T2>
+    bool check(bool found, const T1&, const T2&) const
+    {
+        return !found;
+    }
+
+    constexpr static const char* description="must be unique in";
+    constexpr static const char* n_description="must be not unique in";
+};
+constexpr unique_t unique{};
+
+/**
+ * Value must be registered in collection given as operand.
+ */
+struct registered_in_t : public async_op<registered_in_t,lookup_request,bool>
+{
+    template <typename T1, typename T2>
+    lookup_request make_request(const T1& a, const T2& b) const
+    {
+        return lookup_request{b,a};
+    }
+
+    template <typename T1, typename T2>
+    bool check(bool found, const T1&, const T2&) const
+    {
+        return found;
+    }
+
+    constexpr static const char* description="must be registered in";
+    constexpr static const char* n_description="must be not registered in";
+};
+constexpr registered_in_t registered_in{};
+
+struct fake_store
+{
+    std::set<lookup_request> records{
+        {"users","john"},
+        {"users","bill"},
+        {"groups","admins"}
+    };
+    std::vector<size_t> batches;
+
+    std::vector<bool> execute(const std::vector<lookup_request>& requests)
+    {
+        batches.push_back(requests.size());
+        std::vector<bool> results;
+        for (const auto& request:requests)
+        {
+            results.push_back(records.find(request)!=records.end());
+        }
+        return results;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestAsyncValidate)
+
+BOOST_AUTO_TEST_CASE(CheckAsyncLookupBatch)
+{
+    auto v=validator(
+        _["login"](unique,"users"),
+        _["group"](registered_in,"groups")
+    );
+
+    std::map<std::string,std::string> m1{
+        {"login","john"},
+        {"group","admins"}
+    };
+
+    // no active batch, lookups can not be done
+    BOOST_CHECK_THROW(v.apply(m1),std::logic_error);
+
+    // batch of other types does not match the operators
+    async_lookup_batch<std::string,bool> other_batch;
+    {
+        async_lookup_batch<std::string,bool>::scope scope(other_batch);
+        BOOST_CHECK_THROW(v.apply(m1),std::logic_error);
+    }
+
+    fake_store store;
+    async_lookup_batch<lookup_request,bool> batch;
+    {
+        async_lookup_batch<lookup_request,bool>::scope scope(batch);
+        BOOST_CHECK(v.apply(m1));
+    }
+    BOOST_REQUIRE_EQUAL(batch.pending().size(),2);
+    batch.resolve(store.execute(batch.pending()));
+    BOOST_CHECK(!batch.has_pending());
+    BOOST_CHECK_EQUAL(batch.resolved_count(),2);
+
+    {
+        async_lookup_batch<lookup_request,bool>::scope scope(batch);
+        error_report err;
+        validate(m1,v,err);
+        BOOST_CHECK(err);
+        BOOST_CHECK_EQUAL(err.message(),std::string("login must be unique in users"));
+    }
+    BOOST_CHECK(!batch.has_pending());
+
+    BOOST_CHECK_THROW(batch.resolve(std::vector<bool>{true}),std::invalid_argument);
+}
+
+#ifdef HATN_VALIDATOR_WITH_COROUTINES
+
+namespace {
+
+struct ready_backend
+{
+    using request_type=lookup_request;
+    using result_type=bool;
+
+    fake_store store;
+
+    async_task<std::vector<bool>> lookup(const std::vector<lookup_request>& requests)
+    {
+        co_return store.execute(requests);
+    }
+};
+
+struct deferred_backend
+{
+    using request_type=lookup_request;
+    using result_type=bool;
+
+    fake_store store;
+    std::coroutine_handle<> waiting;
+    std::vector<lookup_request> requests;
+
+    struct awaiter
+    {
+        deferred_backend* backend;
+
+        bool await_ready() const noexcept
+        {
+            return false;
+        }
+
+        void await_suspend(std::coroutine_handle<> handle)
+        {
+            backend->waiting=handle;
+        }
+
+        std::vector<bool> await_resume()
+        {
+            return backend->store.execute(backend->requests);
+        }
+    };
+
+    awaiter lookup(const std::vector<lookup_request>& reqs)
+    {
+        requests=reqs;
+        return awaiter{this};
+    }
+
+    bool complete()
+    {
+        if (!waiting)
+        {
+            return false;
+        }
+        auto handle=waiting;
+        waiting=nullptr;
+        handle.resume();
+        return true;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(CheckAsyncValidate)
+{
+    auto v=validator(
+        _["login"](unique,"users"),
+        _["group"](registered_in,"groups")
+    );
+
+    std::map<std::string,std::string> m1{
+        {"login","alice"},
+        {"group","admins"}
+    };
+
+    ready_backend backend;
+    auto task=async_validate(m1,v,backend);
+    task.start();
+    BOOST_REQUIRE(task.done());
+    BOOST_CHECK(!task.get());
+    BOOST_REQUIRE_EQUAL(backend.store.batches.size(),1);
+    BOOST_CHECK_EQUAL(backend.store.batches[0],2);
+
+    m1["group"]="guests";
+    auto task2=async_validate(m1,v,backend);
+    task2.start();
+    BOOST_REQUIRE(task2.done());
+    BOOST_CHECK(task2.get());
+    BOOST_CHECK_EQUAL(task2.get().message(),std::string("group must be registered in groups"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckAsyncValidateBatching)
+{
+    // lookup of group is needed only if login is not unique
+    auto v=validator(
+        _["login"](unique,"users")
+        ^OR^
+        _["group"](registered_in,"groups")
+    );
+
+    std::vector<std::map<std::string,std::string>> objects{
+        {{"login","alice"},{"group","guests"}},
+        {{"login","john"},{"group","admins"}},
+        {{"login","bill"},{"group","guests"}},
+        {{"login","john"},{"group","guests"}}
+    };
+
+    deferred_backend backend;
+    auto task=async_validate_each(objects,v,backend);
+    task.start();
+
+    // validation is suspended until backend completes the lookups
+    BOOST_CHECK(!task.done());
+    BOOST_REQUIRE_EQUAL(backend.requests.size(),3);
+    size_t rounds=0;
+    while (backend.complete())
+    {
+        ++rounds;
+    }
+    BOOST_REQUIRE(task.done());
+
+    // logins are looked up in the first batch, groups of non-unique logins in the second one
+    BOOST_CHECK_EQUAL(rounds,2);
+    BOOST_REQUIRE_EQUAL(backend.store.batches.size(),2);
+    BOOST_CHECK_EQUAL(backend.store.batches[0],3);
+    BOOST_CHECK_EQUAL(backend.store.batches[1],2);
+
+    const auto& reports=task.get();
+    BOOST_REQUIRE_EQUAL(reports.size(),4);
+    BOOST_CHECK(!reports[0]);
+    BOOST_CHECK(!reports[1]);
+    BOOST_CHECK(reports[2]);
+    BOOST_CHECK(reports[3]);
+    BOOST_CHECK_EQUAL(reports[3].message(),std::string("login must be unique in users OR group must be registered in groups"));
+}
+
+#endif
+
+BOOST_AUTO_TEST_SUITE_END()
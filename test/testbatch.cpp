@@ -0,0 +1,250 @@
+#include <vector>
+#include <list>
+#include <map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/batch.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestBatch)
+
+namespace {
+
+struct BatchRecord
+{
+    const int& age() const noexcept
+    {
+        return _age;
+    }
+
+    const double& score() const noexcept
+    {
+        return _score;
+    }
+
+    const std::string& name() const noexcept
+    {
+        return _name;
+    }
+
+    int _age;
+    double _score;
+    std::string _name;
+};
+
+HATN_VALIDATOR_PROPERTY(age)
+HATN_VALIDATOR_PROPERTY(score)
+HATN_VALIDATOR_PROPERTY(name)
+
+std::vector<BatchRecord> make_records(size_t count)
+{
+    std::vector<BatchRecord> records;
+    for (size_t i=0;i<count;i++)
+    {
+        records.push_back(BatchRecord{static_cast<int>(i%100),static_cast<double>(i%7)/7.0,std::string(i%5+1,'a')});
+    }
+    return records;
+}
+
+template <typename RecordsT, typename ValidatorT>
+void check_same_as_single(const RecordsT& records, const ValidatorT& v)
+{
+    auto result=validate_batch(records,v);
+    BOOST_REQUIRE_EQUAL(result.size(),records.size());
+    size_t i=0;
+    size_t failed=0;
+    for (auto&& record:records)
+    {
+        bool ok=v.apply(record);
+        BOOST_TEST_CONTEXT("record " << i)
+        {
+            BOOST_CHECK_EQUAL(result.ok(i),ok);
+        }
+        failed+=!ok;
+        i++;
+    }
+    BOOST_CHECK_EQUAL(result.failed_count(),failed);
+    BOOST_CHECK_EQUAL(static_cast<bool>(result),failed==0);
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(CheckNodeSelection)
+{
+    auto m1=_[age];
+    static_assert(std::is_same<detail::batch_member_value_type<BatchRecord,decltype(m1)>::type,int>::value,"");
+    auto m2=_[name];
+    static_assert(std::is_same<detail::batch_member_value_type<BatchRecord,decltype(m2)>::type,std::string>::value,"");
+    auto m3=_["field"];
+    static_assert(std::is_same<detail::batch_member_value_type<BatchRecord,decltype(m3)>::type,void>::value,"");
+    auto m4=_[age][ALL];
+    static_assert(std::is_same<detail::batch_member_value_type<BatchRecord,decltype(m4)>::type,void>::value,"");
+
+    auto v1=value(gte,10);
+    static_assert(detail::batch_column_node<decltype(v1),int>::supported::value,"");
+    auto v2=value(gte,10) ^OR^ NOT(value(in,interval(1,5)));
+    static_assert(detail::batch_column_node<decltype(v2),int>::supported::value,"");
+    auto v3=value(gte,10) ^AND^ size(gte,1);
+    static_assert(!detail::batch_column_node<decltype(v3),int>::supported::value,"");
+    auto v4=ALL(value(gte,10));
+    static_assert(!detail::batch_column_node<decltype(v4),int>::supported::value,"");
+
+    BOOST_CHECK(true);
+}
+
+BOOST_AUTO_TEST_CASE(CheckColumnarMembers)
+{
+    auto records=make_records(1000);
+
+    auto v1=validator(
+                _[age](gte,10),
+                _[score](lt,0.5)
+            );
+    check_same_as_single(records,v1);
+
+    auto v2=validator(
+                _[age](value(gte,10) ^OR^ value(in,interval(0,5))),
+                NOT(_[score](gt,0.9))
+            );
+    check_same_as_single(records,v2);
+
+    auto v3=validator(
+                _[age](NOT(value(nin,interval(20,80,interval.open()))))
+            );
+    check_same_as_single(records,v3);
+
+    auto v4=validator(
+                _[age](gte,0)
+            );
+    auto result=validate_batch(records,v4);
+    BOOST_CHECK(result);
+    BOOST_CHECK_EQUAL(result.failed_count(),0);
+}
+
+BOOST_AUTO_TEST_CASE(CheckMixedNodes)
+{
+    auto records=make_records(300);
+
+    // name is not a number so it is validated object by object
+    auto v1=validator(
+                _[age](lt,90),
+                _[name](size(gte,2))
+            );
+    check_same_as_single(records,v1);
+
+    auto v2=validator(
+                _[name](size(gte,3)) ^OR^ _[age](lt,5),
+                _[score](gte,0.0)
+            );
+    check_same_as_single(records,v2);
+
+    std::list<BatchRecord> list_records(records.begin(),records.end());
+    check_same_as_single(list_records,v2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckNumbers)
+{
+    std::vector<int> numbers;
+    for (int i=0;i<200;i++)
+    {
+        numbers.push_back(i-50);
+    }
+
+    auto v1=validator(gte,0);
+    check_same_as_single(numbers,v1);
+
+    auto v2=validator(
+                value(gte,-10),
+                value(lt,100)
+            );
+    check_same_as_single(numbers,v2);
+
+    std::list<int> list_numbers(numbers.begin(),numbers.end());
+    check_same_as_single(list_numbers,v2);
+
+    std::vector<int> empty;
+    auto result=validate_batch(empty,v2);
+    BOOST_CHECK_EQUAL(result.size(),0);
+    BOOST_CHECK(result);
+}
+
+BOOST_AUTO_TEST_CASE(CheckMaps)
+{
+    std::vector<std::map<std::string,int>> records;
+    for (int i=0;i<100;i++)
+    {
+        records.push_back({{"field1",i},{"field2",100-i}});
+    }
+
+    auto v=validator(
+                _["field1"](gt,_["field2"]) ^OR^ _["field1"](lt,10),
+                _["field2"](gte,5)
+            );
+    check_same_as_single(records,v);
+
+    // rules guarded by existence of members must not be applied to records where the members are missing
+    std::vector<std::map<std::string,int>> partial_records;
+    for (int i=0;i<100;i++)
+    {
+        std::map<std::string,int> record;
+        if (i%3!=0)
+        {
+            record["field1"]=i;
+        }
+        if (i%4!=0)
+        {
+            record["field2"]=100-i;
+        }
+        partial_records.push_back(record);
+    }
+    auto v1=validator(
+                _["field1"](exists,true) ^AND^ _["field1"](gte,10),
+                !_["field2"](exists,true) ^OR^ _["field2"](gt,20)
+            );
+    check_same_as_single(partial_records,v1);
+    auto v2=validator(
+                (_["field1"](exists,true) ^AND^ _["field1"](lt,50))
+                ^OR^
+                (_["field2"](exists,true) ^AND^ _["field2"](lt,50) ^AND^ _["field2"](gte,_["field2"]))
+            );
+    check_same_as_single(partial_records,v2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckReports)
+{
+    auto records=make_records(100);
+    auto v=validator(
+                _[age](gte,5),
+                _[name](size(lt,5))
+            );
+
+    std::vector<size_t> indexes;
+    std::vector<std::string> reports;
+    auto result=validate_batch(records,v,
+                    [&](size_t i, const error_report& err)
+                    {
+                        indexes.push_back(i);
+                        reports.push_back(err.message());
+                    }
+                );
+    BOOST_CHECK_EQUAL(indexes.size(),result.failed_count());
+    for (size_t i=0;i<indexes.size();i++)
+    {
+        BOOST_CHECK(!result.ok(indexes[i]));
+        error_report err;
+        validate(records[indexes[i]],v,err);
+        BOOST_CHECK_EQUAL(reports[i],err.message());
+    }
+
+    BOOST_REQUIRE(!indexes.empty());
+    BOOST_CHECK_EQUAL(indexes[0],0);
+    BOOST_CHECK_EQUAL(reports[0],std::string("age must be greater than or equal to 5"));
+    BOOST_REQUIRE(indexes.size()>5);
+    BOOST_CHECK_EQUAL(indexes[5],9);
+    BOOST_CHECK_EQUAL(reports[5],std::string("size of name must be less than 5"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,103 @@
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/operators/regex.hpp>
+#include <hatn/validator/operators/lex_in.hpp>
+#include <hatn/validator/aggregation/by_cost.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestCostModel)
+
+BOOST_AUTO_TEST_CASE(CheckCostClasses)
+{
+    static_assert(gte_t::cost==cost_class::cheap,"");
+    static_assert(exists_t::cost==cost_class::trivial,"");
+    static_assert(flag_t::cost==cost_class::trivial,"");
+    static_assert(lex_eq_t::cost==cost_class::moderate,"");
+    static_assert(lex_in_t::cost==cost_class::expensive,"");
+    static_assert(regex_match_t::cost==cost_class::expensive,"");
+    static_assert(type_p_size::cost==cost_class::trivial,"");
+
+    auto v_size=_["field1"](size(gte,2));
+    auto v_exists=_["field1"](exists,true);
+    auto v_regex=_["field1"](regex_match,"[a-z]+");
+    auto v_interval=_["field1"](in,interval(1,10));
+    auto v_range=_["field1"](in,range({1,2,3}));
+    auto v_all=_["field1"](ALL(value(gte,1)));
+    auto v_and=AND(value(gte,1),value(lte,10));
+
+    BOOST_CHECK(validator_cost<decltype(v_exists)> < validator_cost<decltype(v_size)>);
+    BOOST_CHECK(validator_cost<decltype(v_size)> < validator_cost<decltype(v_regex)>);
+    BOOST_CHECK(validator_cost<decltype(v_interval)> < validator_cost<decltype(v_range)>);
+    BOOST_CHECK(validator_cost<decltype(v_size)> < validator_cost<decltype(v_all)>);
+    BOOST_CHECK_EQUAL(validator_cost<decltype(v_and)>,2*validator_cost<decltype(value(gte,1))>);
+}
+
+BOOST_AUTO_TEST_CASE(CheckSortedAggregations)
+{
+    auto v1=validator(
+        AND_by_cost(
+            _["field1"](regex_match,"[a-z]+"),
+            _["field2"](size(gte,2)),
+            _["field3"](exists,true)
+        )
+    );
+
+    std::map<std::string,std::string> m1{{"field1","abc"},{"field2","ab"},{"field3","a"}};
+    BOOST_CHECK(v1.apply(m1));
+
+    // both field1 and field2 fail, the cheaper size check is evaluated first
+    std::map<std::string,std::string> m2{{"field1","123"},{"field2","a"},{"field3","a"}};
+    error_report err;
+    validate(m2,v1,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field2 must be greater than or equal to 2"));
+
+    // field3 is checked first
+    std::map<std::string,std::string> m3{{"field1","123"},{"field2","a"}};
+    validate(m3,v1,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field3 must exist"));
+
+    auto v2=validator(
+        _["field1"](
+            OR_by_cost(
+                value(regex_match,"[a-z]+"),
+                value(lex_in,range({"123","456"})),
+                size(eq,5)
+            )
+        )
+    );
+    BOOST_CHECK(v2.apply(m1));
+    BOOST_CHECK(v2.apply(m2));
+    // regex and range have equal cost and keep declared order
+    std::map<std::string,std::string> m4{{"field1","12"}};
+    validate(m4,v2,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field1 must be equal to 5 OR field1 must match expression [a-z]+ OR field1 must be in range [123, 456]"));
+
+    // infix notation
+    auto v3=validator(
+        _["field1"](regex_match,"[a-z]+") ^AND_by_cost^ _["field2"](size(gte,2))
+    );
+    BOOST_CHECK(v3.apply(m1));
+    validate(m2,v3,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field2 must be greater than or equal to 2"));
+
+    auto v4=validator(
+        _["field1"](value(regex_match,"[a-z]+") ^OR_by_cost^ size(eq,5))
+    );
+    validate(m4,v4,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field1 must be equal to 5 OR field1 must match expression [a-z]+"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,48 @@
+#include <map>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/declare_validator.hpp>
+
+namespace declare_validator_test {
+
+using map_type=std::map<std::string,int>;
+
+HATN_VALIDATOR_DECLARE(validate_map,map_type);
+
+}
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+using namespace declare_validator_test;
+
+BOOST_AUTO_TEST_SUITE(TestDeclareValidator)
+
+BOOST_AUTO_TEST_CASE(CheckDeclaredValidator)
+{
+    map_type m1{{"field1",10},{"field2",2}};
+    BOOST_CHECK(validate_map(m1));
+
+    error err;
+    validate_map(m1,err);
+    BOOST_CHECK(!err);
+
+    error_report err1;
+    validate_map(m1,err1);
+    BOOST_CHECK(!err1);
+
+    map_type m2{{"field1",1},{"field2",2}};
+    BOOST_CHECK(!validate_map(m2));
+    validate_map(m2,err);
+    BOOST_CHECK(err);
+    validate_map(m2,err1);
+    BOOST_CHECK(err1);
+    BOOST_CHECK_EQUAL(err1.message(),std::string("field1 must be greater than or equal to 10"));
+
+    map_type m3{{"field1",10},{"field2",5}};
+    validate_map(m3,err1);
+    BOOST_CHECK(err1);
+    BOOST_CHECK_EQUAL(err1.message(),std::string("field2 must be in range [1, 2, 3]"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
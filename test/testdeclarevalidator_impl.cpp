@@ -0,0 +1,18 @@
+#include <map>
+#include <string>
+
+#include <hatn/validator/define_validator.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+namespace declare_validator_test {
+
+using map_type=std::map<std::string,int>;
+
+HATN_VALIDATOR_DECLARE(validate_map,map_type);
+HATN_VALIDATOR_DEFINE(validate_map,map_type,
+    _["field1"](gte,10),
+    _["field2"](in,range({1,2,3}))
+)
+
+}
@@ -1,3 +1,4 @@
+#include <map>
 #include <string>
 #include <vector>
 #include <iterator>
@@ -10,6 +11,8 @@
 #include <hatn/validator/reporting/mapped_translator.hpp>
 #include <hatn/validator/reporting/translator_repository.hpp>
 #include <hatn/validator/utils/hana_to_std_tuple.hpp>
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
 
 #ifdef HATN_VALIDATOR_FMT
 
@@ -142,6 +145,35 @@ BOOST_AUTO_TEST_CASE(CheckFmtFormatterWithRvals)
     checkFormatterWithRvals(make_backend_formatter);
 }
 
+BOOST_AUTO_TEST_CASE(CheckFmtMemoryBuffer)
+{
+    fmt::memory_buffer buf;
+    detail::fmt_backend_formatter<fmt::memory_buffer> formatter{buf};
+    formatter.append_join_args(" ","one",2,3.5,std::string("four"));
+    BOOST_CHECK_EQUAL(fmt::to_string(buf),std::string("one 2 3.5 four"));
+
+    using map_type=std::map<std::string,int>;
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,5) ^OR^ _["field3"](eq,1) ^OR^ (_["field1"](eq,100) ^AND^ _["field2"](eq,200))
+    );
+    map_type m1{{"field1",1},{"field2",1},{"field3",1}};
+    map_type m2{{"field1",10},{"field2",10},{"field3",0}};
+
+    std::string rep;
+    fmt::memory_buffer rep_buf;
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,rep)));
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,rep_buf)));
+    BOOST_CHECK_EQUAL(fmt::to_string(rep_buf),rep);
+
+    rep.clear();
+    rep_buf.clear();
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,rep)));
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,rep_buf)));
+    BOOST_CHECK_EQUAL(fmt::to_string(rep_buf),rep);
+    BOOST_CHECK_EQUAL(rep,std::string("field2 must be less than 5 OR field3 must be equal to 1 OR field1 must be equal to 100"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 #endif
@@ -0,0 +1,170 @@
+#include <map>
+#include <vector>
+#include <string>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/prevalidation/set_validated.hpp>
+#include <hatn/validator/prevalidation/push_back_validated.hpp>
+#include <hatn/validator/prevalidation/insert_validated.hpp>
+#include <hatn/validator/prevalidation/emplace_validated.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestInsertValidated)
+
+BOOST_AUTO_TEST_CASE(CheckPushBackValidated)
+{
+    auto v=validator(
+        _["field1"](size(lte,3)),
+        _["field1"][ALL](gte,10),
+        _["field2"](value(gte,100))
+    );
+
+    error_report err;
+    std::map<std::string,std::vector<int>> m1{
+        {"field1",{}}
+    };
+
+    push_back_validated(m1,_["field1"],20,v,err);
+    BOOST_CHECK(!err);
+    push_back_validated(m1,_["field1"],30,v,err);
+    BOOST_CHECK(!err);
+    BOOST_REQUIRE_EQUAL(m1["field1"].size(),2);
+    BOOST_CHECK_EQUAL(m1["field1"][1],30);
+
+    // invalid element
+    push_back_validated(m1,_["field1"],5,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each element of field1 must be greater than or equal to 10"));
+    BOOST_CHECK_EQUAL(m1["field1"].size(),2);
+
+    push_back_validated(m1,_["field1"],40,v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"].size(),3);
+
+    // invalid new size
+    push_back_validated(m1,_["field1"],50,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field1 must be less than or equal to 3"));
+    BOOST_CHECK_EQUAL(m1["field1"].size(),3);
+
+    BOOST_CHECK_THROW(push_back_validated(m1,_["field1"],60,v),validation_error);
+    BOOST_CHECK_EQUAL(m1["field1"].size(),3);
+
+    // strict ANY is checked against the new element only
+    auto v1=validator(
+        _["field1"][ANY](eq,100)
+    );
+    push_back_validated(m1,_["field1"],1,v1,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"].size(),4);
+    push_back_validated(m1,_["field1"],1,strict_any(v1),err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("at least one element of field1 must be equal to 100"));
+    BOOST_CHECK_NO_THROW(push_back_validated(m1,_["field1"],100,strict_any(v1)));
+    BOOST_CHECK_EQUAL(m1["field1"].size(),5);
+
+    // container does not exist
+    push_back_validated(m1,_["field3"],20,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field3 must exist"));
+    BOOST_CHECK(m1.find("field3")==m1.end());
+    BOOST_CHECK_THROW(push_back_validated(m1,_["field3"],20,v),validation_error);
+}
+
+BOOST_AUTO_TEST_CASE(CheckInsertValidated)
+{
+    auto v=validator(
+        _["field1"](size(lte,3) ^AND^ empty(flag,false)),
+        _["field1"][ALL](gte,10),
+        _["field1"][ALL(keys)](gte,std::string("b"))
+    );
+
+    error_report err;
+    std::map<std::string,std::map<std::string,int>> m1{
+        {"field1",{{"b",10}}}
+    };
+
+    insert_validated(m1,_["field1"],std::string("c"),20,v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"]["c"],20);
+
+    // invalid key
+    insert_validated(m1,_["field1"],std::string("a"),20,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each key of field1 must be greater than or equal to b"));
+    BOOST_CHECK(m1["field1"].find("a")==m1["field1"].end());
+
+    // invalid value
+    insert_validated(m1,_["field1"],std::string("d"),1,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each element of field1 must be greater than or equal to 10"));
+    BOOST_CHECK(m1["field1"].find("d")==m1["field1"].end());
+
+    insert_validated(m1,_["field1"],std::string("d"),30,v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"].size(),3);
+
+    // invalid new size
+    insert_validated(m1,_["field1"],std::string("e"),40,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of field1 must be less than or equal to 3"));
+    BOOST_CHECK_EQUAL(m1["field1"].size(),3);
+
+    // existing element is not replaced
+    insert_validated(m1,_["field1"],std::string("c"),1,v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"]["c"],20);
+
+    // keys are validated also by set_validated
+    set_validated(m1,_["field1"]["a"],20,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each key of field1 must be greater than or equal to b"));
+    BOOST_CHECK(m1["field1"].find("a")==m1["field1"].end());
+
+    // container does not exist
+    insert_validated(m1,_["field2"],std::string("c"),20,v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must exist"));
+    BOOST_CHECK(m1.find("field2")==m1.end());
+}
+
+BOOST_AUTO_TEST_CASE(CheckEmplaceValidated)
+{
+    auto v=validator(
+        _["field1"][ALL](size(gte,2)),
+        _["field1"][ALL(keys)](lt,100)
+    );
+
+    error_report err;
+    std::map<std::string,std::map<int,std::string>> m1{
+        {"field1",{}}
+    };
+
+    std::string val1("value1");
+    emplace_validated(m1,_["field1"],1,std::move(val1),v,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(m1["field1"][1],"value1");
+
+    emplace_validated(m1,_["field1"],2,std::string("v"),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("size of each element of field1 must be greater than or equal to 2"));
+
+    emplace_validated(m1,_["field1"],200,std::string("value200"),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each key of field1 must be less than 100"));
+
+    BOOST_CHECK_THROW(emplace_validated(m1,_["field1"],300,std::string("value300"),v),validation_error);
+    BOOST_CHECK_NO_THROW(emplace_validated(m1,_["field1"],3,std::string("value3"),v));
+    BOOST_CHECK_EQUAL(m1["field1"].size(),2);
+
+    // container does not exist
+    emplace_validated(m1,_["field2"],4,std::string("value4"),v,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must exist"));
+    BOOST_CHECK(m1.find("field2")==m1.end());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,137 @@
+#include <map>
+#include <vector>
+#include <thread>
+#include <atomic>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/lazy_once.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestLazyOnce)
+
+BOOST_AUTO_TEST_CASE(CheckLazyOnce)
+{
+    std::atomic<size_t> calls{0};
+    int limit=10;
+    bool in_scope=false;
+    auto load_limit=[&]()
+    {
+        ++calls;
+        in_scope=lazy_once_scope::current()!=nullptr;
+        return limit;
+    };
+
+    std::map<std::string,std::vector<int>> m1{
+        {"items",{1,2,3,4,5}}
+    };
+
+    // plain lazy operand is evaluated for each element
+    auto v1=validator(
+        _["items"](ALL(value(lte,lazy(load_limit))))
+    );
+    BOOST_CHECK(v1.apply(m1));
+    BOOST_CHECK_EQUAL(calls.load(),5);
+    // scope is created only for validators with lazy_once operands
+    static_assert(!has_lazy_once<decltype(v1)>::value,"");
+    BOOST_CHECK(!in_scope);
+
+    // lazy_once operand is evaluated once per run
+    calls=0;
+    auto v2=validator(
+        _["items"](ALL(value(lte,lazy_once(load_limit))))
+    );
+    static_assert(has_lazy_once<decltype(v2)>::value,"");
+    BOOST_CHECK(v2.apply(m1));
+    BOOST_CHECK_EQUAL(calls.load(),1);
+    BOOST_CHECK(in_scope);
+
+    // value is evaluated again on the next run
+    limit=3;
+    BOOST_CHECK(!v2.apply(m1));
+    BOOST_CHECK_EQUAL(calls.load(),2);
+
+    // copies of operand share the value
+    calls=0;
+    auto limit_op=lazy_once(load_limit);
+    auto v3=validator(
+        _["items"](ALL(value(lte,limit_op))),
+        _["items"](size(lte,limit_op))
+    );
+    limit=5;
+    BOOST_CHECK(v3.apply(m1));
+    BOOST_CHECK_EQUAL(calls.load(),1);
+
+    // explicit scope shares the value between runs
+    calls=0;
+    {
+        lazy_once_scope scope;
+        BOOST_CHECK(v2.apply(m1));
+        limit=3;
+        BOOST_CHECK(v2.apply(m1));
+        error_report err;
+        validate(m1,v2,err);
+        BOOST_CHECK(!err);
+        BOOST_CHECK_EQUAL(scope.cache().size(),1);
+    }
+    BOOST_CHECK_EQUAL(calls.load(),1);
+    BOOST_CHECK(lazy_once_scope::current()==nullptr);
+    BOOST_CHECK(!v2.apply(m1));
+    BOOST_CHECK_EQUAL(calls.load(),2);
+
+    // reported operand is the value evaluated in the run
+    calls=0;
+    error_report err;
+    validate(m1,v2,err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("each element of items must be less than or equal to 3"));
+    BOOST_CHECK_EQUAL(calls.load(),1);
+
+    // out of validation run the handler is invoked every time
+    calls=0;
+    BOOST_CHECK_EQUAL(limit_op(),3);
+    BOOST_CHECK_EQUAL(limit_op(),3);
+    BOOST_CHECK_EQUAL(calls.load(),2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckLazyOnceConcurrent)
+{
+    std::atomic<size_t> calls{0};
+    auto v=validator(
+        _["items"](ALL(value(lte,lazy_once([&calls](){++calls; return 100;}))))
+    );
+
+    std::map<std::string,std::vector<int>> m1{
+        {"items",std::vector<int>(50,10)}
+    };
+
+    const size_t thread_count=4;
+    const size_t run_count=100;
+    std::atomic<size_t> failed{0};
+    std::vector<std::thread> threads;
+    for (size_t i=0;i<thread_count;i++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                for (size_t j=0;j<run_count;j++)
+                {
+                    if (!v.apply(m1))
+                    {
+                        ++failed;
+                    }
+                }
+            }
+        );
+    }
+    for (auto&& thread:threads)
+    {
+        thread.join();
+    }
+    BOOST_CHECK_EQUAL(failed.load(),0);
+    BOOST_CHECK_EQUAL(calls.load(),thread_count*run_count);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
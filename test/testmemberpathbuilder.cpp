@@ -0,0 +1,149 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/adapters/failed_members_adapter.hpp>
+#include <hatn/validator/reporting/formatter.hpp>
+#include <hatn/validator/reporting/member_path_builder.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+namespace
+{
+HATN_VALIDATOR_PROPERTY(field1)
+}
+
+BOOST_AUTO_TEST_SUITE(TestMemberPathBuilder)
+
+BOOST_AUTO_TEST_CASE(CheckMemberPathBuilder)
+{
+    member_path_builder<json_pointer_path_format> jp;
+    BOOST_CHECK_EQUAL(jp.format(_["field1"]["sub/field"][1]),"/field1/sub~1field/1");
+    BOOST_CHECK_EQUAL(jp.format(_["a~b"]),"/a~0b");
+    BOOST_CHECK_EQUAL(jp.format(_[field1][2]),"/field1/2");
+    BOOST_CHECK_EQUAL(jp.depth(),0);
+    BOOST_CHECK(jp.str().empty());
+
+    member_path_builder<dotted_path_format> dp;
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"][1]),"field1.subfield1.1");
+
+    // levels
+    dp.open(_["field1"]["subfield1"]);
+    BOOST_CHECK_EQUAL(dp.str(),"field1.subfield1");
+    BOOST_CHECK_EQUAL(dp.depth(),2);
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"]["subfield2"]),"field1.subfield1.subfield2");
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"]),"field1.subfield1");
+    BOOST_CHECK_EQUAL(dp.depth(),2);
+
+    dp.open();
+    dp.open(_["field1"]["subfield1"][10]);
+    BOOST_CHECK_EQUAL(dp.str(),"field1.subfield1.10");
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"][10]["value"]),"field1.subfield1.10.value");
+    dp.close();
+    BOOST_CHECK_EQUAL(dp.str(),"field1.subfield1");
+    dp.close();
+    BOOST_CHECK_EQUAL(dp.str(),"field1.subfield1");
+
+    // member of upper level is formatted from scratch
+    BOOST_CHECK_EQUAL(dp.format(_["field2"]),"field2");
+    dp.open(_["field2"]);
+    BOOST_CHECK_EQUAL(dp.format(_["field3"]),"field3");
+    dp.close();
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"]["subfield2"]),"field1.subfield1.subfield2");
+
+    dp.close();
+    BOOST_CHECK(dp.str().empty());
+
+    // members with other keys at the same depth are not nested into current level
+    dp.open(_["a"]);
+    BOOST_CHECK_EQUAL(dp.format(_["b"]),"b");
+    BOOST_CHECK_EQUAL(dp.format(_["b"]["c"]),"b.c");
+    BOOST_CHECK_EQUAL(dp.format(_["a"]["c"]),"a.c");
+    dp.open(_["b"]["c"]);
+    BOOST_CHECK_EQUAL(dp.format(_["a"]["c"]),"a.c");
+    BOOST_CHECK_EQUAL(dp.format(_["b"]["c"]["d"]),"b.c.d");
+    dp.close();
+    BOOST_CHECK_EQUAL(dp.str(),"a");
+    dp.close();
+    BOOST_CHECK(dp.str().empty());
+
+    dp.push(std::string("field1"));
+    dp.push(5);
+    BOOST_CHECK_EQUAL(dp.str(),"field1.5");
+    dp.pop();
+    BOOST_CHECK_EQUAL(dp.str(),"field1");
+    dp.reset();
+    BOOST_CHECK(dp.str().empty());
+}
+
+BOOST_AUTO_TEST_CASE(CheckMemberPathBuilderKeys)
+{
+    member_path_builder<dotted_path_format> dp;
+
+    // keys of opened member are kept by builder
+    dp.open(_["field1"]["subfield1"]);
+    dp.open(_["field1"]["subfield1"][1]);
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"][1]["value"]),"field1.subfield1.1.value");
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"][2]["value"]),"field1.subfield1.2.value");
+    dp.close();
+
+    // keys are compared by values, not by formatted names
+    dp.open(_["a.b"]);
+    BOOST_CHECK_EQUAL(dp.format(_["a"]["b"]["c"]),"a.b.c");
+    BOOST_CHECK_EQUAL(dp.format(_["a.b"]["c"]),"a.b.c");
+    dp.close();
+
+    // keys of different types are not equal but members are still formatted
+    dp.open(_[field1]);
+    BOOST_CHECK_EQUAL(dp.format(_["field1"]["subfield1"]),"field1.subfield1");
+    BOOST_CHECK_EQUAL(dp.format(_[field1][1]),"field1.1");
+    dp.close();
+    dp.open(_["field1"][1]);
+    BOOST_CHECK_EQUAL(dp.format(_["field1"][size_t(1)]["value"]),"field1.1.value");
+    BOOST_CHECK_EQUAL(dp.format(_["field1"][1]["value"]),"field1.1.value");
+    dp.close();
+
+    dp.close();
+    BOOST_CHECK(dp.str().empty());
+    BOOST_CHECK_EQUAL(dp.depth(),0);
+
+    // pushed keys are kept by builder
+    {
+        std::string key{"field1"};
+        dp.push(key);
+    }
+    dp.push(5);
+    BOOST_CHECK_EQUAL(dp.format(_["field1"][5]["value"]),"field1.5.value");
+    BOOST_CHECK_EQUAL(dp.format(_["field1"][6]["value"]),"field1.6.value");
+    BOOST_CHECK_EQUAL(dp.str(),"field1.5");
+}
+
+BOOST_AUTO_TEST_CASE(CheckFailedMembersPaths)
+{
+    std::map<std::string,std::map<std::string,int>> m1{
+        {"field1",{{"subfield1",5},{"subfield2",20}}},
+        {"field2",{{"subfield1",5}}}
+    };
+    auto v=validator(
+        _["field1"](
+            size(gte,1)
+            ^AND^
+            _["subfield1"](gte,1)
+        ),
+        _["field1"]["subfield2"](lte,10),
+        _["field2"]["subfield1"](gte,10)
+    );
+
+    auto ra=make_failed_members_adapter(m1);
+    v.apply(ra);
+    const auto& members=ra.traits().reporter().failed_members();
+    BOOST_REQUIRE_EQUAL(members.size(),2);
+    BOOST_CHECK_EQUAL(members[0],"field1.subfield2");
+    BOOST_CHECK_EQUAL(members[1],"field2.subfield1");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
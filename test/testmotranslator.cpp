@@ -0,0 +1,227 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <fstream>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/reporting/formatter.hpp>
+#include <hatn/validator/reporting/mo_translator.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+namespace
+{
+
+uint32_t mo_hash(const std::string& key)
+{
+    uint32_t hval=0;
+    for (auto ch:key)
+    {
+        hval<<=4;
+        hval+=static_cast<unsigned char>(ch);
+        auto g=hval&0xf0000000u;
+        if (g!=0)
+        {
+            hval^=g>>24;
+            hval^=g;
+        }
+    }
+    return hval;
+}
+
+void put_u32(std::string& dst, size_t offset, uint32_t val, bool big_endian)
+{
+    for (size_t i=0;i<4;i++)
+    {
+        auto shift=big_endian ? (3-i)*8 : i*8;
+        dst[offset+i]=static_cast<char>((val>>shift)&0xff);
+    }
+}
+
+std::string make_mo(const std::map<std::string,std::string>& messages, bool with_hash=true, bool big_endian=false)
+{
+    auto count=static_cast<uint32_t>(messages.size());
+    uint32_t hash_size=0;
+    if (with_hash)
+    {
+        hash_size=count*4/3+3;
+        auto is_prime=[](uint32_t n)
+        {
+            for (uint32_t i=2;i*i<=n;i++)
+            {
+                if (n%i==0)
+                {
+                    return false;
+                }
+            }
+            return true;
+        };
+        while (!is_prime(hash_size))
+        {
+            ++hash_size;
+        }
+    }
+
+    uint32_t originals=28;
+    uint32_t translations=originals+count*8;
+    uint32_t hash_table=translations+count*8;
+    std::string mo(hash_table+hash_size*4,'\0');
+
+    put_u32(mo,0,0x950412deu,big_endian);
+    put_u32(mo,4,0,big_endian);
+    put_u32(mo,8,count,big_endian);
+    put_u32(mo,12,originals,big_endian);
+    put_u32(mo,16,translations,big_endian);
+    put_u32(mo,20,hash_size,big_endian);
+    put_u32(mo,24,hash_table,big_endian);
+
+    std::vector<uint32_t> hash(hash_size,0);
+    uint32_t i=0;
+    for (auto&& it:messages)
+    {
+        auto add_string=[&mo,big_endian](uint32_t table, uint32_t index, const std::string& str)
+        {
+            put_u32(mo,table+index*8,static_cast<uint32_t>(str.size()),big_endian);
+            put_u32(mo,table+index*8+4,static_cast<uint32_t>(mo.size()),big_endian);
+            mo.append(str);
+            mo.push_back('\0');
+        };
+        add_string(originals,i,it.first);
+        add_string(translations,i,it.second);
+
+        if (with_hash)
+        {
+            auto key=it.first.substr(0,it.first.find('\0'));
+            auto hval=mo_hash(key);
+            auto idx=hval%hash_size;
+            auto incr=1+(hval%(hash_size-2));
+            while (hash[idx]!=0)
+            {
+                idx=(idx>=hash_size-incr) ? idx-(hash_size-incr) : idx+incr;
+            }
+            hash[idx]=i+1;
+        }
+        ++i;
+    }
+    for (uint32_t j=0;j<hash_size;j++)
+    {
+        put_u32(mo,hash_table+j*4,hash[j],big_endian);
+    }
+    return mo;
+}
+
+std::map<std::string,std::string> make_messages()
+{
+    return std::map<std::string,std::string>{
+        {"", "Content-Type: text/plain; charset=UTF-8\n"},
+        {"must be greater than or equal to", "должен быть больше или равен"},
+        {"cats:1\x04must be greater than or equal to", "должна быть больше или равна"},
+        {"must be empty", "must be empty (default)"},
+        {"cats:1\x04must be empty", "must be empty (feminine)"},
+        {"cats:16\x04must be empty", "must be empty (plural)"},
+        {"cats:1,16\x04must be empty", "must be empty (feminine plural)"},
+        {"field", "поле"},
+        {"grammar:\x04" "field", "0"},
+        {"cats:16\x04" "field", "поля"},
+        {"grammar:16\x04" "field", "16"},
+        {"price", "цена"},
+        {"grammar:\x04" "price", "1"},
+        {std::string("value\0values",12), std::string("value translated\0values translated",34)}
+    };
+}
+
+void checkTranslator(const mo_translator& tr)
+{
+    BOOST_CHECK_EQUAL(tr.size(),make_messages().size());
+
+    BOOST_CHECK_EQUAL(std::string(tr("must be greater than or equal to")),"должен быть больше или равен");
+    BOOST_CHECK_EQUAL(std::string(tr("unknown")),"unknown");
+    BOOST_CHECK(!tr.translate(std::string("unknown")));
+    BOOST_CHECK(!tr.find("must be").found);
+
+    BOOST_CHECK_EQUAL(tr("must be empty").text(),"must be empty (default)");
+    BOOST_CHECK_EQUAL(tr("must be empty",grammar_categories_bitmask(grammar::feminine)).text(),"must be empty (feminine)");
+    BOOST_CHECK_EQUAL(tr("must be empty",grammar_categories_bitmask(grammar::plural)).text(),"must be empty (plural)");
+    BOOST_CHECK_EQUAL(tr("must be empty",grammar_categories_bitmask(grammar::plural,grammar::feminine)).text(),"must be empty (feminine plural)");
+    BOOST_CHECK_EQUAL(tr("must be empty",grammar_categories_bitmask(grammar::masculine)).text(),"must be empty (default)");
+    BOOST_CHECK_EQUAL(tr("must be empty",grammar_categories_bitmask(grammar::masculine,grammar::feminine)).text(),"must be empty (feminine)");
+
+    auto field=tr("field");
+    BOOST_CHECK_EQUAL(field.text(),"поле");
+    BOOST_CHECK_EQUAL(field.grammar_cats(),grammar_categories_bitmask(grammar::neuter));
+    auto fields=tr("field",grammar_categories_bitmask(grammar::plural));
+    BOOST_CHECK_EQUAL(fields.text(),"поля");
+    BOOST_CHECK_EQUAL(fields.grammar_cats(),grammar_categories_bitmask(grammar::plural));
+
+    BOOST_CHECK_EQUAL(tr("value").text(),"value translated");
+    BOOST_CHECK_EQUAL(tr("value",grammar_categories_bitmask(grammar::plural)).text(),"values translated");
+    BOOST_CHECK(!tr.find("values").found);
+
+    auto phrase=tr.find("price");
+    BOOST_CHECK(phrase.found);
+    BOOST_CHECK_EQUAL(std::string(phrase.text.data(),phrase.text.size()),"цена");
+    BOOST_CHECK_EQUAL(phrase.grammar_cats,grammar_categories_bitmask(grammar::feminine));
+}
+
+}
+
+BOOST_AUTO_TEST_SUITE(TestMoTranslator)
+
+BOOST_AUTO_TEST_CASE(CheckMoTranslatorBuffer)
+{
+    auto mo=make_mo(make_messages());
+    mo_translator tr{mo.data(),mo.size()};
+    checkTranslator(tr);
+
+    auto mo_sorted=make_mo(make_messages(),false);
+    mo_translator tr_sorted{mo_sorted.data(),mo_sorted.size()};
+    checkTranslator(tr_sorted);
+
+    auto mo_be=make_mo(make_messages(),true,true);
+    mo_translator tr_be{mo_be.data(),mo_be.size()};
+    checkTranslator(tr_be);
+
+    auto tr_copy=tr;
+    checkTranslator(tr_copy);
+
+    tr_copy.reset();
+    BOOST_CHECK(tr_copy.empty());
+    BOOST_CHECK_EQUAL(std::string(tr_copy("field")),"field");
+
+    std::string invalid("invalid catalog of enough size to read header");
+    BOOST_CHECK_THROW(mo_translator(invalid.data(),invalid.size()),mo_error);
+    BOOST_CHECK_THROW(mo_translator(mo.data(),10),mo_error);
+}
+
+BOOST_AUTO_TEST_CASE(CheckMoTranslatorFile)
+{
+    std::string file_name("testmotranslator.mo");
+    {
+        auto mo=make_mo(make_messages());
+        std::ofstream f(file_name,std::ios::binary);
+        f.write(mo.data(),static_cast<std::streamsize>(mo.size()));
+    }
+
+    {
+        mo_translator tr{file_name};
+        checkTranslator(tr);
+
+        std::string rep;
+        std::map<std::string,int> m1{{"field",1}};
+        auto v=validator(
+            _["field"](gte,10)
+        );
+        auto ra=make_reporting_adapter(m1,make_reporter(rep,make_formatter(tr)));
+        BOOST_CHECK(!v.apply(ra));
+        BOOST_CHECK_EQUAL(rep,"поле должен быть больше или равен 10");
+    }
+    std::remove(file_name.c_str());
+
+    BOOST_CHECK_THROW(mo_translator(std::string("not_existing_file.mo")),mo_error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
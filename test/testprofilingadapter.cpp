@@ -0,0 +1,162 @@
+#include <cstdio>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/profiling_adapter.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestProfilingAdapter)
+
+BOOST_AUTO_TEST_CASE(CheckCounters)
+{
+    using map_type=std::map<std::string,std::vector<int>>;
+
+    auto v=validator(
+        _["field1"](size(gte,2)),
+        _["field2"][ALL](value(gte,10) ^OR^ value(eq,0)),
+        _["field3"](NOT(size(eq,0)))
+    );
+
+    profiler prof;
+    map_type m1{{"field1",{1,2}},{"field2",{10,0,20}},{"field3",{1}}};
+    map_type m2{{"field1",{1}},{"field2",{10}},{"field3",{1}}};
+    BOOST_CHECK(v.apply(make_profiling_adapter(m1,prof)));
+    BOOST_CHECK(!v.apply(make_profiling_adapter(m2,prof)));
+    BOOST_CHECK(v.apply(make_profiling_adapter(m1,prof)));
+
+    auto report=prof.report();
+    BOOST_CHECK_EQUAL(report.dropped(),0);
+
+    auto size_check=report.find(profiling_node_kind::check_member,"size of field1 must be greater than or equal to 2");
+    BOOST_REQUIRE(size_check!=nullptr);
+    BOOST_CHECK_EQUAL(size_check->evaluations,3);
+    BOOST_CHECK_EQUAL(size_check->failures,1);
+    BOOST_CHECK_EQUAL(size_check->ignores,0);
+
+    // elements of field2 are checked only when field1 passes
+    auto gte_check=report.find(profiling_node_kind::check_member,"each element of field2 must be greater than or equal to 10");
+    BOOST_REQUIRE(gte_check!=nullptr);
+    BOOST_CHECK_EQUAL(gte_check->evaluations,6);
+    BOOST_CHECK_EQUAL(gte_check->failures,2);
+
+    auto entries=report.entries();
+    BOOST_CHECK(!entries.empty());
+    size_t and_count=0;
+    for (auto&& entry:entries)
+    {
+        if (entry.kind==profiling_node_kind::aggregation_and && entry.label=="AND")
+        {
+            ++and_count;
+            BOOST_CHECK_EQUAL(entry.evaluations,3);
+            BOOST_CHECK_EQUAL(entry.failures,1);
+        }
+    }
+    BOOST_CHECK_EQUAL(and_count,1);
+
+    auto text=report.to_text();
+    BOOST_CHECK(text.find("size of field1 must be greater than or equal to 2")!=std::string::npos);
+    auto metrics=report.to_prometheus("test");
+    BOOST_CHECK(metrics.find("# TYPE test_evaluations_total counter")!=std::string::npos);
+    std::ostringstream node;
+    node<<std::hex<<size_check->node;
+    BOOST_CHECK(metrics.find("test_evaluations_total{kind=\"member\",node=\""+node.str()+"\",rule=\"size of field1 must be greater than or equal to 2\"} 3")!=std::string::npos);
+
+    std::string path="hatnvalidator_test_profiling.txt";
+    BOOST_CHECK(report.write_prometheus(path,"test"));
+    std::ifstream f(path);
+    std::string content((std::istreambuf_iterator<char>(f)),std::istreambuf_iterator<char>());
+    BOOST_CHECK_EQUAL(content,metrics);
+    f.close();
+    std::remove(path.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(CheckThreads)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,100)
+    );
+
+    profiler prof;
+    std::vector<std::thread> threads;
+    for (int i=0;i<4;i++)
+    {
+        threads.emplace_back(
+            [&v,&prof,i]()
+            {
+                for (int j=0;j<100;j++)
+                {
+                    map_type m{{"field1",j},{"field2",i}};
+                    v.apply(make_profiling_adapter(m,prof));
+                }
+            }
+        );
+    }
+    for (auto&& t:threads)
+    {
+        t.join();
+    }
+
+    auto report=prof.report();
+    auto check1=report.find(profiling_node_kind::check_member,"field1 must be greater than or equal to 10");
+    BOOST_REQUIRE(check1!=nullptr);
+    BOOST_CHECK_EQUAL(check1->evaluations,400);
+    BOOST_CHECK_EQUAL(check1->failures,40);
+    auto check2=report.find(profiling_node_kind::check_member,"field2 must be less than 100");
+    BOOST_REQUIRE(check2!=nullptr);
+    BOOST_CHECK_EQUAL(check2->evaluations,360);
+
+    profiling_report merged;
+    merged.merge(report);
+    merged.merge(report);
+    BOOST_CHECK_EQUAL(merged.find(profiling_node_kind::check_member,"field1 must be greater than or equal to 10")->evaluations,800);
+
+    profiler small(1);
+    map_type m{{"field1",10},{"field2",1}};
+    BOOST_CHECK(v.apply(make_profiling_adapter(m,small)));
+    BOOST_CHECK_EQUAL(small.report().entries().size(),1);
+    BOOST_CHECK_EQUAL(small.report().dropped(),2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckIdenticalRules)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10) ^OR^ _["field2"](eq,0),
+        _["field1"](gte,10) ^OR^ _["field2"](eq,1)
+    );
+
+    profiler prof;
+    map_type m1{{"field1",1},{"field2",0}};
+    BOOST_CHECK(!v.apply(make_profiling_adapter(m1,prof)));
+
+    // identical rules in different branches are reported separately
+    auto report=prof.report();
+    auto checks=report.find_all(profiling_node_kind::check_member,"field1 must be greater than or equal to 10");
+    BOOST_REQUIRE_EQUAL(checks.size(),2);
+    BOOST_CHECK(checks[0].node!=checks[1].node);
+    BOOST_CHECK_EQUAL(checks[0].evaluations,1);
+    BOOST_CHECK_EQUAL(checks[1].evaluations,1);
+    auto check=report.find(checks[1].node,profiling_node_kind::check_member);
+    BOOST_REQUIRE(check!=nullptr);
+    BOOST_CHECK_EQUAL(check->label,checks[1].label);
+
+    profiling_report merged;
+    merged.merge(report);
+    merged.merge(report);
+    BOOST_CHECK_EQUAL(merged.find_all(profiling_node_kind::check_member,"field1 must be greater than or equal to 10").size(),2);
+    BOOST_CHECK_EQUAL(merged.find(checks[0].node,profiling_node_kind::check_member)->evaluations,2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
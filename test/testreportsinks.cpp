@@ -0,0 +1,153 @@
+#include <map>
+#include <string>
+#include <sstream>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/reporting/fixed_buffer_sink.hpp>
+#include <hatn/validator/reporting/stream_sink.hpp>
+#include <hatn/validator/reporting/report_ring.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestReportSinks)
+
+BOOST_AUTO_TEST_CASE(CheckFixedBufferSink)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,5) ^OR^ _["field3"](eq,1)
+    );
+    map_type m1{{"field1",1},{"field2",1},{"field3",1}};
+    map_type m2{{"field1",10},{"field2",10},{"field3",0}};
+
+    std::string rep;
+    fixed_buffer_sink<512> sink;
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,sink)));
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,rep)));
+    BOOST_CHECK_EQUAL(sink.str(),rep);
+    BOOST_CHECK_EQUAL(sink.str(),std::string("field1 must be greater than or equal to 10"));
+    BOOST_CHECK(!sink.truncated());
+    BOOST_CHECK(!sink.on_heap());
+
+    rep.clear();
+    sink.clear();
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,sink)));
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,rep)));
+    BOOST_CHECK_EQUAL(sink.str(),rep);
+    BOOST_CHECK_EQUAL(sink.str(),std::string("field2 must be less than 5 OR field3 must be equal to 1"));
+
+    // truncation
+    fixed_buffer_sink<16> small_sink;
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,small_sink)));
+    BOOST_CHECK(small_sink.truncated());
+    BOOST_CHECK_EQUAL(small_sink.str(),std::string("field2 must be l"));
+
+    // truncation does not split UTF-8 characters
+    auto v_utf8=validator(
+        _["field1"](gte,10)("поле")
+    );
+    fixed_buffer_sink<5> utf8_sink;
+    BOOST_CHECK(!v_utf8.apply(make_reporting_adapter(m1,utf8_sink)));
+    BOOST_CHECK(utf8_sink.truncated());
+    BOOST_CHECK_EQUAL(utf8_sink.str(),std::string("по"));
+
+    // heap fallback
+    fixed_buffer_sink<16,true> heap_sink;
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m2,heap_sink)));
+    BOOST_CHECK(!heap_sink.truncated());
+    BOOST_CHECK(heap_sink.on_heap());
+    BOOST_CHECK_EQUAL(heap_sink.str(),rep);
+}
+
+BOOST_AUTO_TEST_CASE(CheckStreamSink)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,5) ^OR^ _["field3"](eq,1)
+    );
+    map_type m1{{"field1",1},{"field2",1},{"field3",1}};
+    map_type m2{{"field1",10},{"field2",10},{"field3",0}};
+    map_type m3{{"field1",10},{"field2",1},{"field3",1}};
+
+    std::ostringstream os;
+    {
+        auto sink=make_ostream_sink(os);
+        BOOST_CHECK(!v.apply(make_reporting_adapter(m1,sink)));
+        sink.flush();
+        BOOST_CHECK(v.apply(make_reporting_adapter(m3,sink)));
+        sink.flush();
+        BOOST_CHECK(!v.apply(make_reporting_adapter(m2,sink)));
+    }
+    BOOST_CHECK_EQUAL(os.str(),std::string(
+                          "field1 must be greater than or equal to 10\n"
+                          "field2 must be less than 5 OR field3 must be equal to 1\n"
+                      ));
+
+    // sink with small buffer streams report in parts
+    std::ostringstream os1;
+    {
+        stream_sink<ostream_writer,8> sink(os1);
+        BOOST_CHECK(!v.apply(make_reporting_adapter(m2,sink)));
+    }
+    BOOST_CHECK_EQUAL(os1.str(),std::string("field2 must be less than 5 OR field3 must be equal to 1\n"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckRingSink)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,5) ^OR^ _["field3"](eq,1)
+    );
+    map_type m1{{"field1",1},{"field2",1},{"field3",1}};
+    map_type m2{{"field1",10},{"field2",10},{"field3",0}};
+
+    report_ring<32,4> ring;
+    {
+        auto sink=make_ring_sink(ring);
+        for (size_t i=0;i<5;i++)
+        {
+            BOOST_CHECK(!v.apply(make_reporting_adapter(i==0 ? m2 : m1,sink)));
+            sink.flush();
+        }
+    }
+    BOOST_CHECK_EQUAL(ring.dropped(),1);
+
+    std::vector<std::string> reports;
+    std::vector<bool> truncated;
+    while (ring.consume(
+               [&](string_view report, bool is_truncated)
+               {
+                   reports.emplace_back(report.data(),report.size());
+                   truncated.push_back(is_truncated);
+               }
+           ))
+    {}
+    BOOST_REQUIRE_EQUAL(reports.size(),4);
+    BOOST_CHECK_EQUAL(reports[0],std::string("field2 must be less than 5 OR fi"));
+    BOOST_CHECK(truncated[0]);
+    BOOST_CHECK_EQUAL(reports[1],std::string("field1 must be greater than or e"));
+    BOOST_CHECK(truncated[1]);
+
+    // slots are reused after consuming
+    auto v1=validator(_["field1"](gte,10));
+    {
+        auto sink=make_ring_sink(ring);
+        BOOST_CHECK(!v1.apply(make_reporting_adapter(m1,sink)));
+    }
+    std::string report;
+    BOOST_CHECK(ring.consume([&](string_view r, bool){report.assign(r.data(),r.size());}));
+    BOOST_CHECK_EQUAL(report,std::string("field1 must be greater than or e"));
+    BOOST_CHECK(!ring.consume([](string_view, bool){}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
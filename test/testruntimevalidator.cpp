@@ -0,0 +1,250 @@
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate.hpp>
+#include <hatn/validator/operators/in.hpp>
+#include <hatn/validator/runtime_validator.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestRuntimeValidator)
+
+BOOST_AUTO_TEST_CASE(CheckScalarRules)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=runtime_validator::compile(R"(_["a"](gte,10), _["b"](in,interval(1,5,interval.open())))");
+    auto v1=validator(_["a"](gte,10),_["b"](in,interval(1,5,interval.open())));
+
+    std::vector<map_type> objects={
+        {{"a",10},{"b",2}},
+        {{"a",9},{"b",2}},
+        {{"a",10},{"b",5}},
+        {{"a",100},{"b",1}},
+        {{"a",100},{"b",4}}
+    };
+    for (auto&& obj:objects)
+    {
+        BOOST_CHECK_EQUAL(bool(v.apply(obj)),bool(v1.apply(obj)));
+    }
+
+    // missing member fails validation
+    map_type m1{{"a",10}};
+    BOOST_CHECK(!v.apply(m1));
+
+    error err;
+    validate(objects[0],v,err);
+    BOOST_CHECK(!err);
+    validate(objects[1],v,err);
+    BOOST_CHECK(err);
+
+    auto v2=runtime_validator::compile(R"(_["a"](gte,10.5) ^OR^ _["b"](eq,_["a"]))");
+    BOOST_CHECK(v2.apply(map_type{{"a",11},{"b",0}}));
+    BOOST_CHECK(!v2.apply(map_type{{"a",10},{"b",0}}));
+    BOOST_CHECK(v2.apply(map_type{{"a",10},{"b",10}}));
+
+    auto v3=runtime_validator::compile(R"(NOT(_["a"](in,range({1,3,5}))), AND(_["b"](ne,0),OR(_["b"](lt,-10),_["b"](gt,10))))");
+    BOOST_CHECK(v3.apply(map_type{{"a",2},{"b",20}}));
+    BOOST_CHECK(!v3.apply(map_type{{"a",3},{"b",20}}));
+    BOOST_CHECK(!v3.apply(map_type{{"a",2},{"b",5}}));
+    BOOST_CHECK(v3.apply(map_type{{"a",2},{"b",-20}}));
+}
+
+BOOST_AUTO_TEST_CASE(CheckContainers)
+{
+    using map_type=std::map<std::string,std::vector<int>>;
+
+    auto v=runtime_validator::compile(R"(_["v"][ALL](gt,0), _["v"](size(gte,2) ^AND^ ANY(value(eq,3))), _["v"][1](lt,100))");
+    BOOST_CHECK(v.apply(map_type{{"v",{1,3}}}));
+    BOOST_CHECK(v.apply(map_type{{"v",{3,2,1}}}));
+    BOOST_CHECK(!v.apply(map_type{{"v",{0,3}}}));
+    BOOST_CHECK(!v.apply(map_type{{"v",{3}}}));
+    BOOST_CHECK(!v.apply(map_type{{"v",{1,2}}}));
+    BOOST_CHECK(!v.apply(map_type{{"v",{3,200}}}));
+
+    auto v1=runtime_validator::compile(R"(_["v"][ALL](gt,0))");
+    auto v2=runtime_validator::compile(R"(_["v"][ANY](gt,0))");
+    map_type empty{{"v",{}}};
+    BOOST_CHECK(v1.apply(empty));
+    BOOST_CHECK(!v2.apply(empty));
+    BOOST_CHECK(runtime_validator::compile(R"(_["v"](empty(flag,true)))").apply(empty));
+
+    using nested_type=std::map<std::string,std::map<std::string,std::vector<std::string>>>;
+    auto v3=runtime_validator::compile(R"(_["users"][ANY][ALL](length(gte,3) ^AND^ value(regex_match,"[a-z]+")))");
+    BOOST_CHECK(v3.apply(nested_type{{"users",{{"one",{"abc","xyz"}},{"two",{"a1"}}}}}));
+    BOOST_CHECK(!v3.apply(nested_type{{"users",{{"one",{"abc","x"}},{"two",{"a1"}}}}}));
+}
+
+BOOST_AUTO_TEST_CASE(CheckStrings)
+{
+    using map_type=std::map<std::string,std::string>;
+
+    auto v=runtime_validator::compile(
+        R"(_["name"](length(gte,2) ^AND^ value(ilex_starts_with,"AB")),
+           _["mail"](regex_contains,"@"),
+           _["code"](in,range({"x","y"})),
+           _["copy"](lex_eq,_["name"])
+        )"
+    );
+    map_type m1{{"name","abc"},{"mail","a@b"},{"code","x"},{"copy","abc"}};
+    BOOST_CHECK(v.apply(m1));
+
+    auto m2=m1;
+    m2["name"]="xbc";
+    m2["copy"]="xbc";
+    BOOST_CHECK(!v.apply(m2));
+
+    m2=m1;
+    m2["mail"]="ab";
+    BOOST_CHECK(!v.apply(m2));
+
+    m2=m1;
+    m2["code"]="z";
+    BOOST_CHECK(!v.apply(m2));
+
+    m2=m1;
+    m2["copy"]="abd";
+    BOOST_CHECK(!v.apply(m2));
+
+    // mismatching types fail validation
+    BOOST_CHECK(!runtime_validator::compile(R"(_["name"](gt,1))").apply(m1));
+}
+
+BOOST_AUTO_TEST_CASE(CheckSerialize)
+{
+    using map_type=std::map<std::string,std::vector<int>>;
+
+    auto v=runtime_validator::compile(R"(_["v"][ALL](in,interval(1,10)), _["v"](size(lte,3)), _["s"](NOT(ANY(value(regex_match,"[0-9]")))))");
+    auto blob=v.serialize();
+
+    std::vector<uint64_t> buf(blob.size()/sizeof(uint64_t)+1);
+    std::memcpy(buf.data(),blob.data(),blob.size());
+    auto v1=runtime_validator::load(buf.data(),blob.size());
+    BOOST_CHECK_EQUAL(v1.serialize(),blob);
+    BOOST_CHECK_EQUAL(v1.plan().instruction_count,v.plan().instruction_count);
+
+    std::vector<map_type> objects={
+        {{"v",{1,2}},{"s",{}}},
+        {{"v",{0,2}},{"s",{}}},
+        {{"v",{1,2,3,4}},{"s",{}}},
+        {{"v",{1,2}}}
+    };
+    for (auto&& obj:objects)
+    {
+        BOOST_CHECK_EQUAL(bool(v1.apply(obj)),bool(v.apply(obj)));
+    }
+    BOOST_CHECK(v1.apply(objects[0]));
+    BOOST_CHECK(!v1.apply(objects[1]));
+
+    // truncated blob
+    BOOST_CHECK_THROW(runtime_validator::load(buf.data(),blob.size()/2),rule_error);
+
+    // invalid magic
+    auto buf1=buf;
+    reinterpret_cast<char*>(buf1.data())[0]='X';
+    BOOST_CHECK_THROW(runtime_validator::load(buf1.data(),blob.size()),rule_error);
+
+    // backward jump
+    auto buf2=buf;
+    auto header=reinterpret_cast<runtime::plan_header*>(buf2.data());
+    auto instructions=reinterpret_cast<runtime::instruction*>(
+            reinterpret_cast<char*>(buf2.data())+sizeof(runtime::plan_header)+header->operand_count*sizeof(runtime::operand_entry)
+        );
+    for (uint32_t i=0;i<header->instruction_count;i++)
+    {
+        if (instructions[i].code==static_cast<uint8_t>(runtime::opcode::jump_if_false))
+        {
+            instructions[i].a=0;
+        }
+    }
+    BOOST_CHECK_THROW(runtime_validator::load(buf2.data(),blob.size()),rule_error);
+
+    auto patch=[&](auto&& fn)
+    {
+        auto b=buf;
+        auto h=reinterpret_cast<runtime::plan_header*>(b.data());
+        auto operands=reinterpret_cast<runtime::operand_entry*>(
+                reinterpret_cast<char*>(b.data())+sizeof(runtime::plan_header)
+            );
+        auto ins=reinterpret_cast<runtime::instruction*>(
+                reinterpret_cast<char*>(operands)+h->operand_count*sizeof(runtime::operand_entry)
+            );
+        fn(h,operands,ins);
+        return b;
+    };
+
+    // too many regular expressions
+    auto buf3=patch([](runtime::plan_header* h, runtime::operand_entry*, runtime::instruction*)
+    {
+        h->regex_count=0x10000000;
+    });
+    BOOST_CHECK_THROW(runtime_validator::load(buf3.data(),blob.size()),rule_error);
+
+    // operand does not fit operator
+    auto buf4=patch([](runtime::plan_header* h, runtime::operand_entry*, runtime::instruction* ins)
+    {
+        for (uint32_t i=0;i<h->instruction_count;i++)
+        {
+            if (ins[i].code==static_cast<uint8_t>(runtime::opcode::check) && ins[i].op==static_cast<uint8_t>(runtime::operator_code::in))
+            {
+                ins[i].op=static_cast<uint8_t>(runtime::operator_code::regex_match);
+            }
+        }
+    });
+    BOOST_CHECK_THROW(runtime_validator::load(buf4.data(),blob.size()),rule_error);
+
+    // enter body crosses end of enclosing body
+    auto buf5=patch([](runtime::plan_header* h, runtime::operand_entry*, runtime::instruction* ins)
+    {
+        for (uint32_t i=0;i<h->instruction_count;i++)
+        {
+            if (ins[i].code==static_cast<uint8_t>(runtime::opcode::enter) && ins[i].b+1<h->instruction_count)
+            {
+                ins[i].b=h->instruction_count;
+            }
+        }
+    });
+    BOOST_CHECK_THROW(runtime_validator::load(buf5.data(),blob.size()),rule_error);
+}
+
+BOOST_AUTO_TEST_CASE(CheckErrors)
+{
+    BOOST_CHECK_THROW(runtime_validator::compile(""),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](unknown,1))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](gte,10)"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](gte,"10))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](regex_match,10))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](regex_match,"["))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](gte,_[ALL]))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](gte,1) ^XOR^ _["b"](gte,1))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](in,10))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](nin,_["b"]))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](gte,interval(1,10)))"),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(R"(_["a"](eq,range({1,2})))"),rule_error);
+
+    // nesting depth is limited
+    std::string nested;
+    for (size_t i=0;i<runtime::plan_max_depth+1;i++)
+    {
+        nested+="NOT(";
+    }
+    nested+=R"(_["a"](gte,1))";
+    nested+=std::string(runtime::plan_max_depth+1,')');
+    BOOST_CHECK_THROW(runtime_validator::compile(nested),rule_error);
+    BOOST_CHECK_THROW(runtime_validator::compile(std::string(100000,'(')),rule_error);
+
+    std::string path=R"(_["a"])";
+    for (size_t i=0;i<runtime::plan_max_depth+1;i++)
+    {
+        path+="[ALL]";
+    }
+    BOOST_CHECK_THROW(runtime_validator::compile(path+"(gte,1)"),rule_error);
+    BOOST_CHECK_NO_THROW(runtime_validator::compile(R"(_["a"][ALL][ALL][ALL](gte,1))"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
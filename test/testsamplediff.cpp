@@ -0,0 +1,126 @@
+#include <functional>
+#include <map>
+#include <string>
+#include <unordered_map>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/sample_diff.hpp>
+
+namespace hana=boost::hana;
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestSampleDiff)
+
+BOOST_AUTO_TEST_CASE(CheckDiffWithMasterSample)
+{
+    std::map<std::string,int> sample{
+        {"field1",1},{"field2",2},{"field3",3},{"field5",5}
+    };
+    std::map<std::string,int> m1{
+        {"field0",0},{"field2",2},{"field3",30},{"field4",4},{"field5",5}
+    };
+
+    auto diff=diff_with_master_sample(m1,sample);
+    BOOST_REQUIRE_EQUAL(diff.entries().size(),4);
+    BOOST_CHECK(diff.entries()[0].kind==sample_diff_kind::added);
+    BOOST_CHECK_EQUAL(diff.entries()[0].key,"field0");
+    BOOST_CHECK(diff.entries()[1].kind==sample_diff_kind::missing);
+    BOOST_CHECK_EQUAL(diff.entries()[1].key,"field1");
+    BOOST_CHECK(diff.entries()[2].kind==sample_diff_kind::changed);
+    BOOST_CHECK_EQUAL(diff.entries()[2].key,"field3");
+    BOOST_CHECK(diff.entries()[3].kind==sample_diff_kind::added);
+    BOOST_CHECK_EQUAL(diff.entries()[3].key,"field4");
+    BOOST_CHECK_EQUAL(diff.count(sample_diff_kind::added),2);
+    BOOST_CHECK_EQUAL(diff.count(sample_diff_kind::missing),1);
+    BOOST_CHECK_EQUAL(diff.count(sample_diff_kind::changed),1);
+
+    // custom operator
+    auto diff2=diff_with_master_sample(m1,sample,gte);
+    BOOST_CHECK_EQUAL(diff2.count(sample_diff_kind::changed),0);
+    BOOST_CHECK(diff_with_master_sample(sample,sample).empty());
+
+    // unordered containers
+    std::unordered_map<std::string,int> u1(m1.begin(),m1.end());
+    std::unordered_map<std::string,int> usample(sample.begin(),sample.end());
+    auto diff3=diff_with_master_sample(u1,usample);
+    BOOST_CHECK_EQUAL(diff3.count(sample_diff_kind::added),2);
+    BOOST_CHECK_EQUAL(diff3.count(sample_diff_kind::missing),1);
+    BOOST_REQUIRE_EQUAL(diff3.keys(sample_diff_kind::changed).size(),1);
+    BOOST_CHECK_EQUAL(diff3.keys(sample_diff_kind::changed)[0],"field3");
+
+    // containers ordered differently
+    std::map<std::string,int,std::greater<std::string>> rsample(sample.begin(),sample.end());
+    BOOST_CHECK(diff_with_master_sample(sample,rsample).empty());
+    BOOST_CHECK(diff_with_master_sample(rsample,sample).empty());
+    auto diff4=diff_with_master_sample(m1,rsample);
+    BOOST_CHECK_EQUAL(diff4.count(sample_diff_kind::added),2);
+    BOOST_CHECK_EQUAL(diff4.count(sample_diff_kind::missing),1);
+    BOOST_REQUIRE_EQUAL(diff4.keys(sample_diff_kind::changed).size(),1);
+    BOOST_CHECK_EQUAL(diff4.keys(sample_diff_kind::changed)[0],"field3");
+}
+
+BOOST_AUTO_TEST_CASE(CheckValidateDiff)
+{
+    std::map<std::string,int> sample{
+        {"field1",1},{"field2",2},{"field3",3}
+    };
+
+    error_report err;
+    std::map<std::string,int> m1=sample;
+    validate_diff(m1,sample,err);
+    BOOST_CHECK(!err);
+
+    m1["field2"]=20;
+    validate_diff(m1,sample,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field2 must be equal to field2 of sample"));
+
+    validate_diff(m1,sample,gte,err);
+    BOOST_CHECK(!err);
+
+    m1.erase("field1");
+    validate_diff(m1,sample,gte,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field1 must exist"));
+
+    m1["field1"]=1;
+    m1["field0"]=0;
+    validate_diff(m1,sample,gte,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field0 must not exist"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckValidateUnchanged)
+{
+    std::map<std::string,std::string> v1{
+        {"id","12345"},{"name","John"}
+    };
+    std::map<std::string,std::string> v2{
+        {"id","12345"},{"name","Bill"}
+    };
+
+    error_report err;
+    validate_unchanged(v2,v1,hana::make_tuple(_["id"]),err);
+    BOOST_CHECK(!err);
+
+    validate_unchanged(v2,v1,hana::make_tuple(_["id"],_["name"]),err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("name must be equal to name of sample"));
+
+    v2["id"]="54321";
+    BOOST_CHECK_THROW(validate_unchanged(v2,v1,hana::make_tuple(_["id"])),validation_error);
+
+    v2.erase("id");
+    validate_unchanged(v2,v1,hana::make_tuple(_["id"]),err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("id must exist"));
+
+    v2["created"]="today";
+    validate_unchanged(v2,v1,hana::make_tuple(_["created"]),err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("created must not exist"));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -1,3 +1,7 @@
+#include <sstream>
+#include <string>
+#include <vector>
+
 #include <boost/test/unit_test.hpp>
 
 #include <hatn/validator/config.hpp>
@@ -74,4 +78,44 @@ BOOST_AUTO_TEST_CASE(CheckStdFormatterWithRvals)
     checkFormatterWithRvals(make_backend_formatter);
 }
 
+BOOST_AUTO_TEST_CASE(CheckStdFormatterValues)
+{
+    std::string dst;
+    auto f=make_backend_formatter(dst);
+
+    f.append_join_args(",",0,-1,100,-2147483647-1,4294967295u,-9223372036854775807LL-1,18446744073709551615ULL);
+    BOOST_CHECK_EQUAL(dst,std::string("0,-1,100,-2147483648,4294967295,-9223372036854775808,18446744073709551615"));
+
+    dst.clear();
+    f.append_join_args(",",true,false,'a',static_cast<short>(-5),static_cast<unsigned short>(7));
+    BOOST_CHECK_EQUAL(dst,std::string("1,0,a,-5,7"));
+
+    dst.clear();
+    f.append_join_args(",",1.5,0.1,100.0,-2.25f,1234567.0,0.0001,1e-5,1e20);
+    std::ostringstream ss;
+    ss<<1.5<<","<<0.1<<","<<100.0<<","<<-2.25f<<","<<1234567.0<<","<<0.0001<<","<<1e-5<<","<<1e20;
+    BOOST_CHECK_EQUAL(dst,ss.str());
+
+    dst.clear();
+    std::string str("string");
+    f.append("Hello"," ",str," ",string_view("view"));
+    BOOST_CHECK_EQUAL(dst,std::string("Hello string view"));
+
+    dst.clear();
+    std::vector<std::string> parts;
+    std::string expected;
+    for (size_t i=0;i<100;i++)
+    {
+        parts.push_back(std::to_string(i));
+        if (i!=0)
+        {
+            expected+=" and ";
+        }
+        expected+=parts.back();
+    }
+    f.append_join(" and ",parts);
+    BOOST_CHECK_EQUAL(dst,expected);
+    BOOST_CHECK(dst.capacity()>=HATN_VALIDATOR_REPORT_RESERVE);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,168 @@
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/reporting/structured_reporter.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestStructuredReport)
+
+BOOST_AUTO_TEST_CASE(CheckJsonReport)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10),
+        _["field2"](lt,5) ^OR^ _["field3"](eq,1)
+    );
+
+    std::string dst;
+    map_type m1{{"field1",1},{"field2",1},{"field3",1}};
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,make_json_reporter(dst))));
+    BOOST_CHECK_EQUAL(dst,
+        "{\"kind\":\"check\",\"negated\":false,\"member\":\"field1\",\"operator\":\"must be greater than or equal to\","
+        "\"property\":\"value\",\"operand\":\"10\",\"phrase\":\"field1 must be greater than or equal to 10\"}\n"
+    );
+
+    // records of failed operands of succeeded OR are discarded
+    dst.clear();
+    map_type m2{{"field1",10},{"field2",10},{"field3",1}};
+    BOOST_CHECK(v.apply(make_reporting_adapter(m2,make_json_reporter(dst))));
+    BOOST_CHECK(dst.empty());
+
+    dst.clear();
+    map_type m3{{"field1",10},{"field2",10},{"field3",0}};
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m3,make_json_reporter(dst))));
+    BOOST_CHECK_EQUAL(dst,
+        "{\"kind\":\"check\",\"negated\":false,\"member\":\"field2\",\"operator\":\"must be less than\","
+        "\"property\":\"value\",\"operand\":\"5\",\"phrase\":\"field2 must be less than 5\"}\n"
+        "{\"kind\":\"check\",\"negated\":false,\"member\":\"field3\",\"operator\":\"must be equal to\","
+        "\"property\":\"value\",\"operand\":\"1\",\"phrase\":\"field3 must be equal to 1\"}\n"
+    );
+
+    // checks under NOT are reported as negated
+    auto v2=validator(
+        _["field1"](NOT(value(gte,10)))
+    );
+    dst.clear();
+    BOOST_CHECK(!v2.apply(make_reporting_adapter(m2,make_json_reporter(dst))));
+    BOOST_CHECK(dst.find("\"negated\":true,\"member\":\"field1\"")!=std::string::npos);
+    dst.clear();
+    BOOST_CHECK(v2.apply(make_reporting_adapter(m1,make_json_reporter(dst))));
+    BOOST_CHECK(dst.empty());
+
+    // hints replace records of nested checks
+    auto v3=validator(
+        _["field1"](gte,10)(R"(field1 is "too small"	)")
+    );
+    dst.clear();
+    BOOST_CHECK(!v3.apply(make_reporting_adapter(m1,make_json_reporter(dst))));
+    BOOST_CHECK_EQUAL(dst,
+        "{\"kind\":\"hint\",\"negated\":false,\"member\":\"\",\"operator\":\"\","
+        "\"property\":\"\",\"operand\":\"\",\"phrase\":\"field1 is \\\"too small\\\"\\t\"}\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(CheckJsonReportElements)
+{
+    using map_type=std::map<std::string,std::vector<int>>;
+
+    auto v=validator(
+        _["field1"](ALL(value(gte,10))),
+        _["field2"](size(lt,2))
+    );
+
+    std::string dst;
+    map_type m1{{"field1",{1,2,20}},{"field2",{1,2}}};
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,make_json_reporter(dst))));
+
+    // only the first failed element is reported
+    BOOST_CHECK_EQUAL(dst,
+        "{\"kind\":\"check\",\"negated\":false,\"member\":\"field1.ALL\",\"operator\":\"must be greater than or equal to\","
+        "\"property\":\"value\",\"operand\":\"10\",\"phrase\":\"each element of field1 must be greater than or equal to 10\"}\n"
+    );
+}
+
+BOOST_AUTO_TEST_CASE(CheckBinaryReport)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,10) ^OR^ _["field2"](lt,5)
+    );
+
+    std::vector<uint8_t> dst;
+    map_type m1{{"field1",1},{"field2",10}};
+    BOOST_CHECK(!v.apply(make_reporting_adapter(m1,make_binary_reporter(dst))));
+
+    auto read_record=[&dst](size_t& pos)
+    {
+        std::vector<std::string> fields;
+        BOOST_REQUIRE(pos+2<=dst.size());
+        BOOST_CHECK_EQUAL(dst[pos],static_cast<uint8_t>(structured_record_kind::check));
+        BOOST_CHECK_EQUAL(dst[pos+1],0);
+        pos+=2;
+        for (size_t i=0;i<5;i++)
+        {
+            size_t size=0;
+            size_t shift=0;
+            uint8_t byte=0;
+            do
+            {
+                byte=dst.at(pos++);
+                size|=static_cast<size_t>(byte&0x7F)<<shift;
+                shift+=7;
+            }
+            while ((byte&0x80)!=0);
+            BOOST_REQUIRE(pos+size<=dst.size());
+            fields.emplace_back(reinterpret_cast<const char*>(dst.data()+pos),size);
+            pos+=size;
+        }
+        return fields;
+    };
+
+    size_t pos=0;
+    auto r1=read_record(pos);
+    BOOST_CHECK_EQUAL(r1.at(0),"field1");
+    BOOST_CHECK_EQUAL(r1.at(1),"must be greater than or equal to");
+    BOOST_CHECK_EQUAL(r1.at(2),"value");
+    BOOST_CHECK_EQUAL(r1.at(3),"10");
+    BOOST_CHECK_EQUAL(r1.at(4),"field1 must be greater than or equal to 10");
+
+    auto r2=read_record(pos);
+    BOOST_CHECK_EQUAL(r2.at(0),"field2");
+    BOOST_CHECK_EQUAL(r2.at(4),"field2 must be less than 5");
+    BOOST_CHECK_EQUAL(pos,dst.size());
+}
+
+BOOST_AUTO_TEST_CASE(CheckBufferedWriter)
+{
+    std::string dst;
+    buffered_writer<std::string,8> writer(dst);
+
+    writer.write("abc");
+    BOOST_CHECK(dst.empty());
+    BOOST_CHECK_EQUAL(writer.size(),3);
+    writer.write("defghijkl");
+    BOOST_CHECK_EQUAL(writer.size(),12);
+    writer.put('m');
+    writer.flush();
+    BOOST_CHECK_EQUAL(dst,"abcdefghijklm");
+
+    writer.write("nop");
+    writer.truncate(5);
+    BOOST_CHECK_EQUAL(dst,"abcde");
+    BOOST_CHECK_EQUAL(writer.size(),5);
+
+    std::string long_str(1000,'x');
+    writer.write(long_str);
+    writer.flush();
+    BOOST_CHECK_EQUAL(dst.size(),1005);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
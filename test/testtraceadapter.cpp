@@ -0,0 +1,158 @@
+#define HATN_VALIDATOR_TRACE
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/trace_adapter.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestTraceAdapter)
+
+BOOST_AUTO_TEST_CASE(CheckTrace)
+{
+    using map_type=std::map<std::string,std::vector<int>>;
+
+    auto v=validator(
+        _["field1"](size(gte,2)),
+        _["field2"][ALL](value(gte,10) ^OR^ value(eq,0))
+    );
+
+    trace_recorder recorder;
+    map_type m1{{"field1",{1,2}},{"field2",{10,0}}};
+    BOOST_CHECK(v.apply(make_trace_adapter(m1,recorder)));
+
+    // AND of two members, ALL of two elements, OR for each element, OR of the first element stops after the first check
+    BOOST_REQUIRE_EQUAL(recorder.size(),12);
+    BOOST_CHECK_EQUAL(recorder.total(),12);
+
+    const auto& first=recorder.at(0);
+    BOOST_CHECK(first.event==trace_event::aggregation_open);
+    BOOST_CHECK_EQUAL(first.depth,0);
+    BOOST_CHECK_EQUAL(recorder.label(first.node),"AND");
+
+    const auto& size_check=recorder.at(1);
+    BOOST_CHECK(size_check.event==trace_event::validate);
+    BOOST_CHECK_EQUAL(size_check.depth,1);
+    BOOST_CHECK(size_check.result==status::code::success);
+    BOOST_CHECK_EQUAL(recorder.label(size_check.node),"size of field1 must be greater than or equal to 2");
+
+    const auto& all_open=recorder.at(2);
+    BOOST_CHECK(all_open.event==trace_event::aggregation_open);
+    BOOST_CHECK_EQUAL(all_open.depth,1);
+    BOOST_CHECK_EQUAL(recorder.label(all_open.node),"ALL of field2");
+    const auto& all_close=recorder.at(10);
+    BOOST_CHECK(all_close.event==trace_event::aggregation_close);
+    BOOST_CHECK_EQUAL(all_close.node,all_open.node);
+    BOOST_CHECK(all_close.result==status::code::success);
+
+    // checks of each element share the node, positions of elements are kept in records
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(4).node),"each element of field2 must be greater than or equal to 10");
+    BOOST_CHECK_EQUAL(recorder.at(4).node,recorder.at(7).node);
+    BOOST_CHECK_EQUAL(recorder.at(4).element,0);
+    BOOST_CHECK_EQUAL(recorder.at(7).element,1);
+    BOOST_CHECK_EQUAL(recorder.at(7).level,1);
+    BOOST_CHECK_EQUAL(all_open.level,0);
+    BOOST_CHECK_EQUAL(recorder.description(4),"each element of field2 must be greater than or equal to 10 [0]");
+    BOOST_CHECK_EQUAL(recorder.description(7),"each element of field2 must be greater than or equal to 10 [1]");
+
+    const auto& last=recorder.at(11);
+    BOOST_CHECK(last.event==trace_event::aggregation_close);
+    BOOST_CHECK_EQUAL(last.depth,0);
+    BOOST_CHECK(last.result==status::code::success);
+    BOOST_CHECK(last.timestamp>=first.timestamp);
+
+    auto text=recorder.dump();
+    BOOST_CHECK(text.find("  size of field1 must be greater than or equal to 2: success\n")!=std::string::npos);
+    BOOST_CHECK(text.find("      each element of field2 must be equal to 0 [1]: success\n")!=std::string::npos);
+    BOOST_CHECK(text.find("] } success\n")!=std::string::npos);
+
+    recorder.clear();
+    map_type m2{{"field1",{1}},{"field2",{10}}};
+    BOOST_CHECK(!v.apply(make_trace_adapter(m2,recorder)));
+    BOOST_REQUIRE_EQUAL(recorder.size(),3);
+    BOOST_CHECK(recorder.at(1).result==status::code::fail);
+    BOOST_CHECK(recorder.at(2).result==status::code::fail);
+
+    // nested element aggregations
+    using nested_type=std::map<std::string,std::vector<std::vector<int>>>;
+    auto v2=validator(
+        _["field1"][ALL][ANY](gte,3)
+    );
+    recorder.clear();
+    nested_type m3{{"field1",{{1,2},{3}}}};
+    BOOST_CHECK(!v2.apply(make_trace_adapter(m3,recorder)));
+    BOOST_REQUIRE_EQUAL(recorder.size(),6);
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(0).node),"ALL of field1");
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(1).node),"ANY of each element of field1");
+    BOOST_CHECK_EQUAL(recorder.description(1),"ANY of each element of field1 [0]");
+    BOOST_CHECK_EQUAL(recorder.description(3),"at least one element of each element of field1 must be greater than or equal to 3 [0][1]");
+    BOOST_CHECK(recorder.at(5).result==status::code::fail);
+    BOOST_CHECK(recorder.dump().find("at least one element of each element of field1 must be greater than or equal to 3 [0][1]: fail\n")!=std::string::npos);
+
+    // element aggregations of different members are described separately
+    using vectors_type=std::map<std::string,std::vector<int>>;
+    auto v3=validator(
+        _["field1"][ALL](gte,1),
+        _["field2"][ALL](gte,1)
+    );
+    recorder.clear();
+    vectors_type m4{{"field1",{1}},{"field2",{1}}};
+    BOOST_CHECK(v3.apply(make_trace_adapter(m4,recorder)));
+    BOOST_REQUIRE_EQUAL(recorder.size(),8);
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(1).node),"ALL of field1");
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(4).node),"ALL of field2");
+
+    // number of nodes does not depend on number of elements
+    trace_recorder small(4096,1,5);
+    vectors_type m5{{"field1",std::vector<int>(100,1)},{"field2",std::vector<int>(100,1)}};
+    BOOST_CHECK(v3.apply(make_trace_adapter(m5,small)));
+    for (size_t i=0;i<small.size();i++)
+    {
+        BOOST_CHECK_NE(small.label(small.at(i).node),"<unknown>");
+    }
+}
+
+BOOST_AUTO_TEST_CASE(CheckRingBuffer)
+{
+    using map_type=std::map<std::string,int>;
+
+    auto v=validator(
+        _["field1"](gte,1),
+        _["field2"](lt,100)
+    );
+
+    trace_recorder recorder(6,2);
+    map_type m1{{"field1",10},{"field2",10}};
+    map_type m2{{"field1",0},{"field2",10}};
+
+    // only every second validation is traced
+    BOOST_CHECK(apply_sampled(v,m1,recorder));
+    BOOST_CHECK(!apply_sampled(v,m2,recorder));
+    BOOST_CHECK(!apply_sampled(v,m2,recorder));
+    BOOST_CHECK(apply_sampled(v,m1,recorder));
+    BOOST_CHECK_EQUAL(recorder.total(),7);
+    BOOST_CHECK_EQUAL(recorder.size(),6);
+
+    // opening record of the first traced validation was overwritten
+    BOOST_CHECK(recorder.at(0).event==trace_event::validate);
+    BOOST_CHECK_EQUAL(recorder.label(recorder.at(0).node),"field1 must be greater than or equal to 1");
+    BOOST_CHECK(recorder.at(0).result==status::code::success);
+    BOOST_CHECK(recorder.at(1).result==status::code::success);
+    BOOST_CHECK(recorder.at(2).result==status::code::success);
+    BOOST_CHECK(recorder.at(3).event==trace_event::aggregation_open);
+    BOOST_CHECK(recorder.at(4).result==status::code::fail);
+    BOOST_CHECK(recorder.at(5).event==trace_event::aggregation_close);
+    BOOST_CHECK(recorder.at(5).result==status::code::fail);
+    BOOST_CHECK(recorder.dump().find("... 1 records overwritten\n")==0);
+
+    recorder.set_sample_rate(0);
+    BOOST_CHECK(apply_sampled(v,m1,recorder));
+    BOOST_CHECK_EQUAL(recorder.total(),7);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
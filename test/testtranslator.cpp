@@ -1,4 +1,8 @@
+#include <atomic>
+#include <locale>
 #include <string>
+#include <vector>
+#include <thread>
 #include <boost/test/unit_test.hpp>
 
 #include <hatn/validator/reporting/translator.hpp>
@@ -209,6 +213,120 @@ BOOST_AUTO_TEST_CASE(CheckTranslatorRepository)
     BOOST_CHECK(tr2.get()==def_translator.get());
 }
 
+BOOST_AUTO_TEST_CASE(CheckTranslatorRepositoryReload)
+{
+    auto translator1=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"one","one_1"}});
+    auto translator2=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"one","one_2"}});
+    std::map<std::string,std::shared_ptr<translator>> translators1{{"en",translator1},{"en_US",translator1}};
+    std::map<std::string,std::shared_ptr<translator>> translators2{{"en",translator2},{"en_US",translator2}};
+
+    translator_repository rep(translators1);
+    BOOST_CHECK(rep.find_translator("en_US.UTF-8").get()==translator1.get());
+    // cached resolution
+    BOOST_CHECK(rep.find_translator("en_US.UTF-8").get()==translator1.get());
+
+    rep.reload(translators2);
+    BOOST_CHECK(rep.find_translator("en_US.UTF-8").get()==translator2.get());
+    BOOST_CHECK(rep.find_translator("en_GB").get()==translator2.get());
+
+    // copy shares current translators
+    translator_repository rep_copy(rep);
+    BOOST_CHECK(rep_copy.find_translator("en").get()==translator2.get());
+    rep_copy.clear();
+    BOOST_CHECK(rep_copy.find_translator("en").get()!=translator2.get());
+    BOOST_CHECK(rep.find_translator("en").get()==translator2.get());
+
+    // reload while other threads look up translators
+    std::atomic<bool> stop{false};
+    std::atomic<size_t> unexpected{0};
+    std::vector<std::thread> threads;
+    for (size_t i=0;i<4;i++)
+    {
+        threads.emplace_back(
+            [&]()
+            {
+                while (!stop.load())
+                {
+                    auto tr=rep.find_translator("en_US.UTF-8");
+                    auto str=std::string((*tr)("one"));
+                    if (str!="one_1" && str!="one_2")
+                    {
+                        ++unexpected;
+                    }
+                }
+            }
+        );
+    }
+    for (size_t i=0;i<1000;i++)
+    {
+        rep.reload((i%2==0) ? translators1 : translators2);
+    }
+    stop.store(true);
+    for (auto&& t:threads)
+    {
+        t.join();
+    }
+    BOOST_CHECK_EQUAL(unexpected.load(),0);
+    BOOST_CHECK(rep.find_translator("en_US.UTF-8").get()==translator2.get());
+    rep.release_retired();
+    BOOST_CHECK(rep.find_translator("en").get()==translator2.get());
+
+    // neither retired list nor per-thread cache keep replaced translators after release
+    auto translator3=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"one","one_3"}});
+    std::weak_ptr<translator> weak3=translator3;
+    for (size_t i=0;i<10;i++)
+    {
+        rep.add_translator(translator3,{"de","de_DE"});
+    }
+    BOOST_CHECK(rep.find_translator("de_DE").get()==translator3.get());
+    translator3.reset();
+    BOOST_CHECK(!weak3.expired());
+    rep.reload(translators1);
+    BOOST_CHECK(!weak3.expired());
+    rep.release_retired();
+    BOOST_CHECK(weak3.expired());
+    BOOST_CHECK(rep.find_translator("de_DE").get()==rep.default_translator().get());
+}
+
+BOOST_AUTO_TEST_CASE(CheckTranslatorRepositoryGlobalLocale)
+{
+    auto tr_default=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"word","default word"}});
+    auto tr_c=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"word","c word"}});
+    auto tr_utf8=std::make_shared<mapped_translator>(std::map<std::string,std::string>{{"word","utf8 word"}});
+
+    translator_repository rep{tr_default};
+    rep.add_translator(tr_c,{"C"});
+
+    auto prev=std::locale::global(std::locale::classic());
+    BOOST_CHECK_EQUAL(translator_repository::global_locale_name(),"C");
+    BOOST_CHECK_EQUAL(rep.find_translator().get(),tr_c.get());
+    BOOST_CHECK_EQUAL(rep.find_translator().get(),tr_c.get());
+
+    // unnamed locale
+    std::locale::global(std::locale(std::locale::classic(),new std::numpunct<char>()));
+    BOOST_CHECK_EQUAL(translator_repository::global_locale_name(),"*");
+    BOOST_CHECK_EQUAL(rep.find_translator().get(),tr_default.get());
+
+    try
+    {
+        std::locale utf8_locale{"C.UTF-8"};
+        rep.add_translator(tr_utf8,{utf8_locale.name()});
+        std::locale::global(utf8_locale);
+        BOOST_CHECK_EQUAL(translator_repository::global_locale_name(),utf8_locale.name());
+        BOOST_CHECK_EQUAL(rep.find_translator().get(),tr_utf8.get());
+    }
+    catch (const std::runtime_error&)
+    {
+        BOOST_TEST_MESSAGE("C.UTF-8 locale is not available");
+    }
+
+    std::locale::global(std::locale::classic());
+    BOOST_CHECK_EQUAL(translator_repository::global_locale_name(),"C");
+    BOOST_CHECK_EQUAL(rep.find_translator().get(),tr_c.get());
+
+    std::locale::global(prev);
+}
+
 BOOST_AUTO_TEST_CASE(CheckConcretePhrase)
 {
     std::map<std::string,std::string> m=
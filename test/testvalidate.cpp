@@ -47,6 +47,21 @@ BOOST_AUTO_TEST_CASE(CheckValidateThrow)
         validate(50,v)
     );
 
+    // equal values
+    BOOST_CHECK_NO_THROW(
+        validate(100,v)
+    );
+    BOOST_CHECK_NO_THROW(
+        validate(100u,v)
+    );
+    BOOST_CHECK_NO_THROW(
+        validate(100.0,v)
+    );
+    BOOST_CHECK_THROW(
+        validate(101u,v),
+        validation_error
+    );
+
     try
     {
         validate(1000,v);
@@ -0,0 +1,233 @@
+#include <map>
+#include <algorithm>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validate_incremental.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestValidateIncremental)
+
+namespace {
+
+template <typename ObjectT, typename ValidatorT, typename ChangedPathsT>
+incremental_result check_same_as_full(const ObjectT& obj, const ValidatorT& v, const ChangedPathsT& changed, const incremental_result& previous)
+{
+    auto result=validate_incremental(obj,v,changed,previous);
+    BOOST_CHECK_EQUAL(static_cast<bool>(result),v.apply(obj));
+
+    auto full=validate_incremental(obj,v);
+    BOOST_REQUIRE_EQUAL(result.node_statuses().size(),full.node_statuses().size());
+    for (size_t i=0;i<full.node_statuses().size();i++)
+    {
+        BOOST_TEST_CONTEXT("node " << i)
+        {
+            BOOST_CHECK_EQUAL(result.node_evaluated()[i],full.node_evaluated()[i]);
+            if (full.node_evaluated()[i])
+            {
+                BOOST_CHECK(result.node_statuses()[i].value()==full.node_statuses()[i].value());
+            }
+        }
+    }
+    return result;
+}
+
+}
+
+BOOST_AUTO_TEST_CASE(CheckDependencyIndex)
+{
+    auto v=validator(
+                _["field1"](gte,10),
+                _["field2"](gt,_["field3"]) ^OR^ _["field4"](lt,5),
+                NOT(_["field5"](eq,1))
+            );
+    auto index=make_dependency_index(v);
+    BOOST_REQUIRE_EQUAL(index.size(),7);
+
+    auto a1=index.affected(hana::make_tuple(_["field1"]));
+    BOOST_CHECK_EQUAL(std::count(a1.begin(),a1.end(),true),1);
+    BOOST_CHECK(a1[1]);
+
+    auto a3=index.affected(hana::make_tuple(_["field3"]));
+    BOOST_CHECK_EQUAL(std::count(a3.begin(),a3.end(),true),1);
+    BOOST_CHECK(a3[3]);
+
+    auto a5=index.affected(hana::make_tuple(_["field5"],_["field4"]));
+    BOOST_CHECK_EQUAL(std::count(a5.begin(),a5.end(),true),2);
+    BOOST_CHECK(a5[4]);
+    BOOST_CHECK(a5[6]);
+
+    auto a6=index.affected(hana::make_tuple(_["field6"]));
+    BOOST_CHECK_EQUAL(std::count(a6.begin(),a6.end(),true),0);
+
+    auto v2=validator(
+                _["field1"](gte,10),
+                size(gte,1)
+            );
+    auto index2=make_dependency_index(v2);
+    auto a7=index2.affected(hana::make_tuple(_["field6"]));
+    BOOST_CHECK(!a7[1]);
+    BOOST_CHECK(a7[2]);
+}
+
+BOOST_AUTO_TEST_CASE(CheckNestedPaths)
+{
+    std::map<std::string,std::map<std::string,int>> m1{
+        {"level1",{{"field1",10},{"field2",20}}},
+        {"level2",{{"field1",30},{"field2",40}}}
+    };
+
+    auto v=validator(
+                _["level1"]["field1"](gte,5),
+                _["level2"][ALL](lt,_["level1"]["field2"])
+            );
+    auto index=make_dependency_index(v);
+    BOOST_REQUIRE_EQUAL(index.size(),3);
+
+    auto a1=index.affected(hana::make_tuple(_["level1"]));
+    BOOST_CHECK(a1[1]);
+    BOOST_CHECK(a1[2]);
+
+    auto a2=index.affected(hana::make_tuple(_["level2"]["field1"]));
+    BOOST_CHECK(!a2[1]);
+    BOOST_CHECK(a2[2]);
+
+    auto a3=index.affected(hana::make_tuple(_["level1"]["field2"]));
+    BOOST_CHECK(!a3[1]);
+    BOOST_CHECK(a3[2]);
+
+    auto r=validate_incremental(m1,v);
+    BOOST_CHECK(!r);
+
+    m1["level1"]["field2"]=50;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["level1"]["field2"]),r);
+    BOOST_CHECK(r);
+
+    m1["level2"]["field2"]=60;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["level2"]["field2"]),r);
+    BOOST_CHECK(!r);
+}
+
+BOOST_AUTO_TEST_CASE(CheckIncremental)
+{
+    std::map<std::string,int> m1{
+        {"field1",1},{"field2",2},{"field3",3},{"field4",4},{"field5",5}
+    };
+
+    auto v=validator(
+                _["field1"](gte,10),
+                _["field2"](gt,_["field3"]) ^OR^ _["field4"](lt,5),
+                NOT(_["field5"](eq,1))
+            );
+
+    auto r=validate_incremental(m1,v);
+    BOOST_CHECK_EQUAL(static_cast<bool>(r),v.apply(m1));
+    BOOST_CHECK(!r);
+    BOOST_REQUIRE_EQUAL(r.node_statuses().size(),7);
+
+    m1["field1"]=20;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field1"]),r);
+    BOOST_CHECK(r);
+
+    m1["field4"]=10;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field4"]),r);
+    BOOST_CHECK(!r);
+
+    m1["field3"]=0;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field3"]),r);
+    BOOST_CHECK(r);
+
+    m1["field5"]=1;
+    m1["field2"]=-1;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field5"],_["field2"]),r);
+    BOOST_CHECK(!r);
+
+    m1["field5"]=2;
+    m1["field4"]=0;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field5"],_["field4"]),r);
+    BOOST_CHECK(r);
+
+    // empty previous result leads to full validation
+    m1["field1"]=0;
+    r=validate_incremental(m1,v,hana::make_tuple(),incremental_result());
+    BOOST_CHECK(!r);
+}
+
+BOOST_AUTO_TEST_CASE(CheckCachedStatuses)
+{
+    std::map<std::string,int> m1{
+        {"field1",10},{"field2",2}
+    };
+
+    auto v=validator(
+                _["field1"](gte,10),
+                _["field2"](gte,10)
+            );
+    auto index=make_dependency_index(v);
+
+    auto r=validate_incremental(m1,v);
+    BOOST_CHECK(!r);
+
+    // not listed members are not re-validated and their cached statuses are used
+    m1["field1"]=20;
+    m1["field2"]=20;
+    r=validate_incremental(m1,v,index,hana::make_tuple(_["field1"]),r);
+    BOOST_CHECK(!r);
+    BOOST_CHECK(r.node_statuses()[1].value()==status::code::success);
+    BOOST_CHECK(r.node_statuses()[2].value()==status::code::fail);
+
+    r=validate_incremental(m1,v,index,hana::make_tuple(_["field2"]),r);
+    BOOST_CHECK(r);
+
+    // lazy operands are always re-validated
+    int limit=10;
+    auto get_limit=[&limit](){return limit;};
+    auto v2=validator(
+                _["field1"](gte,lazy(get_limit)),
+                _["field2"](gte,5)
+            );
+    r=validate_incremental(m1,v2);
+    BOOST_CHECK(r);
+    limit=30;
+    r=validate_incremental(m1,v2,hana::make_tuple(_["field2"]),r);
+    BOOST_CHECK(!r);
+}
+
+BOOST_AUTO_TEST_CASE(CheckExistsGuard)
+{
+    std::map<std::string,int> m1{
+        {"field2",1}
+    };
+
+    auto v=validator(
+                _["field1"](exists,true) ^AND^ _["field1"](gte,10),
+                _["field2"](exists,false) ^OR^ _["field2"](gte,1)
+            );
+    BOOST_CHECK(!v.apply(m1));
+
+    // guarded validators are short-circuited and not evaluated
+    auto r=validate_incremental(m1,v);
+    BOOST_CHECK(!r);
+    BOOST_REQUIRE_EQUAL(r.node_statuses().size(),7);
+    BOOST_CHECK(r.node_evaluated()[2]);
+    BOOST_CHECK(!r.node_evaluated()[3]);
+
+    // skipped validator is evaluated when the guard passes
+    m1["field1"]=5;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field1"]),r);
+    BOOST_CHECK(!r);
+    BOOST_CHECK(r.node_evaluated()[3]);
+
+    m1["field1"]=20;
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field1"]),r);
+    BOOST_CHECK(r);
+
+    m1.erase("field1");
+    r=check_same_as_full(m1,v,hana::make_tuple(_["field1"]),r);
+    BOOST_CHECK(!r);
+    BOOST_CHECK(!r.node_evaluated()[3]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
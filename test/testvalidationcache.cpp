@@ -0,0 +1,247 @@
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/validation_cache.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestValidationCache)
+
+namespace {
+
+using map_type=std::map<std::string,int>;
+
+struct map_hash
+{
+    size_t operator() (const map_type& m) const
+    {
+        size_t h=0;
+        for (auto&& it:m)
+        {
+            h=h*31+std::hash<std::string>()(it.first);
+            h=h*31+std::hash<int>()(it.second);
+        }
+        return h;
+    }
+};
+
+struct collision_hash
+{
+    size_t operator() (const map_type&) const
+    {
+        return 1;
+    }
+};
+
+}
+
+BOOST_AUTO_TEST_CASE(CheckApply)
+{
+    auto v=validator(
+                _["field1"](gte,10),
+                _["field2"](lt,100)
+            );
+    validation_cache<map_type,map_hash> cache(8);
+    BOOST_CHECK_EQUAL(cache.capacity(),8);
+
+    map_type m1{{"field1",20},{"field2",50}};
+    map_type m2{{"field1",5},{"field2",50}};
+
+    BOOST_CHECK(cache.apply(v,1,m1));
+    BOOST_CHECK_EQUAL(cache.misses(),1);
+    BOOST_CHECK_EQUAL(cache.hits(),0);
+    BOOST_CHECK(cache.apply(v,1,m1));
+    BOOST_CHECK_EQUAL(cache.hits(),1);
+
+    BOOST_CHECK(!cache.apply(v,1,m2));
+    BOOST_CHECK(!cache.apply(v,1,m2));
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+    BOOST_CHECK_EQUAL(cache.misses(),2);
+    BOOST_CHECK_EQUAL(cache.size(),2);
+
+    // other validator is cached separately
+    auto v2=validator(
+                _["field1"](lt,10)
+            );
+    BOOST_CHECK(!cache.apply(v2,2,m1));
+    BOOST_CHECK(cache.apply(v2,2,m2));
+    BOOST_CHECK_EQUAL(cache.misses(),4);
+    BOOST_CHECK_EQUAL(cache.size(),4);
+
+    error err;
+    cache.validate(m2,v,1,err);
+    BOOST_CHECK(err);
+    cache.validate(m1,v,1,err);
+    BOOST_CHECK(!err);
+    BOOST_CHECK_EQUAL(cache.hits(),4);
+
+    cache.clear();
+    BOOST_CHECK_EQUAL(cache.size(),0);
+}
+
+BOOST_AUTO_TEST_CASE(CheckReport)
+{
+    auto v=validator(
+                _["field1"](gte,10)
+            );
+    validation_cache<map_type,map_hash> cache;
+
+    map_type m1{{"field1",5}};
+
+    // status without report is cached
+    BOOST_CHECK(!cache.apply(v,1,m1));
+
+    // report is missing in cache so object is validated once more
+    error_report err;
+    cache.validate(m1,v,1,err);
+    BOOST_CHECK(err);
+    BOOST_CHECK_EQUAL(err.message(),std::string("field1 must be greater than or equal to 10"));
+    BOOST_CHECK_EQUAL(cache.misses(),2);
+    BOOST_CHECK_EQUAL(cache.size(),1);
+
+    error_report err1;
+    cache.validate(m1,v,1,err1);
+    BOOST_CHECK(err1);
+    BOOST_CHECK_EQUAL(err1.message(),std::string("field1 must be greater than or equal to 10"));
+    BOOST_CHECK_EQUAL(cache.hits(),1);
+
+    BOOST_CHECK_THROW(cache.validate(m1,v,1),validation_error);
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+
+    map_type m2{{"field1",50}};
+    BOOST_CHECK(cache.apply(v,1,m2));
+    error_report err2;
+    cache.validate(m2,v,1,err2);
+    BOOST_CHECK(!err2);
+    BOOST_CHECK(err2.message().empty());
+    BOOST_CHECK_EQUAL(cache.hits(),3);
+}
+
+BOOST_AUTO_TEST_CASE(CheckEviction)
+{
+    auto v=validator(
+                _["field1"](gte,10)
+            );
+    validation_cache<map_type,map_hash> cache(2);
+
+    map_type m1{{"field1",1}};
+    map_type m2{{"field1",20}};
+    map_type m3{{"field1",30}};
+
+    cache.apply(v,1,m1);
+    cache.apply(v,1,m2);
+    // m1 becomes the most recently used
+    cache.apply(v,1,m1);
+    BOOST_CHECK_EQUAL(cache.hits(),1);
+    // m2 is evicted
+    cache.apply(v,1,m3);
+    BOOST_CHECK_EQUAL(cache.size(),2);
+    cache.apply(v,1,m1);
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+    cache.apply(v,1,m2);
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+    BOOST_CHECK_EQUAL(cache.misses(),4);
+    BOOST_CHECK_EQUAL(cache.size(),2);
+
+    validation_cache<map_type,map_hash> no_cache(0);
+    BOOST_CHECK(!no_cache.apply(v,1,m1));
+    BOOST_CHECK(!no_cache.apply(v,1,m1));
+    BOOST_CHECK_EQUAL(no_cache.size(),0);
+    BOOST_CHECK_EQUAL(no_cache.hits(),0);
+}
+
+BOOST_AUTO_TEST_CASE(CheckCollisions)
+{
+    auto v=validator(
+                _["field1"](gte,10)
+            );
+    validation_cache<map_type,collision_hash> cache(2);
+
+    map_type m1{{"field1",1}};
+    map_type m2{{"field1",20}};
+    map_type m3{{"field1",30}};
+
+    BOOST_CHECK(!cache.apply(v,1,m1));
+    BOOST_CHECK(cache.apply(v,1,m2));
+    BOOST_CHECK(!cache.apply(v,1,m1));
+    BOOST_CHECK(cache.apply(v,1,m2));
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+    BOOST_CHECK(cache.apply(v,1,m3));
+    BOOST_CHECK_EQUAL(cache.size(),2);
+    BOOST_CHECK(!cache.apply(v,1,m1));
+    BOOST_CHECK_EQUAL(cache.misses(),4);
+}
+
+BOOST_AUTO_TEST_CASE(CheckValidatorIdentity)
+{
+    validation_cache<map_type,map_hash> cache;
+
+    map_type m1{{"field1",20}};
+
+    // validators of the same type with different operands are cached separately by their ids
+    auto v1=validator(_["field1"](gte,10));
+    auto v2=validator(_["field1"](gte,30));
+    static_assert(std::is_same<decltype(v1),decltype(v2)>::value,"");
+    BOOST_CHECK(cache.apply(v1,1,m1));
+    BOOST_CHECK(!cache.apply(v2,2,m1));
+    BOOST_CHECK(cache.apply(v1,1,m1));
+    BOOST_CHECK(!cache.apply(v2,2,m1));
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+
+    // validator constructed at the address of destroyed one does not get results of destroyed validator
+    std::vector<decltype(v1)> storage;
+    storage.push_back(validator(_["field1"](gte,10)));
+    auto address=&storage.front();
+    BOOST_CHECK(cache.apply(storage.front(),3,m1));
+    storage.clear();
+    storage.push_back(validator(_["field1"](gte,50)));
+    BOOST_CHECK_EQUAL(address,&storage.front());
+    BOOST_CHECK(!cache.apply(storage.front(),4,m1));
+    BOOST_CHECK_EQUAL(cache.hits(),2);
+}
+
+BOOST_AUTO_TEST_CASE(CheckThreads)
+{
+    auto v=validator(
+                _["field1"](gte,10)
+            );
+    validation_cache<map_type,map_hash> cache(16);
+
+    std::vector<std::thread> threads;
+    std::vector<size_t> failed(4,0);
+    for (size_t i=0;i<failed.size();i++)
+    {
+        threads.emplace_back(
+            [&cache,&v,&failed,i]()
+            {
+                for (int j=0;j<1000;j++)
+                {
+                    map_type m{{"field1",j%32}};
+                    error_report err;
+                    cache.validate(m,v,1,err);
+                    if (static_cast<bool>(err)!=(j%32<10))
+                    {
+                        failed[i]++;
+                    }
+                }
+            }
+        );
+    }
+    for (auto&& thread:threads)
+    {
+        thread.join();
+    }
+    for (auto&& count:failed)
+    {
+        BOOST_CHECK_EQUAL(count,0);
+    }
+    BOOST_CHECK_EQUAL(cache.hits()+cache.misses(),4000);
+    BOOST_CHECK(cache.size()<=16);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
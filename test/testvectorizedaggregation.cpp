@@ -0,0 +1,179 @@
+#include <array>
+#include <vector>
+#include <map>
+#include <list>
+
+#include <boost/test/unit_test.hpp>
+
+#include <hatn/validator/validator.hpp>
+#include <hatn/validator/adapters/reporting_adapter.hpp>
+#include <hatn/validator/filter_path.hpp>
+
+using namespace HATN_VALIDATOR_NAMESPACE;
+
+BOOST_AUTO_TEST_SUITE(TestVectorizedAggregation)
+
+BOOST_AUTO_TEST_CASE(CheckKernelSelection)
+{
+    auto v1=value(gte,0);
+    static_assert(detail::vectorized_element_validator<decltype(v1)>::supported::value,"");
+
+    auto v2=value(in,interval(1,10));
+    static_assert(detail::vectorized_element_validator<decltype(v2)>::supported::value,"");
+
+    auto v3=size(gte,1);
+    static_assert(!detail::vectorized_element_validator<decltype(v3)>::supported::value,"");
+
+    auto v4=value(gte,_["field"]);
+    static_assert(!detail::vectorized_element_validator<decltype(v4)>::supported::value,"");
+
+    static_assert(detail::is_contiguous_numbers<std::vector<int>>::value,"");
+    static_assert(detail::is_contiguous_numbers<std::array<double,3>>::value,"");
+    static_assert(!detail::is_contiguous_numbers<std::vector<bool>>::value,"");
+    static_assert(!detail::is_contiguous_numbers<std::list<int>>::value,"");
+    static_assert(!detail::is_contiguous_numbers<std::vector<std::string>>::value,"");
+
+    BOOST_CHECK(true);
+}
+
+BOOST_AUTO_TEST_CASE(CheckKernels)
+{
+    std::vector<int> data(1000,5);
+    auto gte0=[](int v){return v>=0;};
+    auto lt0=[](int v){return v<0;};
+
+    BOOST_CHECK(detail::vectorized_all_of(data.data(),data.size(),gte0));
+    BOOST_CHECK(!detail::vectorized_any_of(data.data(),data.size(),lt0));
+    BOOST_CHECK(detail::vectorized_all_of(data.data(),0,lt0));
+    BOOST_CHECK(!detail::vectorized_any_of(data.data(),0,gte0));
+
+    // failed element in a full block
+    data[100]=-1;
+    BOOST_CHECK(!detail::vectorized_all_of(data.data(),data.size(),gte0));
+    BOOST_CHECK(detail::vectorized_any_of(data.data(),data.size(),lt0));
+    data[100]=5;
+
+    // failed element in the tail
+    data[999]=-1;
+    BOOST_CHECK(!detail::vectorized_all_of(data.data(),data.size(),gte0));
+    BOOST_CHECK(detail::vectorized_any_of(data.data(),data.size(),lt0));
+}
+
+BOOST_AUTO_TEST_CASE(CheckAllMember)
+{
+    auto v=validator(
+                _["samples"](ALL(value(gte,0)))
+            );
+
+    std::map<std::string,std::vector<int>> m1{{"samples",std::vector<int>(200,1)}};
+    BOOST_CHECK(v.apply(m1));
+
+    std::map<std::string,std::vector<int>> m2{{"samples",std::vector<int>{}}};
+    BOOST_CHECK(v.apply(m2));
+
+    std::map<std::string,std::vector<int>> m3{{"samples",std::vector<int>(200,1)}};
+    m3["samples"][150]=-1;
+    BOOST_CHECK(!v.apply(m3));
+
+    std::string rep;
+    auto ra=make_reporting_adapter(m3,rep);
+    BOOST_CHECK(!v.apply(ra));
+    BOOST_CHECK_EQUAL(rep,std::string("each element of samples must be greater than or equal to 0"));
+
+    rep.clear();
+    auto ra1=make_reporting_adapter(m1,rep);
+    BOOST_CHECK(v.apply(ra1));
+    BOOST_CHECK(rep.empty());
+}
+
+BOOST_AUTO_TEST_CASE(CheckAnyMember)
+{
+    auto v=validator(
+                _["samples"](ANY(value(lt,0)))
+            );
+
+    std::map<std::string,std::vector<double>> m1{{"samples",std::vector<double>(300,1.0)}};
+    BOOST_CHECK(!v.apply(m1));
+    m1["samples"][299]=-0.5;
+    BOOST_CHECK(v.apply(m1));
+
+    std::map<std::string,std::vector<double>> m2{{"samples",std::vector<double>{}}};
+    BOOST_CHECK(v.apply(m2));
+
+    std::string rep;
+    std::map<std::string,std::vector<double>> m3{{"samples",std::vector<double>(10,1.0)}};
+    auto ra=make_reporting_adapter(m3,rep);
+    BOOST_CHECK(!v.apply(ra));
+    BOOST_CHECK_EQUAL(rep,std::string("at least one element of samples must be less than 0"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckInterval)
+{
+    auto v1=validator(
+                ALL(value(in,interval(1.0f,10.0f)))
+            );
+    std::vector<float> vec1(100,5.0f);
+    BOOST_CHECK(v1.apply(vec1));
+    vec1[10]=1.0f;
+    BOOST_CHECK(v1.apply(vec1));
+    vec1[10]=10.5f;
+    BOOST_CHECK(!v1.apply(vec1));
+
+    auto v2=validator(
+                ALL(value(in,interval(1.0f,10.0f,interval.open())))
+            );
+    vec1[10]=1.0f;
+    BOOST_CHECK(!v2.apply(vec1));
+    vec1[10]=9.0f;
+    BOOST_CHECK(v2.apply(vec1));
+
+    auto v3=validator(
+                ALL(value(nin,interval(1,10)))
+            );
+    std::vector<int> vec3{0,11,12,-5};
+    BOOST_CHECK(v3.apply(vec3));
+    vec3.push_back(1);
+    BOOST_CHECK(!v3.apply(vec3));
+
+    std::string rep;
+    auto ra=make_reporting_adapter(vec3,rep);
+    BOOST_CHECK(!v3.apply(ra));
+    BOOST_CHECK_EQUAL(rep,std::string("each element must be not in interval [1,10]"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckNot)
+{
+    auto v=validator(
+                _["samples"](NOT(ALL(value(gte,0))))
+            );
+    std::map<std::string,std::vector<int>> m1{{"samples",std::vector<int>(10,1)}};
+    BOOST_CHECK(!v.apply(m1));
+
+    std::string rep;
+    auto ra=make_reporting_adapter(m1,rep);
+    BOOST_CHECK(!v.apply(ra));
+    BOOST_CHECK_EQUAL(rep,std::string("NOT each element of samples must be greater than or equal to 0"));
+}
+
+BOOST_AUTO_TEST_CASE(CheckNotVectorized)
+{
+    // elements are not numbers
+    auto v1=validator(
+                _["samples"](ALL(value(gte,"a")))
+            );
+    std::map<std::string,std::vector<std::string>> m1{{"samples",{"b","c"}}};
+    BOOST_CHECK(v1.apply(m1));
+    m1["samples"].push_back("0");
+    BOOST_CHECK(!v1.apply(m1));
+
+    // container is not contiguous
+    auto v2=validator(
+                _["samples"](ALL(value(gte,0)))
+            );
+    std::map<std::string,std::list<int>> m2{{"samples",{1,2,3}}};
+    BOOST_CHECK(v2.apply(m2));
+    m2["samples"].push_back(-1);
+    BOOST_CHECK(!v2.apply(m2));
+}
+
+BOOST_AUTO_TEST_SUITE_END()